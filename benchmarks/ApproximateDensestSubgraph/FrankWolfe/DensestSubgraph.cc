@@ -0,0 +1,59 @@
+// Usage:
+// numactl -i all ./DensestSubgraph -s -eps 0.001 com-orkut.ungraph.txt_SJ
+// flags:
+//   required:
+//     -s : indicates that the graph is symmetric
+//   optional:
+//     -m : indicate that the graph should be mmap'd
+//     -c : indicate that the graph is compressed
+//     -rounds : the number of times to run the algorithm
+//     -eps : stop once the upper bound is within a factor of 1 + eps of the
+//            density of the best subgraph found
+//     -iters : the maximum number of Frank-Wolfe iterations
+//     -interval : the number of iterations between two densest-prefix
+//                 computations
+//     -exact : certify the result with max-flow computations
+
+#include "DensestSubgraph.h"
+
+namespace gbbs {
+namespace {
+
+template <class Graph>
+double DensestSubgraph_runner(Graph& G, commandLine P) {
+  densest_subgraph::Options options;
+  options.epsilon = P.getOptionDoubleValue("-eps", 0.001);
+  options.max_iterations = P.getOptionLongValue("-iters", 1000);
+  options.peel_interval = P.getOptionLongValue("-interval", 5);
+  options.exact = P.getOption("-exact");
+  std::cout << "### Application: DensestSubgraph" << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -eps = " << options.epsilon
+            << " -iters = " << options.max_iterations
+            << " -interval = " << options.peel_interval
+            << " -exact = " << options.exact << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+  assert(P.getOption("-s"));
+
+  timer t;
+  t.start();
+  auto result = FrankWolfeDensestSubgraph(G, options);
+  double tt = t.stop();
+  std::cout << "### Densest subgraph: " << result.vertices.size()
+            << " vertices, " << result.num_edges << " edges" << std::endl;
+  std::cout << "### Density: " << result.density
+            << " upper bound: " << result.upper_bound
+            << " exact: " << result.exact << std::endl;
+  std::cout << "### Iterations: " << result.iterations << std::endl;
+
+  std::cout << "### Running Time: " << tt << std::endl;
+  return tt;
+}
+
+}  // namespace
+}  // namespace gbbs
+
+generate_symmetric_main(gbbs::DensestSubgraph_runner, false);
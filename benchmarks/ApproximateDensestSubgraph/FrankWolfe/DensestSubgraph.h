@@ -0,0 +1,408 @@
+// Densest subgraph by Frank-Wolfe load balancing, in the style of Danisch,
+// Chan and Sozio ("Large scale density-friendly graph decomposition via
+// convex programming").
+//
+// Every edge {u, v} splits one unit of load between its endpoints, and the
+// load b(v) of a vertex is the sum of its shares. The maximum load of any
+// split is an upper bound on the maximum density |E(S)| / |S| (the dual), and
+// Frank-Wolfe minimizes sum_v b(v)^2, whose minimizer has the maximum density
+// as its maximum load. An iteration moves every edge towards its endpoint of
+// smaller load, with the step size of an exact line search. The step moves
+// every share by the same fraction towards its target, so it moves every load
+// by that fraction towards the sum of its targets: the loads are updated
+// directly, and the shares themselves are never stored.
+//
+// Every `peel_interval` iterations the vertices are sorted by decreasing
+// load, and the densest prefix of that order is a lower bound (the primal).
+// The iterations stop when the upper bound is at most (1 + epsilon) times the
+// density of the best prefix, or when the two are closer than any two
+// distinct densities of subgraphs with at most n vertices, in which case the
+// prefix is a densest subgraph.
+//
+// With `exact` set, the result is then certified with Goldberg's max-flow
+// construction. A densest subgraph S* has minimum degree at least its density
+// (removing a vertex of smaller degree would make it denser), so it lies in
+// the ceil(p / q)-core, where p / q is the density of the best set found. The
+// flow network is built on that core only, and a min cut that separates any
+// vertex from the sink is a strictly denser set, which replaces the best set
+// before the check is repeated. The level graphs of Dinic's algorithm are
+// built with a parallel BFS; the augmenting paths are found sequentially.
+// The certificate is an optional check on a network restricted to the core,
+// which is usually much smaller than G after the Frank-Wolfe iterations have
+// converged, so the blocking flows are deliberately left sequential rather
+// than replaced by a parallel push-relabel.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "gbbs/gbbs.h"
+
+namespace gbbs {
+namespace densest_subgraph {
+
+struct Options {
+  // The iterations stop once upper_bound <= (1 + epsilon) * density.
+  double epsilon = 0.001;
+  size_t max_iterations = 1000;
+  // The number of Frank-Wolfe iterations between two computations of the
+  // densest prefix, which sorts the vertices.
+  size_t peel_interval = 5;
+  // Whether to certify the result with max-flow computations.
+  bool exact = false;
+};
+
+struct Result {
+  // The vertices of the subgraph, sorted.
+  sequence<uintE> vertices;
+  // The number of edges of the subgraph.
+  size_t num_edges = 0;
+  // num_edges / vertices.size().
+  double density = 0;
+  // An upper bound on the maximum density of the graph. It equals density if
+  // exact is set.
+  double upper_bound = 0;
+  size_t iterations = 0;
+  // Whether the subgraph is known to be a densest subgraph.
+  bool exact = false;
+};
+
+// A residual network on the vertices [0, source), which are local ids of the
+// candidate vertices, plus a source and a sink. Every undirected edge {i, j}
+// is a pair of arcs that are each other's reverse.
+struct FlowNetwork {
+  size_t source;
+  size_t sink;
+  // The arcs of node u are [offsets[u], offsets[u + 1]).
+  sequence<size_t> offsets;
+  sequence<uintE> heads;
+  sequence<size_t> reverses;
+  sequence<int64_t> capacities;
+
+  size_t num_nodes() const { return offsets.size() - 1; }
+};
+
+// Returns the sorted vertices of the k-core of G.
+template <class Graph>
+sequence<uintE> CoreVertices(Graph& G, size_t k) {
+  using W = typename Graph::weight_type;
+  const size_t n = G.n;
+  auto degrees = sequence<uintE>::from_function(
+      n, [&](size_t v) { return G.get_vertex(v).out_degree(); });
+  auto removed = sequence<bool>::from_function(
+      n, [&](size_t v) { return degrees[v] < k; });
+  auto frontier = parlay::pack_index<uintE>(removed);
+  while (frontier.size() > 0) {
+    // A vertex joins the next frontier when its degree drops below k, which
+    // is observed by exactly one decrement.
+    auto next = parlay::flatten(parlay::map(frontier, [&](uintE v) {
+      sequence<uintE> out;
+      auto map_f = [&](const uintE& src, const uintE& u, const W& wgh) {
+        if (!removed[u] && gbbs::fetch_and_add(&degrees[u], -1) == k) {
+          out.push_back(u);
+        }
+      };
+      G.get_vertex(v).out_neighbors().map(map_f, /*parallel=*/false);
+      return out;
+    }));
+    parallel_for(0, next.size(), [&](size_t i) { removed[next[i]] = true; });
+    frontier = std::move(next);
+  }
+  return parlay::pack_index<uintE>(
+      parlay::delayed_seq<bool>(n, [&](size_t v) { return !removed[v]; }));
+}
+
+// Returns the number of edges of G with both endpoints in the sorted set S.
+template <class Graph>
+size_t InducedEdges(Graph& G, const sequence<uintE>& S) {
+  using W = typename Graph::weight_type;
+  auto in_set = sequence<bool>(G.n, false);
+  parallel_for(0, S.size(), [&](size_t i) { in_set[S[i]] = true; });
+  auto degrees = parlay::delayed_seq<size_t>(S.size(), [&](size_t i) {
+    auto count_f = [&](const uintE& src, const uintE& u, const W& wgh) {
+      return in_set[u];
+    };
+    return G.get_vertex(S[i]).out_neighbors().count(count_f);
+  });
+  return parlay::reduce(degrees) / 2;
+}
+
+// Builds Goldberg's network for the question "is there a set S of candidates
+// with q |E(S)| > p |S|?". The source has an arc of capacity q deg_C(i) to
+// every candidate i, every candidate has an arc of capacity 2p to the sink,
+// and every edge between candidates has capacity q in both directions. The
+// cut whose source side is {source} + S has capacity
+// 2q |E(C)| + 2 (p |S| - q |E(S)|), so the minimum cut separates a nonempty
+// S from the sink exactly when such a set exists. candidates is sorted.
+template <class Graph>
+FlowNetwork MakeFlowNetwork(Graph& G, const sequence<uintE>& candidates,
+                            size_t p, size_t q) {
+  using W = typename Graph::weight_type;
+  const size_t c = candidates.size();
+  auto local = sequence<uintE>(G.n, UINT_E_MAX);
+  parallel_for(0, c, [&](size_t i) { local[candidates[i]] = i; });
+  auto degrees = sequence<size_t>::from_function(c, [&](size_t i) {
+    auto count_f = [&](const uintE& src, const uintE& u, const W& wgh) {
+      return local[u] != UINT_E_MAX;
+    };
+    return G.get_vertex(candidates[i]).out_neighbors().count(count_f);
+  });
+
+  FlowNetwork N;
+  N.source = c;
+  N.sink = c + 1;
+  // The arcs of candidate i are its neighbors (sorted, as the local ids are
+  // increasing in the vertex ids), then the sink, then the source.
+  N.offsets = sequence<size_t>::from_function(c + 3, [&](size_t u) {
+    return (u < c) ? degrees[u] + 2 : (u < c + 2) ? c : 0;
+  });
+  size_t num_arcs = parlay::scan_inplace(make_slice(N.offsets));
+  N.heads = sequence<uintE>::uninitialized(num_arcs);
+  N.reverses = sequence<size_t>::uninitialized(num_arcs);
+  N.capacities = sequence<int64_t>::uninitialized(num_arcs);
+  const int64_t edge_capacity = q;
+  parallel_for(0, c, 1, [&](size_t i) {
+    size_t a = N.offsets[i];
+    auto map_f = [&](const uintE& src, const uintE& u, const W& wgh) {
+      if (local[u] != UINT_E_MAX) {
+        N.heads[a] = local[u];
+        N.capacities[a] = edge_capacity;
+        a++;
+      }
+    };
+    G.get_vertex(candidates[i]).out_neighbors().map(map_f, false);
+    size_t to_sink = a, from_source = a + 1;
+    size_t sink_arc = N.offsets[N.sink] + i;
+    size_t source_arc = N.offsets[N.source] + i;
+    N.heads[to_sink] = N.sink;
+    N.capacities[to_sink] = 2 * static_cast<int64_t>(p);
+    N.reverses[to_sink] = sink_arc;
+    N.heads[sink_arc] = i;
+    N.capacities[sink_arc] = 0;
+    N.reverses[sink_arc] = to_sink;
+    N.heads[from_source] = N.source;
+    N.capacities[from_source] = 0;
+    N.reverses[from_source] = source_arc;
+    N.heads[source_arc] = i;
+    N.capacities[source_arc] = edge_capacity * degrees[i];
+    N.reverses[source_arc] = from_source;
+  });
+  parallel_for(0, c, 1, [&](size_t i) {
+    for (size_t a = N.offsets[i]; a < N.offsets[i] + degrees[i]; a++) {
+      uintE j = N.heads[a];
+      auto begin = N.heads.begin() + N.offsets[j];
+      N.reverses[a] =
+          std::lower_bound(begin, begin + degrees[j], i) - N.heads.begin();
+    }
+  });
+  return N;
+}
+
+// Returns the BFS levels of the nodes from the source in the residual
+// network, UINT_E_MAX for the unreachable ones.
+inline sequence<uintE> ResidualLevels(const FlowNetwork& N) {
+  auto levels = sequence<uintE>(N.num_nodes(), UINT_E_MAX);
+  levels[N.source] = 0;
+  auto frontier = sequence<uintE>(1, N.source);
+  for (uintE d = 1; frontier.size() > 0; d++) {
+    frontier = parlay::flatten(parlay::map(frontier, [&](uintE u) {
+      sequence<uintE> out;
+      for (size_t a = N.offsets[u]; a < N.offsets[u + 1]; a++) {
+        uintE v = N.heads[a];
+        if (N.capacities[a] > 0 && levels[v] == UINT_E_MAX &&
+            gbbs::atomic_compare_and_swap(&levels[v], UINT_E_MAX, d)) {
+          out.push_back(v);
+        }
+      }
+      return out;
+    }));
+  }
+  return levels;
+}
+
+// Computes a maximum flow with Dinic's algorithm, and returns the local ids
+// of the candidates on the source side of the minimum cut.
+inline sequence<uintE> MinCutSourceSide(FlowNetwork& N) {
+  const uintE source = N.source, sink = N.sink;
+  while (true) {
+    auto levels = ResidualLevels(N);
+    if (levels[sink] == UINT_E_MAX) {
+      return parlay::pack_index<uintE>(parlay::delayed_seq<bool>(
+          N.source, [&](size_t i) { return levels[i] != UINT_E_MAX; }));
+    }
+    // Augments along shortest paths until the level graph has none left. next
+    // holds the first arc of every node that may still lead to the sink.
+    auto next = sequence<size_t>(N.offsets.begin(), N.offsets.end() - 1);
+    std::vector<size_t> path;
+    uintE u = source;
+    while (true) {
+      if (u == sink) {
+        int64_t flow = N.capacities[path[0]];
+        for (size_t a : path) flow = std::min(flow, N.capacities[a]);
+        size_t saturated = path.size();
+        for (size_t k = 0; k < path.size(); k++) {
+          N.capacities[path[k]] -= flow;
+          N.capacities[N.reverses[path[k]]] += flow;
+          if (N.capacities[path[k]] == 0 && saturated == path.size()) {
+            saturated = k;
+          }
+        }
+        // Restarts from the tail of the first saturated arc.
+        path.resize(saturated);
+        u = path.empty() ? source : N.heads[path.back()];
+        continue;
+      }
+      bool advanced = false;
+      for (; next[u] < N.offsets[u + 1]; next[u]++) {
+        size_t a = next[u];
+        if (N.capacities[a] > 0 && levels[N.heads[a]] == levels[u] + 1) {
+          path.push_back(a);
+          u = N.heads[a];
+          advanced = true;
+          break;
+        }
+      }
+      if (!advanced) {
+        if (u == source) break;
+        // u is a dead end: retreats and skips the arc into u.
+        path.pop_back();
+        u = path.empty() ? source : N.heads[path.back()];
+        next[u]++;
+      }
+    }
+  }
+}
+
+}  // namespace densest_subgraph
+
+// Returns a subgraph of the symmetric graph G whose density is within a
+// factor of 1 + options.epsilon of the maximum (or a densest subgraph if
+// options.exact is set), with a certified upper bound on the maximum density.
+template <class Graph>
+densest_subgraph::Result FrankWolfeDensestSubgraph(
+    Graph& G, const densest_subgraph::Options& options = {}) {
+  using W = typename Graph::weight_type;
+  using densest_subgraph::Result;
+  const size_t n = G.n;
+  Result result;
+  if (n == 0) {
+    result.exact = true;
+    return result;
+  }
+  timer t;
+  t.start();
+
+  // Every edge starts split evenly between its endpoints.
+  auto loads = sequence<double>::from_function(
+      n, [&](size_t v) { return 0.5 * G.get_vertex(v).out_degree(); });
+  auto target_loads = sequence<double>::uninitialized(n);
+  // The share of the edge {v, u} that the linear minimization gives to v.
+  auto target_share = [&](uintE v, uintE u) {
+    return (loads[v] < loads[u]) ? 1.0 : (loads[v] > loads[u]) ? 0.0 : 0.5;
+  };
+
+  // Sets result to the densest prefix of the vertices by decreasing load, if
+  // it is denser.
+  auto pos = sequence<uintE>::uninitialized(n);
+  auto prefix_edges = sequence<size_t>::uninitialized(n);
+  auto peel = [&]() {
+    auto order = sequence<uintE>::from_function(n, [](size_t v) { return v; });
+    parlay::sort_inplace(make_slice(order), [&](uintE u, uintE v) {
+      return loads[u] > loads[v] || (loads[u] == loads[v] && u < v);
+    });
+    parallel_for(0, n, [&](size_t i) { pos[order[i]] = i; });
+    parallel_for(0, n, 1, [&](size_t v) {
+      auto count_f = [&](const uintE& src, const uintE& u, const W& wgh) {
+        return pos[u] < pos[v];
+      };
+      prefix_edges[pos[v]] = G.get_vertex(v).out_neighbors().count(count_f);
+    });
+    // prefix_edges[k] becomes the number of edges among the first k + 1
+    // vertices.
+    parlay::scan_inclusive_inplace(make_slice(prefix_edges));
+    auto densities = sequence<double>::from_function(n, [&](size_t k) {
+      return static_cast<double>(prefix_edges[k]) / (k + 1);
+    });
+    size_t k = parlay::max_element(densities) - densities.begin();
+    if (result.vertices.size() == 0 || densities[k] > result.density) {
+      result.vertices = sequence<uintE>(order.begin(), order.begin() + k + 1);
+      parlay::sort_inplace(make_slice(result.vertices));
+      result.num_edges = prefix_edges[k];
+      result.density = densities[k];
+    }
+  };
+
+  result.upper_bound = parlay::reduce_max(loads);
+  // The density of any subgraph that is denser than the result exceeds it by
+  // at least this much.
+  auto resolution = [&]() { return 1.0 / (n * result.vertices.size()); };
+  const size_t peel_interval = std::max<size_t>(options.peel_interval, 1);
+  bool converged = false;
+  size_t& iteration = result.iterations;
+  for (; iteration < options.max_iterations; iteration++) {
+    if (iteration % peel_interval == 0 || converged) {
+      peel();
+      if (result.upper_bound <= (1 + options.epsilon) * result.density ||
+          result.upper_bound - result.density < 0.5 * resolution()) {
+        break;
+      }
+      if (converged) break;
+    }
+
+    parallel_for(0, n, 1, [&](size_t v) {
+      double load = 0;
+      auto map_f = [&](const uintE& src, const uintE& u, const W& wgh) {
+        load += target_share(v, u);
+      };
+      G.get_vertex(v).out_neighbors().map(map_f, false);
+      target_loads[v] = load;
+    });
+    // The exact line search minimizes sum_v (b(v) + gamma d(v))^2 for the
+    // direction d = target_loads - loads.
+    double numerator = parlay::reduce(parlay::delayed_seq<double>(
+        n, [&](size_t v) { return loads[v] * (loads[v] - target_loads[v]); }));
+    double denominator =
+        parlay::reduce(parlay::delayed_seq<double>(n, [&](size_t v) {
+          double d = target_loads[v] - loads[v];
+          return d * d;
+        }));
+    if (denominator == 0 || numerator <= 0) {
+      // The loads are optimal: their maximum is the maximum density.
+      converged = true;
+      continue;
+    }
+    double gamma = std::min(1.0, numerator / denominator);
+    parallel_for(0, n, [&](size_t v) {
+      loads[v] += gamma * (target_loads[v] - loads[v]);
+    });
+    result.upper_bound =
+        std::min(result.upper_bound, parlay::reduce_max(loads));
+  }
+  if (iteration == options.max_iterations) peel();
+  result.upper_bound = std::max(result.upper_bound, result.density);
+  result.exact = result.upper_bound - result.density < 0.5 * resolution();
+  gbbs_debug(t.next("frank-wolfe time"););
+
+  if (options.exact && !result.exact) {
+    while (true) {
+      size_t p = result.num_edges, q = result.vertices.size();
+      auto candidates = densest_subgraph::CoreVertices(G, (p + q - 1) / q);
+      if (candidates.size() == 0) break;
+      auto N = densest_subgraph::MakeFlowNetwork(G, candidates, p, q);
+      auto S = densest_subgraph::MinCutSourceSide(N);
+      if (S.size() == 0) break;
+      result.vertices = parlay::map(S, [&](uintE i) { return candidates[i]; });
+      result.num_edges = densest_subgraph::InducedEdges(G, result.vertices);
+      result.density =
+          static_cast<double>(result.num_edges) / result.vertices.size();
+    }
+    result.upper_bound = result.density;
+    result.exact = true;
+    gbbs_debug(t.next("max-flow time"););
+  }
+  return result;
+}
+
+}  // namespace gbbs
@@ -0,0 +1,126 @@
+#include "benchmarks/ApproximateDensestSubgraph/FrankWolfe/DensestSubgraph.h"
+
+#include <algorithm>
+#include <set>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "gbbs/graph.h"
+#include "gbbs/helpers/undirected_edge.h"
+#include "gbbs/macros.h"
+#include "gbbs/unit_tests/graph_test_utils.h"
+#include "gtest/gtest.h"
+
+namespace gbbs {
+
+namespace {
+
+using Adjacency = std::vector<std::set<uintE>>;
+
+size_t InducedEdges(const Adjacency& adj, const std::vector<uintE>& S) {
+  size_t count = 0;
+  for (size_t i = 0; i < S.size(); i++) {
+    for (size_t j = i + 1; j < S.size(); j++) count += adj[S[i]].count(S[j]);
+  }
+  return count;
+}
+
+// Returns the maximum density of a small graph, as (edges, vertices), by
+// checking every vertex subset.
+std::pair<size_t, size_t> BruteForceMaxDensity(const Adjacency& adj) {
+  const size_t n = adj.size();
+  std::pair<size_t, size_t> best = {0, 1};
+  for (size_t mask = 1; mask < (size_t{1} << n); mask++) {
+    std::vector<uintE> S;
+    for (uintE v = 0; v < n; v++) {
+      if (mask >> v & 1) S.push_back(v);
+    }
+    size_t edges = InducedEdges(adj, S);
+    if (edges * best.second > best.first * S.size()) best = {edges, S.size()};
+  }
+  return best;
+}
+
+// Checks that the result describes its vertex set, and that the maximum
+// density (edges / vertices) is within the bounds of the result.
+void CheckResult(const densest_subgraph::Result& result, const Adjacency& adj,
+                 size_t edges, size_t vertices) {
+  std::vector<uintE> S(result.vertices.begin(), result.vertices.end());
+  ASSERT_FALSE(S.empty());
+  EXPECT_TRUE(std::is_sorted(S.begin(), S.end()));
+  EXPECT_EQ(result.num_edges, InducedEdges(adj, S));
+  EXPECT_DOUBLE_EQ(result.density,
+                   static_cast<double>(result.num_edges) / S.size());
+  double max_density = static_cast<double>(edges) / vertices;
+  EXPECT_LE(result.density, max_density + 1e-9);
+  EXPECT_GE(result.upper_bound, max_density - 1e-9);
+  if (result.exact) {
+    EXPECT_EQ(result.num_edges * vertices, edges * S.size());
+  }
+}
+
+}  // namespace
+
+TEST(FrankWolfeDensestSubgraph, MatchesBruteForce) {
+  // Pseudo-random graphs on 13 vertices with edge densities of about 1/4,
+  // 1/2 and 3/4.
+  constexpr uintE n = 13;
+  for (double p : {0.25, 0.5, 0.75}) {
+    auto graph = graph_test::MakeRandomSymmetricGraph(n, p, /*seed=*/49);
+    auto adj = graph_test::RandomAdjacencySets(n, p, /*seed=*/49);
+    auto [max_edges, max_vertices] = BruteForceMaxDensity(adj);
+
+    densest_subgraph::Options options;
+    options.epsilon = 0.1;
+    auto approximate = FrankWolfeDensestSubgraph(graph, options);
+    CheckResult(approximate, adj, max_edges, max_vertices);
+    EXPECT_LE(approximate.upper_bound, 1.1 * approximate.density + 1e-9);
+
+    options.exact = true;
+    options.peel_interval = 1;
+    auto exact = FrankWolfeDensestSubgraph(graph, options);
+    EXPECT_TRUE(exact.exact);
+    CheckResult(exact, adj, max_edges, max_vertices);
+    EXPECT_DOUBLE_EQ(exact.upper_bound, exact.density);
+  }
+}
+
+TEST(FrankWolfeDensestSubgraph, CertifiesAfterFewIterations) {
+  // A 5-clique on {0, ..., 4} with a path 4 - 5 - ... - 11 attached, whose
+  // densest subgraph is the clique. The max-flow check finishes the search
+  // after a single Frank-Wolfe iteration.
+  constexpr uintE n = 12;
+  std::unordered_set<UndirectedEdge> edges;
+  auto add_edge = [&](uintE u, uintE v) { edges.insert({u, v}); };
+  for (uintE u = 0; u < 5; u++) {
+    for (uintE v = u + 1; v < 5; v++) add_edge(u, v);
+  }
+  for (uintE v = 5; v < n; v++) add_edge(v - 1, v);
+  auto adj = graph_test::MakeAdjacencySets(n, edges);
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(n, edges);
+
+  densest_subgraph::Options options;
+  options.max_iterations = 1;
+  options.exact = true;
+  auto result = FrankWolfeDensestSubgraph(graph, options);
+  EXPECT_TRUE(result.exact);
+  CheckResult(result, adj, 10, 5);
+  EXPECT_EQ(std::vector<uintE>(result.vertices.begin(), result.vertices.end()),
+            (std::vector<uintE>{0, 1, 2, 3, 4}));
+}
+
+TEST(FrankWolfeDensestSubgraph, GraphWithoutEdges) {
+  const std::unordered_set<UndirectedEdge> edges;
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(3, edges);
+  densest_subgraph::Options options;
+  options.exact = true;
+  auto result = FrankWolfeDensestSubgraph(graph, options);
+  EXPECT_TRUE(result.exact);
+  EXPECT_EQ(result.vertices.size(), 1);
+  EXPECT_EQ(result.num_edges, 0);
+  EXPECT_EQ(result.density, 0);
+  EXPECT_EQ(result.upper_bound, 0);
+}
+
+}  // namespace gbbs
@@ -0,0 +1,52 @@
+// Usage:
+// numactl -i all ./LazyGreedySetCover -rounds 1 -s -c clueweb_sym.bytepda
+// flags:
+//   optional:
+//     -s : indicate that the graph is symmetric
+//     -m : indicate that the graph should be mmap'd
+//     -c : indicate that the graph is compressed
+//     -coverage : stop once this fraction of the elements is covered (1 by
+//      default)
+//     -eps : the approximation parameter epsilon (0.01 by default)
+//     -weighted : use random set costs in [1, 10) instead of unit costs
+
+#include "LazyGreedySetCover.h"
+
+namespace gbbs {
+
+template <class Graph>
+double LazyGreedySetCover_runner(Graph& G, commandLine P) {
+  double coverage = P.getOptionDoubleValue("-coverage", 1.0);
+  double epsilon = P.getOptionDoubleValue("-eps", 0.01);
+  bool weighted = P.getOptionValue("-weighted");
+
+  std::cout << "### Application: Lazy-Greedy Approximate Set Cover"
+            << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -coverage = " << coverage << " -eps = " << epsilon
+            << " -weighted = " << weighted << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+
+  sequence<double> costs;
+  if (weighted) {
+    auto r = parlay::random();
+    costs = sequence<double>::from_function(G.n, [&](size_t i) {
+      return 1.0 + (r.ith_rand(i) % 9000) / 1000.0;
+    });
+  }
+
+  timer t;
+  t.start();
+  auto cover = LazyGreedySetCover(G, costs, coverage, epsilon);
+  double tt = t.stop();
+
+  std::cout << "### Running Time: " << tt << std::endl;
+  return tt;
+}
+
+}  // namespace gbbs
+
+generate_symmetric_main(gbbs::LazyGreedySetCover_runner, false);
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <math.h>
+
+#include "gbbs/gbbs.h"
+
+namespace gbbs {
+
+namespace lazy_sc {
+
+constexpr uintE COVERED = ((uintE)INT_E_MAX) - 1;
+
+}  // namespace lazy_sc
+
+// Weighted, optionally partial, approximate set cover with a bucket-free
+// lazy-greedy version of the MaNIS algorithm in MANISBPT11. Vertices are both
+// sets and elements: set v covers the neighbors of v and costs costs[v] > 0
+// (every set costs 1 if costs is empty).
+//
+// The cost-effectiveness of a set is the number of uncovered elements it
+// covers per unit of cost. Instead of bucketing the sets by (log-scaled)
+// degree, every set caches an upper bound on its cost-effectiveness, and the
+// sets are kept in an array sorted by these bounds (a priority array).
+// Cost-effectiveness only decreases as elements get covered, so the cached
+// bounds stay valid. Every step works at a threshold tau that is a power of
+// (1 + epsilon), and only re-evaluates the stale sets whose bound is at least
+// tau, i.e., a prefix of the array. The sets that are still at least tau
+// cost-effective run one MaNIS round: sets pick random priorities, every
+// uncovered element goes to its highest-priority set, and a set joins the
+// cover if the elements it won still make it tau / (1 + epsilon)
+// cost-effective. The re-evaluated sets are then merged back into the array.
+// Once no set reaches tau, tau drops directly to the largest cached bound, so
+// there are no empty buckets to skip.
+//
+// The algorithm stops once a `coverage` fraction of the coverable elements
+// (vertices with at least one neighbor) is covered, or once no set covers an
+// uncovered element. The graph is not modified.
+template <class Graph>
+inline sequence<uintE> LazyGreedySetCover(Graph& G,
+                                          const sequence<double>& costs = {},
+                                          double coverage = 1.0,
+                                          double epsilon = 0.01) {
+  using W = typename Graph::weight_type;
+  timer it;
+  it.start();
+  const size_t n = G.n;
+  assert(costs.empty() || costs.size() == n);
+  auto cost = [&](uintE v) { return costs.empty() ? 1.0 : costs[v]; };
+  auto elms = sequence<uintE>(n, UINT_E_MAX);
+
+  auto num_uncovered = [&](uintE v) -> size_t {
+    auto pred = [&](const uintE& u, const uintE& ngh, const W& wgh) {
+      return elms[ngh] != lazy_sc::COVERED;
+    };
+    return G.get_vertex(v).out_neighbors().count(pred);
+  };
+  // The cached upper bounds on the cost-effectiveness of the sets.
+  auto bound = sequence<double>::from_function(
+      n, [&](size_t v) { return G.get_vertex(v).out_degree() / cost(v); });
+  auto by_bound = [&](uintE a, uintE b) {
+    return bound[a] > bound[b] || (bound[a] == bound[b] && a < b);
+  };
+  auto pending = parlay::filter(
+      parlay::delayed_seq<uintE>(n, [](size_t i) { return i; }),
+      [&](uintE v) { return bound[v] > 0; });
+  parlay::sort_inplace(make_slice(pending), by_bound);
+
+  size_t coverable = parlay::count_if(
+      parlay::delayed_seq<uintE>(n, [](size_t i) { return i; }),
+      [&](uintE v) { return G.get_vertex(v).out_degree() > 0; });
+  size_t target = ceil(std::min(coverage, 1.0) * coverable);
+  size_t covered = 0;
+
+  // Rounds tau down to a power of (1 + epsilon).
+  auto round_down = [&](double ratio) {
+    return pow(1.0 + epsilon, floor(log(ratio) / log(1.0 + epsilon)));
+  };
+
+  auto perm = sequence<uintE>::uninitialized(n);
+  auto in_cover = sequence<bool>(n, false);
+  parlay::sequence<uintE> cover;
+  auto r = parlay::random();
+  size_t steps = 0, evaluations = 0;
+  double tau = (pending.size() > 0) ? round_down(bound[pending[0]]) : 0;
+  gbbs_debug(it.next("initialization time"););
+
+  while (covered < target && pending.size() > 0) {
+    // Re-evaluate the prefix of stale sets whose bound reaches tau.
+    size_t prefix = std::lower_bound(pending.begin(), pending.end(), tau,
+                                     [&](uintE v, double t) {
+                                       return bound[v] >= t;
+                                     }) -
+                    pending.begin();
+    auto stale = sequence<uintE>(pending.begin(), pending.begin() + prefix);
+    parallel_for(0, stale.size(), 1, [&](size_t i) {
+      uintE v = stale[i];
+      bound[v] = num_uncovered(v) / cost(v);
+    });
+    evaluations += stale.size();
+    auto active =
+        parlay::filter(stale, [&](uintE v) { return bound[v] >= tau; });
+
+    if (active.size() > 0) {
+      // One MaNIS round on the sets that are at least tau cost-effective.
+      auto P = parlay::random_permutation<uintE>(active.size(), r);
+      parallel_for(0, active.size(), kDefaultGranularity,
+                   [&](size_t i) { perm[active[i]] = P[i]; });
+      parallel_for(0, active.size(), 1, [&](size_t i) {
+        uintE v = active[i];
+        auto visit_f = [&](const uintE& u, const uintE& ngh, const W& wgh) {
+          if (elms[ngh] != lazy_sc::COVERED) {
+            gbbs::write_min(&elms[ngh], perm[u]);
+          }
+        };
+        G.get_vertex(v).out_neighbors().map(visit_f);
+      });
+      auto won = sequence<size_t>::from_function(active.size(), [&](size_t i) {
+        uintE v = active[i];
+        auto won_f = [&](const uintE& u, const uintE& ngh, const W& wgh) {
+          return elms[ngh] == perm[u];
+        };
+        size_t num_won = G.get_vertex(v).out_neighbors().count(won_f);
+        if (num_won >= tau * cost(v) / (1.0 + epsilon)) {
+          in_cover[v] = true;
+        }
+        return num_won;
+      });
+      parallel_for(0, active.size(), 1, [&](size_t i) {
+        uintE v = active[i];
+        auto reset_f = [&](const uintE& u, const uintE& ngh, const W& wgh) {
+          if (elms[ngh] == perm[u]) {
+            elms[ngh] = in_cover[u] ? lazy_sc::COVERED : UINT_E_MAX;
+          }
+        };
+        G.get_vertex(v).out_neighbors().map(reset_f);
+      });
+      auto joined =
+          parlay::filter(active, [&](uintE v) { return in_cover[v]; });
+      covered += parlay::reduce(parlay::delayed_seq<size_t>(
+          active.size(),
+          [&](size_t i) { return in_cover[active[i]] ? won[i] : 0; }));
+      cover.append(joined);
+      r = r.next();
+    }
+
+    // Merge the re-evaluated sets that can still cover elements back into
+    // the priority array.
+    auto remaining = parlay::filter(
+        stale, [&](uintE v) { return !in_cover[v] && bound[v] > 0; });
+    parlay::sort_inplace(make_slice(remaining), by_bound);
+    auto rest = pending.cut(prefix, pending.size());
+    pending = parlay::merge(remaining, rest, by_bound);
+
+    if (active.size() == 0 && pending.size() > 0) {
+      // No set reaches tau; continue at the largest cached bound.
+      tau = std::min(tau / (1.0 + epsilon), round_down(bound[pending[0]]));
+    }
+    gbbs_debug(std::cout << "step = " << steps << " tau = " << tau
+                         << " stale = " << stale.size()
+                         << " active = " << active.size()
+                         << " covered = " << covered << "\n";);
+    steps++;
+  }
+
+  auto cover_cost = parlay::reduce(
+      parlay::delayed_seq<double>(cover.size(), [&](size_t i) {
+        return cost(cover[i]);
+      }));
+  std::cout << "|V| = " << G.n << " |E| = " << G.m << "\n";
+  std::cout << "|cover|: " << cover.size() << " cost: " << cover_cost << "\n";
+  std::cout << "Steps: " << steps << " evaluations: " << evaluations << "\n";
+  std::cout << "Num_uncovered = " << (coverable - covered) << "\n";
+  return cover;
+}
+
+}  // namespace gbbs
@@ -0,0 +1,86 @@
+#include "benchmarks/ApproximateSetCover/LazyGreedy/LazyGreedySetCover.h"
+
+#include <unordered_set>
+#include <vector>
+
+#include "gbbs/graph.h"
+#include "gbbs/macros.h"
+#include "gbbs/unit_tests/graph_test_utils.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using ::testing::Contains;
+using ::testing::ElementsAre;
+using ::testing::Not;
+
+namespace gbbs {
+
+namespace {
+
+// Returns the number of coverable elements (vertices with a neighbor) that
+// have no neighbor in the cover.
+template <class Graph>
+size_t NumUncovered(Graph& G, const sequence<uintE>& cover) {
+  std::vector<bool> in_cover(G.n, false);
+  for (uintE v : cover) in_cover[v] = true;
+  size_t uncovered = 0;
+  for (uintE v = 0; v < G.n; v++) {
+    if (G.get_vertex(v).out_degree() == 0) continue;
+    bool covered = false;
+    auto map_f = [&](const uintE& u, const uintE& ngh, const auto& wgh) {
+      covered = covered || in_cover[ngh];
+    };
+    G.get_vertex(v).out_neighbors().map(map_f, /*parallel=*/false);
+    uncovered += !covered;
+  }
+  return uncovered;
+}
+
+// A star with center 0 and leaves 1, ..., num_leaves.
+auto Star(uintE num_leaves) {
+  std::unordered_set<UndirectedEdge> edges;
+  for (uintE i = 1; i <= num_leaves; i++) edges.insert({0, i});
+  return graph_test::MakeUnweightedSymmetricGraph(num_leaves + 1, edges);
+}
+
+}  // namespace
+
+TEST(LazyGreedySetCover, Star) {
+  auto graph = Star(5);
+  auto cover = LazyGreedySetCover(graph);
+  EXPECT_EQ(NumUncovered(graph, cover), size_t{0});
+  // The center covers the leaves, and any leaf covers the center.
+  EXPECT_EQ(cover.size(), size_t{2});
+  EXPECT_THAT(cover, Contains(0));
+}
+
+TEST(LazyGreedySetCover, PrefersCheapSets) {
+  // Sets 0 and 4 both cover elements 1, 2 and 3; sets 1, 2 and 3 cover
+  // elements 0 and 4.
+  const std::unordered_set<UndirectedEdge> kEdges{
+      {0, 1}, {0, 2}, {0, 3}, {4, 1}, {4, 2}, {4, 3},
+  };
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(5, kEdges);
+  const sequence<double> costs{10, 1, 1, 1, 1};
+  auto cover = LazyGreedySetCover(graph, costs);
+  EXPECT_EQ(NumUncovered(graph, cover), size_t{0});
+  EXPECT_EQ(cover.size(), size_t{2});
+  EXPECT_THAT(cover, Contains(4));
+  EXPECT_THAT(cover, Not(Contains(0)));
+}
+
+TEST(LazyGreedySetCover, PartialCover) {
+  auto graph = Star(10);
+  // Half of the 11 elements are covered by the center alone.
+  auto cover = LazyGreedySetCover(graph, /*costs=*/{}, /*coverage=*/0.5);
+  EXPECT_THAT(cover, ElementsAre(0));
+  EXPECT_EQ(NumUncovered(graph, cover), size_t{1});
+}
+
+TEST(LazyGreedySetCover, EdgelessGraph) {
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(
+      3, std::unordered_set<UndirectedEdge>{});
+  EXPECT_EQ(LazyGreedySetCover(graph).size(), size_t{0});
+}
+
+}  // namespace gbbs
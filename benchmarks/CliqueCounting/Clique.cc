@@ -37,6 +37,8 @@
 #include <math.h>
 #include <fstream>
 
+#include "gbbs/sampling_estimator.h"
+
 namespace gbbs {
 
 long strToDirectType(std::string order_str) {
@@ -81,8 +83,11 @@ double AppKCore_runner(Graph& GA, commandLine P) {
 
   bool sparsify = P.getOptionValue(
       "--sparse");  // if set, use colorful sparsification for approx counting
-  long sparsify_denom = P.getOptionLongValue(
-      "--colors", 0);  // number of colors for colorful sparsification
+  // The sampling options (--colors, --edenom, -samples, -relerr, ...) are
+  // described in gbbs/sampling_estimator.h.
+  auto options = sampling::ParseSamplingOptions(P);
+  bool sampled = P.getOptionLongValue("--colors", 0) != 0 ||
+                 P.getOptionLongValue("--edenom", 0) != 0;
 
   bool approx_peel = P.getOptionValue(
       "--approxpeel");  // if set, use approximate vertex peeling
@@ -123,15 +128,16 @@ double AppKCore_runner(Graph& GA, commandLine P) {
   t.start();
 
   size_t count = 0;
-  if (sparsify) {
-    // Sparsify graph, with random seed
-    clr_sparsify_graph(GA, sparsify_denom, 7398234);
-
-    // k-clique counting
-    count = Clique(GA, k, order, epsilon, space, label, filter, use_base,
-                   recursive_level, approx_peel, approx_eps);
-    std::cout << "sparse count: " << count << std::endl;
-    count = count * pow(sparsify_denom, k - 1);
+  if (sparsify && sampled) {
+    // Estimate the count from k-clique counts of sparsified graphs.
+    auto count_f = [&](auto& H) {
+      return Clique(H, k, order, epsilon, space, label, filter, use_base,
+                    recursive_level, approx_peel, approx_eps);
+    };
+    auto est = sampling::EstimateCount(GA, sampling::CliquePattern(k), count_f,
+                                       options);
+    sampling::PrintEstimate(est, options.confidence);
+    count = llround(est.estimate);
   } else {
     // k-clique counting
     count = Clique(GA, k, order, epsilon, space, label, filter, use_base,
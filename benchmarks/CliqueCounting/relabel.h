@@ -213,21 +213,4 @@ inline symmetric_graph<symmetric_vertex, W> relabel_graph(
                                               out_edges);
 }
 
-template <class Graph>
-void clr_sparsify_graph(Graph& GA, size_t denom, long seed) {
-  using W = typename Graph::weight_type;
-  size_t n = GA.n;
-  // Color vertices with denom colors
-  uintE numColors = std::max((size_t)1, denom);
-  sequence<uintE> colors = sequence<uintE>::from_function(n, [&](size_t i) {
-    return parlay::hash64_2((uintE)seed + i) % numColors;
-  });
-  auto pack_predicate = [&](const uintE& u, const uintE& v, const W& wgh) {
-    if (colors[u] == colors[v]) return 0;
-    return 1;
-  };
-  // Mutates in-place.
-  filter_edges(GA, pack_predicate);
-}
-
 }  // namespace gbbs
@@ -26,12 +26,17 @@
 // flags:
 //   optional:
 //     -eps : the epsilon to use for convergence (1e-6 by default)
+//     -em : use edgeMap for the matrix-vector products
+//     -blocked : use propagation blocking for the matrix-vector products
+//     -topk : print the k vertices most similar to -u, computed for all
+//      vertices at once by the single-source engine
 //     -rounds : the number of times to run the algorithm
 //     -c : indicate that the graph is compressed
 //     -m : indicate that the graph should be mmap'd
 //     -s : indicate that the graph is symmetric
 
 #include "CoSimRank.h"
+#include "CoSimRank_single_source.h"
 
 namespace gbbs {
 template <class Graph>
@@ -52,10 +57,20 @@ double CoSimRank_runner(Graph& G, commandLine P) {
   double c = P.getOptionDoubleValue("-cons", 0.85);
   uintE u = P.getOptionLongValue("-u", 0);
   uintE v = P.getOptionLongValue("-v", 1);
-  if (P.getOptionValue("-em"))
+  if (P.getOptionValue("-topk")) {
+    size_t k = P.getOptionLongValue("-topk", 10);
+    auto engine = cosimrank::make_single_source_engine(G, c, eps, iters);
+    auto top = engine.TopK(u, k);
+    for (const auto& [w, sim] : top) {
+      std::cout << w << " " << sim << std::endl;
+    }
+  } else if (P.getOptionValue("-em")) {
     CoSimRank_edgeMap(G, u, v, eps, c, iters);
-  else
+  } else if (P.getOptionValue("-blocked")) {
+    CoSimRank_blocked(G, u, v, eps, c, iters);
+  } else {
     CoSimRank(G, u, v, eps, c, iters);
+  }
   double tt = t.stop();
 
   std::cout << "### Running Time: " << tt << std::endl;
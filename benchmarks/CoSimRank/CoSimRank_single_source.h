@@ -0,0 +1,240 @@
+// This file provides an engine that computes the CoSimRank similarity of one
+// query vertex u to every vertex of the graph in a single pass, instead of
+// running the pairwise computation in CoSimRank.h once per candidate.
+//
+// With the transition matrix M (M[w][v] = 1 / out_degree(v) for every edge
+// (v, w)) and p_k^v = M^k e_v, the CoSimRank of u and v as computed by
+// CoSimRank_edgeMap is
+//
+//   sim(u, v) = sum_{k >= 0} c^k <p_k^u, p_k^v> = sum_{k >= 0} c^k
+//               ((M^T)^k p_k^u)[v],
+//
+// so the similarity to all vertices is s = sum_k c^k (M^T)^k x_k with
+// x_k = p_k^u. The engine computes the iterates x_0, ..., x_K of u with K
+// products by M, keeps them, and evaluates s with K products by M^T using
+// Horner's rule:
+//
+//   y_K = x_K,   y_k = x_k + c M^T y_{k+1},   s = y_0.
+//
+// All vectors are sparse (vertex ids and values), and every product is an
+// edgeMap over the support of its input, so while the iterates are local the
+// work is proportional to the edges incident to their support, and edgeMap
+// switches to dense traversals once they are not. The engine keeps all K + 1
+// iterates, i.e., it uses memory proportional to the sum of their supports.
+//
+// Since every iterate has L1 norm at most one, truncating the series after K
+// terms changes every similarity by at most c^(K + 1) / (1 - c); the engine
+// stops at the first K for which this is below eps, once the iterate of u
+// vanishes (all of its mass reached vertices without out-edges), or after
+// max_iters products.
+//
+// Products by M^T traverse in-edges, so directed graphs must have their
+// in-edges materialized.
+
+#pragma once
+
+#include <math.h>
+#include <utility>
+
+#include "gbbs/gbbs.h"
+
+namespace gbbs {
+namespace cosimrank {
+
+// A sparse vector with distinct vertex ids.
+struct SparseVector {
+  sequence<uintE> ids;
+  sequence<double> values;
+
+  size_t size() const { return ids.size(); }
+};
+
+// Adds scale * in_values[s] / out_degree(s) to acc[d] for every edge (s, d),
+// where s is in the frontier. If transpose is set, the edges are in-edges of
+// the frontier and the weight is 1 / out_degree(d) instead. Returns true for
+// the first update of each untouched d.
+struct CoSimRank_F {
+  double* in_values;
+  double* acc;
+  bool* touched;
+  double* inv_degrees;
+  double scale;
+  bool transpose;
+
+  CoSimRank_F(double* in_values, double* acc, bool* touched,
+              double* inv_degrees, double scale, bool transpose)
+      : in_values(in_values),
+        acc(acc),
+        touched(touched),
+        inv_degrees(inv_degrees),
+        scale(scale),
+        transpose(transpose) {}
+
+  inline double contribution(const uintE& s, const uintE& d) const {
+    return scale * in_values[s] * inv_degrees[transpose ? d : s];
+  }
+
+  template <class W>
+  inline bool update(const uintE& s, const uintE& d, const W& w) {
+    acc[d] += contribution(s, d);
+    if (!touched[d]) {
+      touched[d] = true;
+      return true;
+    }
+    return false;
+  }
+
+  template <class W>
+  inline bool updateAtomic(const uintE& s, const uintE& d, const W& w) {
+    gbbs::write_add(&acc[d], contribution(s, d));
+    return !touched[d] &&
+           gbbs::atomic_compare_and_swap(&touched[d], false, true);
+  }
+
+  inline bool cond(const uintE& d) const { return true; }
+};
+
+template <class Graph>
+struct SingleSourceEngine {
+  Graph& G;
+  size_t n;
+  double c;
+  double eps;
+  size_t max_iters;
+  sequence<double> inv_degrees;
+  // Scratch space; all zero (false) between products.
+  sequence<double> in_values;
+  sequence<double> acc;
+  sequence<bool> touched;
+
+  // Statistics of the last query: the number of products by M, and the sum
+  // of the supports of the iterates.
+  size_t iterations;
+  size_t total_support;
+
+  SingleSourceEngine(Graph& G, double c, double eps, size_t max_iters)
+      : G(G),
+        n(G.n),
+        c(c),
+        eps(eps),
+        max_iters(max_iters),
+        in_values(G.n, 0.0),
+        acc(G.n, 0.0),
+        touched(G.n, false),
+        iterations(0),
+        total_support(0) {
+    inv_degrees = sequence<double>::from_function(n, [&](size_t i) {
+      uintE d = G.get_vertex(i).out_degree();
+      return (d == 0) ? 0.0 : 1.0 / static_cast<double>(d);
+    });
+  }
+
+  // Returns seed + scale * M x, or seed + scale * M^T x if transpose is set.
+  // seed may be null.
+  SparseVector multiply(const SparseVector& x, const SparseVector* seed,
+                        double scale, bool transpose) {
+    parallel_for(0, x.size(), kDefaultGranularity,
+                 [&](size_t i) { in_values[x.ids[i]] = x.values[i]; });
+    if (seed != nullptr) {
+      parallel_for(0, seed->size(), kDefaultGranularity, [&](size_t i) {
+        acc[seed->ids[i]] = seed->values[i];
+        touched[seed->ids[i]] = true;
+      });
+    }
+
+    auto F = CoSimRank_F(in_values.begin(), acc.begin(), touched.begin(),
+                         inv_degrees.begin(), scale, transpose);
+    flags fl = 0;
+    if (transpose) fl |= in_edges;
+    auto frontier = vertexSubset(n, sequence<uintE>(x.ids));
+    auto output = edgeMap(G, frontier, F, -1, fl);
+    output.toSparse();
+
+    SparseVector y;
+    if (seed != nullptr) {
+      y.ids = parlay::append(seed->ids, output.s);
+    } else {
+      y.ids = std::move(output.s);
+    }
+    y.values = sequence<double>::from_function(
+        y.size(), [&](size_t i) { return acc[y.ids[i]]; });
+
+    parallel_for(0, y.size(), kDefaultGranularity, [&](size_t i) {
+      acc[y.ids[i]] = 0.0;
+      touched[y.ids[i]] = false;
+    });
+    parallel_for(0, x.size(), kDefaultGranularity,
+                 [&](size_t i) { in_values[x.ids[i]] = 0.0; });
+    return y;
+  }
+
+  // Returns the CoSimRank of u and every vertex with a non-zero similarity to
+  // u (including u itself).
+  SparseVector SingleSource(uintE u) {
+    gbbs_debug(timer t; t.start(););
+    std::vector<SparseVector> iterates;
+    SparseVector x;
+    x.ids = sequence<uintE>(1, u);
+    x.values = sequence<double>(1, 1.0);
+    iterates.push_back(std::move(x));
+    total_support = 1;
+    // c^(k + 1) / (1 - c) bounds the sum of the terms after term k.
+    double tail = c / (1 - c);
+    while (iterates.size() <= max_iters && tail >= eps) {
+      auto next = multiply(iterates.back(), nullptr, 1.0, /*transpose=*/false);
+      if (next.size() == 0) break;
+      total_support += next.size();
+      iterates.push_back(std::move(next));
+      tail *= c;
+    }
+    iterations = iterates.size() - 1;
+    gbbs_debug(std::cout << "# iterations = " << iterations
+                         << " total support = " << total_support
+                         << std::endl;
+               t.next("forward iterations time"););
+
+    SparseVector y = std::move(iterates.back());
+    for (size_t k = iterations; k > 0; k--) {
+      y = multiply(y, &iterates[k - 1], c, /*transpose=*/true);
+    }
+    gbbs_debug(t.next("backward iterations time"););
+    return y;
+  }
+
+  // Returns the CoSimRank of u and every vertex as a dense vector.
+  sequence<double> Dense(uintE u) {
+    auto scores = SingleSource(u);
+    auto dense = sequence<double>(n, 0.0);
+    parallel_for(0, scores.size(), kDefaultGranularity,
+                 [&](size_t i) { dense[scores.ids[i]] = scores.values[i]; });
+    return dense;
+  }
+
+  // Returns the (at most) k vertices v != u with the highest non-zero
+  // CoSimRank to u, in decreasing order of similarity (ties are broken by
+  // vertex id).
+  sequence<std::pair<uintE, double>> TopK(uintE u, size_t k) {
+    auto scores = SingleSource(u);
+    auto candidates = parlay::delayed_seq<std::pair<uintE, double>>(
+        scores.size(), [&](size_t i) {
+          return std::make_pair(scores.ids[i], scores.values[i]);
+        });
+    auto top = parlay::filter(candidates, [&](const auto& p) {
+      return p.first != u && p.second > 0;
+    });
+    parlay::sort_inplace(make_slice(top), [](const auto& a, const auto& b) {
+      return a.second > b.second || (a.second == b.second && a.first < b.first);
+    });
+    if (top.size() > k) top.resize(k);
+    return top;
+  }
+};
+
+template <class Graph>
+inline SingleSourceEngine<Graph> make_single_source_engine(
+    Graph& G, double c = 0.85, double eps = 0.000001, size_t max_iters = 100) {
+  return SingleSourceEngine<Graph>(G, c, eps, max_iters);
+}
+
+}  // namespace cosimrank
+}  // namespace gbbs
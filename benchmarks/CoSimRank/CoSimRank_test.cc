@@ -0,0 +1,82 @@
+#include "benchmarks/CoSimRank/CoSimRank_single_source.h"
+
+#include <cmath>
+#include <unordered_set>
+
+#include "benchmarks/CoSimRank/CoSimRank.h"
+#include "gbbs/graph.h"
+#include "gbbs/helpers/undirected_edge.h"
+#include "gbbs/macros.h"
+#include "gbbs/unit_tests/graph_test_utils.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace gbbs {
+
+namespace {
+
+// Graph diagram:
+//     0 - 1 - 2     4 - 5
+//          \  |
+//           - 3
+auto TestGraph() {
+  constexpr uintE kNumVertices{6};
+  const std::unordered_set<UndirectedEdge> kEdges{
+      {0, 1}, {1, 2}, {2, 3}, {1, 3}, {4, 5},
+  };
+  return graph_test::MakeUnweightedSymmetricGraph(kNumVertices, kEdges);
+}
+
+}  // namespace
+
+TEST(CoSimRankSingleSource, MatchesPairwise) {
+  auto graph = TestGraph();
+  auto engine = cosimrank::make_single_source_engine(
+      graph, /*c=*/0.85, /*eps=*/0.0, /*max_iters=*/20);
+  auto scores = engine.Dense(1);
+  EXPECT_EQ(engine.iterations, size_t{20});
+  for (uintE v = 0; v < graph.n; v++) {
+    double expected =
+        CoSimRank_blocked(graph, 1, v, /*eps=*/0.0, /*c=*/0.85,
+                          /*max_iters=*/20);
+    EXPECT_NEAR(scores[v], expected, 1e-9) << "v = " << v;
+  }
+  EXPECT_EQ(scores[4], 0.0);
+  EXPECT_EQ(scores[5], 0.0);
+  // The engine state is reused across queries.
+  EXPECT_NEAR(engine.Dense(4)[5],
+              CoSimRank_blocked(graph, 4, 5, /*eps=*/0.0, /*c=*/0.85,
+                                /*max_iters=*/20),
+              1e-9);
+}
+
+TEST(CoSimRankSingleSource, TruncationError) {
+  auto graph = TestGraph();
+  constexpr double kEps = 1e-3;
+  auto exact = cosimrank::make_single_source_engine(
+      graph, /*c=*/0.85, /*eps=*/0.0, /*max_iters=*/200).Dense(0);
+  auto engine = cosimrank::make_single_source_engine(graph, /*c=*/0.85, kEps,
+                                                     /*max_iters=*/200);
+  auto scores = engine.Dense(0);
+  EXPECT_LT(engine.iterations, size_t{200});
+  for (uintE v = 0; v < graph.n; v++) {
+    EXPECT_NEAR(scores[v], exact[v], kEps);
+  }
+}
+
+TEST(CoSimRankSingleSource, TopK) {
+  auto graph = TestGraph();
+  auto engine = cosimrank::make_single_source_engine(graph);
+  auto scores = engine.Dense(2);
+  auto top = engine.TopK(2, 2);
+  ASSERT_EQ(top.size(), size_t{2});
+  EXPECT_GE(top[0].second, top[1].second);
+  for (const auto& [v, score] : top) {
+    EXPECT_NE(v, 2);
+    EXPECT_DOUBLE_EQ(score, scores[v]);
+  }
+  // Vertices 4 and 5 have zero similarity and are never returned.
+  EXPECT_EQ(engine.TopK(2, 10).size(), size_t{3});
+}
+
+}  // namespace gbbs
@@ -429,11 +429,24 @@ struct LDDSamplingTemplate {
   double beta;
   bool permute;
 
+  const LDDClustering* clustering = nullptr;
+
   LDDSamplingTemplate(G& GA, commandLine& P, double beta = 0.2,
                       bool permute = false)
       : GA(GA), beta(beta), permute(permute) {}
 
+  // Samples using a precomputed decomposition (e.g., from an LDDEngine shared
+  // with other stages) instead of running LDD again.
+  LDDSamplingTemplate(G& GA, const LDDClustering& clustering)
+      : GA(GA),
+        beta(clustering.beta),
+        permute(false),
+        clustering(&clustering) {}
+
   sequence<parent> initial_components() {
+    if (clustering != nullptr) {
+      return clustering->cluster_ids;
+    }
     timer lddt;
     lddt.start();
     auto clusters = LDD(GA, beta, permute);
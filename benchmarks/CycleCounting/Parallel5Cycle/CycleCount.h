@@ -0,0 +1,311 @@
+// Parallel 4-cycle and 5-cycle counting with a fixed amount of scratch memory
+// per worker.
+//
+// The counting follows Kowalik's algorithm, as in Count5Cycle. The vertices
+// are relabeled by decreasing degree, and every cycle is counted from its
+// smallest (highest-degree) vertex i. The wedge table U[w] holds the number of
+// paths i - u - w with u, w > i. A 4-cycle i - u - w - y is then one of the
+// C(U[w], 2) pairs of paths to w. For a 5-cycle i - u - w - x - y, every path
+// i - u - w is extended by an edge w -> x of an acyclic orientation (given by
+// an approximate degeneracy order, so that out-degrees are small), and the
+// paths i - y - x with y != u, w are read from U[x]. Every 5-cycle is counted
+// once, for the orientation of its edge opposite to i.
+//
+// The wedge table of a vertex has at most min(W, n - i - 1) keys, where W is
+// the number of wedges from i. Each worker has one scratch buffer for each of
+// the two layouts of the table, each of at most max_scratch_bytes / 2 bytes:
+//  - a hash table (sequentialHT) of twice the number of keys, rounded up to a
+//    power of two, when the wedges are sparse in the range of keys (4W is less
+//    than the range) and the table fits;
+//  - otherwise, a dense array over a window of the keys. If the range does
+//    not fit, the keys are processed in windows of the buffer size, and the
+//    wedges of i are scanned once per window.
+// The scratch memory is therefore bounded independently of n and of the
+// maximum degree, at the cost of extra passes over the wedges of the few
+// vertices whose tables do not fit.
+//
+// The vertices are processed in blocks of about equal numbers of wedges, in
+// parallel, and every block is processed sequentially by one worker.
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <tuple>
+#include <utility>
+
+#include "benchmarks/DegeneracyOrder/GoodrichPszona11/DegeneracyOrder.h"
+#include "gbbs/gbbs.h"
+#include "gbbs/helpers/sequential_ht.h"
+
+namespace gbbs {
+namespace cycle_count {
+
+struct Options {
+  // The maximum size of the wedge tables of a worker, in bytes.
+  size_t max_scratch_bytes = size_t{64} << 20;
+  // The epsilon of the approximate degeneracy order that orients the edges.
+  double epsilon = 0.1;
+  // The approximate number of wedges in a block of vertices.
+  size_t block_work = size_t{1} << 20;
+};
+
+struct Counts {
+  size_t four_cycles = 0;
+  size_t five_cycles = 0;
+};
+
+// The graph relabeled by decreasing degree (ties broken by id), with every
+// adjacency list sorted in decreasing order, so that the neighbors larger
+// than a given vertex are a prefix of the list.
+struct RankedGraph {
+  size_t n;
+  // The neighbors of v are nghs[offsets[v], offsets[v + 1]).
+  sequence<size_t> offsets;
+  sequence<uintE> nghs;
+  // The out-neighbors of v in the degeneracy orientation are
+  // out_nghs[out_offsets[v], out_offsets[v + 1]).
+  sequence<size_t> out_offsets;
+  sequence<uintE> out_nghs;
+
+  template <class Graph>
+  RankedGraph(Graph& G, double epsilon) : n(G.n) {
+    using W = typename Graph::weight_type;
+    auto rank = goodrichpszona_degen::DegeneracyOrder_intsort(G, epsilon);
+    auto degree = [&](uintE v) { return G.get_vertex(v).out_degree(); };
+    auto order = sequence<uintE>::from_function(n, [](size_t v) { return v; });
+    parlay::sort_inplace(make_slice(order), [&](uintE u, uintE v) {
+      return degree(u) > degree(v) || (degree(u) == degree(v) && u < v);
+    });
+    auto ids = sequence<uintE>::uninitialized(n);
+    parallel_for(0, n, [&](size_t k) { ids[order[k]] = k; });
+    auto levels = sequence<uintE>::from_function(
+        n, [&](size_t k) { return rank[order[k]]; });
+
+    offsets = sequence<size_t>::from_function(n + 1, [&](size_t k) -> size_t {
+      return (k == n) ? 0 : degree(order[k]);
+    });
+    parlay::scan_inplace(make_slice(offsets));
+    nghs = sequence<uintE>::uninitialized(offsets[n]);
+    parallel_for(0, n, 1, [&](size_t k) {
+      size_t i = offsets[k];
+      auto map_f = [&](const uintE& src, const uintE& v, const W& wgh) {
+        nghs[i++] = ids[v];
+      };
+      G.get_vertex(order[k]).out_neighbors().map(map_f, /*parallel=*/false);
+      parlay::sort_inplace(nghs.cut(offsets[k], offsets[k + 1]),
+                           std::greater<uintE>());
+    });
+
+    auto is_out = [&](uintE v, uintE x) { return levels[v] < levels[x]; };
+    out_offsets =
+        sequence<size_t>::from_function(n + 1, [&](size_t v) -> size_t {
+          if (v == n) return 0;
+          return std::count_if(begin(v), end(v),
+                               [&](uintE x) { return is_out(v, x); });
+        });
+    parlay::scan_inplace(make_slice(out_offsets));
+    out_nghs = sequence<uintE>::uninitialized(out_offsets[n]);
+    parallel_for(0, n, 1, [&](size_t v) {
+      std::copy_if(begin(v), end(v), out_nghs.begin() + out_offsets[v],
+                   [&](uintE x) { return is_out(v, x); });
+    });
+  }
+
+  const uintE* begin(uintE v) const { return nghs.begin() + offsets[v]; }
+  const uintE* end(uintE v) const { return nghs.begin() + offsets[v + 1]; }
+  const uintE* out_begin(uintE v) const {
+    return out_nghs.begin() + out_offsets[v];
+  }
+  const uintE* out_end(uintE v) const {
+    return out_nghs.begin() + out_offsets[v + 1];
+  }
+  // The end of the neighbors of v that are larger than i.
+  const uintE* upper_end(uintE v, uintE i) const {
+    return std::lower_bound(begin(v), end(v), i, std::greater<uintE>());
+  }
+};
+
+// A wedge table over the keys [lo, hi), stored in a dense array.
+struct DenseTable {
+  uintE* counts;
+  uintE lo;
+  uintE hi;
+
+  bool contains(uintE x) const { return lo <= x && x < hi; }
+  void increment(uintE x) { counts[x - lo]++; }
+  void decrement(uintE x) { counts[x - lo]--; }
+  uintE get(uintE x) const { return counts[x - lo]; }
+  size_t num_pairs() const {
+    size_t pairs = 0;
+    for (uintE k = 0; k < hi - lo; k++) {
+      pairs += size_t{counts[k]} * (counts[k] - 1) / 2;
+    }
+    return pairs;
+  }
+  void clear() { std::fill(counts, counts + (hi - lo), 0); }
+};
+
+// A wedge table over all keys, stored in a hash table.
+struct HashTable {
+  using Slot = std::tuple<uintE, uintE>;
+  static constexpr Slot kEmpty = {UINT_E_MAX, 0};
+  sequentialHT<uintE, uintE> table;
+
+  // The size of slots must be a power of two.
+  HashTable(Slot* slots, size_t size) : table(slots, size, kEmpty) {}
+
+  bool contains(uintE x) const { return true; }
+  void increment(uintE x) { table.insertAdd(x); }
+  void decrement(uintE x) {
+    auto update = Slot{x, static_cast<uintE>(-1)};
+    table.insertAdd(update);
+  }
+  uintE get(uintE x) { return std::get<1>(table.find(x)); }
+  size_t num_pairs() const {
+    size_t pairs = 0;
+    for (size_t k = 0; k < table.m; k++) {
+      uintE count = std::get<1>(table.table[k]);
+      pairs += size_t{count} * (count - 1) / 2;
+    }
+    return pairs;
+  }
+  void clear() { std::fill(table.table, table.table + table.m, kEmpty); }
+};
+
+// Adds the numbers of 4-cycles and 5-cycles whose smallest vertex is i, and
+// whose wedge table keys (the vertices x of the paths i - u - x) are in T, to
+// counts.
+template <class Table>
+void CountVertexCycles(const RankedGraph& G, uintE i, Table& T,
+                       Counts& counts) {
+  const uintE *i_begin = G.begin(i), *i_end = G.upper_end(i, i);
+  auto map_upper = [&](uintE v, auto f) {
+    for (const uintE* w = G.begin(v); w != G.end(v) && *w > i; w++) f(*w);
+  };
+  for (const uintE* u = i_begin; u != i_end; u++) {
+    map_upper(*u, [&](uintE w) {
+      if (T.contains(w)) T.increment(w);
+    });
+  }
+  counts.four_cycles += T.num_pairs();
+
+  for (const uintE* u = i_begin; u != i_end; u++) {
+    // Removes the paths through u, which cannot be the vertex y.
+    map_upper(*u, [&](uintE w) {
+      if (T.contains(w)) T.decrement(w);
+    });
+    map_upper(*u, [&](uintE w) {
+      // The path i - w - x is in U[x] when w is a neighbor of i.
+      uintE through_w = std::binary_search(i_begin, i_end, w,
+                                           std::greater<uintE>());
+      for (const uintE* x = G.out_begin(w); x != G.out_end(w) && *x > i; x++) {
+        if (*x != *u && T.contains(*x)) {
+          counts.five_cycles += T.get(*x) - through_w;
+        }
+      }
+    });
+    map_upper(*u, [&](uintE w) {
+      if (T.contains(w)) T.increment(w);
+    });
+  }
+  T.clear();
+}
+
+}  // namespace cycle_count
+
+// Returns the numbers of 4-cycles and 5-cycles of the symmetric graph G, using
+// at most options.max_scratch_bytes of scratch memory per worker (in addition
+// to the O(n + m) relabeled graph).
+template <class Graph>
+cycle_count::Counts CountCycles(Graph& G,
+                                const cycle_count::Options& options = {}) {
+  using cycle_count::Counts;
+  using Slot = cycle_count::HashTable::Slot;
+  const size_t n = G.n;
+  timer t;
+  t.start();
+  auto R = cycle_count::RankedGraph(G, options.epsilon);
+  gbbs_debug(t.next("relabeling time"););
+
+  auto wedges = sequence<size_t>::from_function(n, [&](size_t i) {
+    size_t count = 0;
+    for (const uintE* u = R.begin(i); u != R.upper_end(i, i); u++) {
+      count += R.upper_end(*u, i) - R.begin(*u);
+    }
+    return count;
+  });
+  // Every vertex counts for at least one unit of work.
+  auto work = sequence<size_t>::from_function(
+      n, [&](size_t i) { return wedges[i] + 1; });
+  size_t total_work = parlay::scan_inplace(make_slice(work));
+  size_t num_blocks = std::max<size_t>(
+      std::min(total_work / options.block_work, n), num_workers());
+  size_t block_size = total_work / num_blocks + 1;
+  num_blocks = (total_work + block_size - 1) / block_size;
+
+  const size_t dense_capacity =
+      std::max<size_t>(options.max_scratch_bytes / 2 / sizeof(uintE), 1);
+  const size_t hash_capacity =
+      size_t{1} << (parlay::log2_up(std::max<size_t>(
+                        options.max_scratch_bytes / 2 / sizeof(Slot), 2) +
+                    1) -
+                    1);
+  struct Scratch {
+    sequence<uintE> counts;
+    sequence<Slot> slots;
+  };
+  auto block_counts = sequence<Counts>(num_blocks);
+
+  auto init_scratch = [&](Scratch* S) {};
+  auto finish_scratch = [&](Scratch* S) {
+    if (S != nullptr) {
+      delete S;
+    }
+  };
+  parallel_for_alloc<Scratch>(
+      init_scratch, finish_scratch, 0, num_blocks, [&](size_t b, Scratch* S) {
+        auto block_start = [&](size_t c) {
+          return std::lower_bound(work.begin(), work.end(), c * block_size) -
+                 work.begin();
+        };
+        size_t start = block_start(b), end = block_start(b + 1);
+        Counts counts;
+        for (size_t i = start; i < end; i++) {
+          if (wedges[i] == 0) continue;
+          size_t range = n - i - 1;
+          size_t keys = std::min(wedges[i], range);
+          size_t hash_size = size_t{1} << parlay::log2_up(2 * keys);
+          if (4 * wedges[i] < range && hash_size <= hash_capacity) {
+            if (S->slots.size() < hash_size) {
+              S->slots =
+                  sequence<Slot>(hash_size, cycle_count::HashTable::kEmpty);
+            }
+            cycle_count::HashTable T(S->slots.begin(), hash_size);
+            cycle_count::CountVertexCycles(R, i, T, counts);
+          } else {
+            size_t window = std::min(range, dense_capacity);
+            if (S->counts.size() < window) {
+              S->counts = sequence<uintE>(window, 0);
+            }
+            for (size_t lo = i + 1; lo < n; lo += window) {
+              uintE hi = std::min(lo + window, n);
+              cycle_count::DenseTable T{S->counts.begin(),
+                                        static_cast<uintE>(lo), hi};
+              cycle_count::CountVertexCycles(R, i, T, counts);
+            }
+          }
+        }
+        block_counts[b] = counts;
+      },
+      1, false);
+  Counts total;
+  total.four_cycles = parlay::reduce(parlay::delayed_seq<size_t>(
+      num_blocks, [&](size_t b) { return block_counts[b].four_cycles; }));
+  total.five_cycles = parlay::reduce(parlay::delayed_seq<size_t>(
+      num_blocks, [&](size_t b) { return block_counts[b].five_cycles; }));
+  gbbs_debug(t.next("counting time"););
+  return total;
+}
+
+}  // namespace gbbs
@@ -1,10 +1,15 @@
 #include "FiveCycle.h"
 
+#include "CycleCount.h"
+#include "gbbs/sampling_estimator.h"
+
 namespace gbbs {
 template <class Graph>
 std::tuple<ulong, double> Count5Cycle_runner(Graph& G, long order_type,
                                              bool experiment, bool escape,
-                                             bool no_schedule, bool serial) {
+                                             bool no_schedule, bool serial,
+                                             bool bounded,
+                                             size_t max_scratch_bytes) {
   std::cout << "### Direct Type: ";
   if (order_type == 0) {
     std::cout << "Goodrich-Pszona" << std::endl;
@@ -19,7 +24,16 @@ std::tuple<ulong, double> Count5Cycle_runner(Graph& G, long order_type,
   ulong numCycles;
   timer t;
   t.start();
-  if (experiment) {
+  if (bounded) {
+    std::cout << "### Bounded scratch (Parallel): " << max_scratch_bytes
+              << " bytes per worker" << std::endl;
+    cycle_count::Options options;
+    options.max_scratch_bytes = max_scratch_bytes;
+    auto counts = CountCycles(G, options);
+    std::cout << "### Number of 4-Cycles: " << counts.four_cycles
+              << std::endl;
+    numCycles = counts.five_cycles;
+  } else if (experiment) {
     std::cout << "### Experiment (parallel)" << std::endl;
     numCycles = Count5Cycle_experiment(G, order_type);
   } else if (escape) {
@@ -60,42 +74,46 @@ double Count5Cycle_runner(Graph& G, commandLine P) {
   assert(P.getOption("-s"));  // make sure input graph is symmetric
 
   bool sparsify = P.getOptionValue(
-      "--sparse");  // if set, use colorful sparsification for approx counting
-  long sparsify_denom = P.getOptionLongValue(
-      "--colors", 0);  // number of colors for colorful sparsification
-  long esparsify_denom = P.getOptionLongValue(
-      "--edenom", 0);  // probability of keeping an edge for edge sparsification
+      "--sparse");  // if set, estimate the count by sparsification
+  // The sampling options (--colors, --edenom, -samples, -relerr, ...) are
+  // described in gbbs/sampling_estimator.h.
+  auto options = sampling::ParseSamplingOptions(P);
+  bool sampled = P.getOptionLongValue("--colors", 0) != 0 ||
+                 P.getOptionLongValue("--edenom", 0) != 0;
 
   bool serial = P.getOptionValue("--serial");
   bool no_schedule = P.getOptionValue("--no-schedule");
   bool experiment = P.getOptionValue("--exp");
   bool escape = P.getOptionValue("--escape");
   long order_type = P.getOptionLongValue("-o", 0);
+  // if set, runs the memory-capped counter of CycleCount.h, with at most
+  // -scratch MB of wedge tables per worker.
+  bool bounded = P.getOptionValue("--bounded");
+  long scratch_mb = P.getOptionLongValue("-scratch", 64);
+  if (scratch_mb < 1) {
+    std::cout << "-scratch must be at least 1 (MB)."
+              << "\n";
+    exit(-1);
+  }
+  size_t max_scratch_bytes = static_cast<size_t>(scratch_mb) << 20;
 
-  if (sparsify) {
-    // Colorful sparsify graph, with random seed
-    if (sparsify_denom != 0) {
-      auto G_sparse = clr_sparsify_graph(G, sparsify_denom, 7398234);
-      auto ret = Count5Cycle_runner(G_sparse, order_type, experiment, escape,
-                                    no_schedule, serial);
-      auto count = std::get<0>(ret);
-      count = count * pow(sparsify_denom, 4);  // TODO: fix
-      std::cout << "un-sparse count: " << count << std::endl;
-      return std::get<1>(ret);
-    } else if (esparsify_denom != 0) {
-      // edge sparsify
-      auto G_sparse = edge_sparsify_graph(G, esparsify_denom, 7398234);
-      auto ret = Count5Cycle_runner(G_sparse, order_type, experiment, escape,
-                                    no_schedule, serial);
-      auto count = std::get<0>(ret);
-      count = count * pow(esparsify_denom, 5);  // TODO: fix
-      std::cout << "un-sparse count: " << count << std::endl;
-      return std::get<1>(ret);
-    }
+  if (sparsify && sampled) {
+    timer t;
+    t.start();
+    auto count_f = [&](auto& H) {
+      return std::get<0>(Count5Cycle_runner(H, order_type, experiment, escape,
+                                            no_schedule, serial, bounded,
+                                            max_scratch_bytes));
+    };
+    auto est = sampling::EstimateCount(G, sampling::CyclePattern(5), count_f,
+                                       options);
+    sampling::PrintEstimate(est, options.confidence);
+    return t.stop();
   }
 
   return std::get<1>(Count5Cycle_runner(G, order_type, experiment, escape,
-                                        no_schedule, serial));
+                                        no_schedule, serial, bounded,
+                                        max_scratch_bytes));
 }
 }  // namespace gbbs
 
@@ -25,46 +25,6 @@
 
 namespace gbbs {
 
-template <class Graph>
-auto clr_sparsify_graph(Graph& GA, size_t denom, long seed) {
-  using W = typename Graph::weight_type;
-  size_t n = GA.n;
-  // Color vertices with denom colors
-  uintE numColors = std::max((size_t)1, denom);
-  auto colors = sequence<uintE>::from_function(
-      n, [&](size_t i) { return parlay::hash64((uintE)seed + i) % numColors; });
-  auto pack_predicate = [&](const uintE& u, const uintE& v, const W& wgh) {
-    if (colors[u] == colors[v]) return 2;
-    return 1;
-  };
-  auto edges = filter_edges(GA, pack_predicate);
-  auto edges_seq = edges.to_seq();
-  return symmetric_graph<symmetric_vertex, gbbs::empty>::from_edges(edges_seq, n);
-}
-
-template <class Graph>
-auto edge_sparsify_graph(Graph& GA, size_t denom, long seed) {
-  // If we sparsify and then symmetrize, probability of or is
-  // 1 - (1-p)^2
-  // So we want to sample with probability q such that p = 1 - (1 - q)^2
-  // q = 1 - sqrt(1 - p) where p = 1 / denom
-  using W = typename Graph::weight_type;
-  size_t n = GA.n;
-  // Color vertices with denom colors
-  uintE numColors =
-      std::max((uintE)1, (uintE)(1.0 / (1.0 - std::sqrt(1 - 1.0 / denom))));
-  auto pack_predicate = [&](const uintE& u, const uintE& v, const W& wgh) {
-    if ((parlay::hash64((uintE)seed + parlay::hash64(u * n + v)) % numColors) ==
-        0)
-      return 2;
-    return 1;
-  };
-  // Filter into an edge array, and then construct sym graph from edges
-  auto edges = filter_edges(GA, pack_predicate);
-
-  return gbbs_io::edge_list_to_symmetric_graph(edges);
-}
-
 struct U_FastReset {
   uintE* U = nullptr;
   uintE* distinct = nullptr;
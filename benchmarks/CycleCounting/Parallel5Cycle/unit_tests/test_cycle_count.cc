@@ -0,0 +1,94 @@
+#include "benchmarks/CycleCounting/Parallel5Cycle/CycleCount.h"
+
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <unordered_set>
+#include <vector>
+
+#include "gbbs/graph.h"
+#include "gbbs/helpers/undirected_edge.h"
+#include "gbbs/macros.h"
+#include "gbbs/unit_tests/graph_test_utils.h"
+#include "gtest/gtest.h"
+
+namespace gbbs {
+
+namespace {
+
+using Adjacency = std::vector<std::set<uintE>>;
+
+// Returns the number of k-cycles by extending the paths that start at the
+// smallest vertex of the cycle.
+size_t BruteForceCycles(const Adjacency& adj, size_t k) {
+  size_t count = 0;
+  std::vector<uintE> path;
+  std::function<void()> extend = [&]() {
+    if (path.size() == k) {
+      // Every cycle is found in both directions; keep one of them.
+      if (adj[path.back()].count(path[0]) > 0 && path[1] < path.back()) {
+        count++;
+      }
+      return;
+    }
+    for (uintE v : adj[path.back()]) {
+      if (v > path[0] &&
+          std::find(path.begin(), path.end(), v) == path.end()) {
+        path.push_back(v);
+        extend();
+        path.pop_back();
+      }
+    }
+  };
+  for (uintE v = 0; v < adj.size(); v++) {
+    path = {v};
+    extend();
+  }
+  return count;
+}
+
+// Checks the counts of a pseudo-random graph on n vertices, with edge
+// probability about p, for several scratch sizes.
+void CheckRandomGraph(uintE n, double p, uint64_t seed) {
+  auto graph = graph_test::MakeRandomSymmetricGraph(n, p, seed);
+  Adjacency adj = graph_test::RandomAdjacencySets(n, p, seed);
+  size_t four_cycles = BruteForceCycles(adj, 4);
+  size_t five_cycles = BruteForceCycles(adj, 5);
+
+  cycle_count::Options options;
+  // With 32-bit vertex ids, 16 bytes allow dense windows of two keys only,
+  // and 1024 bytes allow windows of 128 keys and hash tables of 64 slots.
+  const size_t default_bytes = options.max_scratch_bytes;
+  for (size_t scratch_bytes : {size_t{16}, size_t{1024}, default_bytes}) {
+    options.max_scratch_bytes = scratch_bytes;
+    auto counts = CountCycles(graph, options);
+    EXPECT_EQ(counts.four_cycles, four_cycles) << scratch_bytes;
+    EXPECT_EQ(counts.five_cycles, five_cycles) << scratch_bytes;
+  }
+}
+
+}  // namespace
+
+TEST(CountCycles, DenseGraphs) {
+  CheckRandomGraph(14, 0.5, 50);
+  CheckRandomGraph(14, 0.25, 51);
+}
+
+TEST(CountCycles, SparseGraph) {
+  // Most wedge tables of a sparse graph are hash tables.
+  CheckRandomGraph(400, 0.025, 52);
+}
+
+TEST(CountCycles, CompleteGraph) {
+  // K_6 has 45 4-cycles and 72 5-cycles.
+  std::unordered_set<UndirectedEdge> edges;
+  for (uintE u = 0; u < 6; u++) {
+    for (uintE v = u + 1; v < 6; v++) edges.insert({u, v});
+  }
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(6, edges);
+  auto counts = CountCycles(graph);
+  EXPECT_EQ(counts.four_cycles, 45);
+  EXPECT_EQ(counts.five_cycles, 72);
+}
+
+}  // namespace gbbs
@@ -0,0 +1,63 @@
+// Usage:
+// > numactl -i all ./SpeculativeColoring -s -m clueweb_sym.bytepda
+// flags:
+//   required:
+//     -s : indicate that the graph is symmetric
+//   optional:
+//     -c : indicate that the graph should be mmap'd
+//     -m : indicate that the graph is compressed
+//     -d2 : compute a distance-2 coloring
+//     -balanced : balance the sizes of the color classes
+//     -stats : output statistics on the resulting coloring
+//     -verify : verify that the algorithm produced a valid coloring
+
+#include "SpeculativeColoring.h"
+
+#include <iostream>
+
+namespace gbbs {
+template <class Graph>
+double SpeculativeColoring_runner(Graph& G, commandLine P) {
+  bool distance2 = P.getOption("-d2");
+  bool balanced = P.getOption("-balanced");
+  std::cout << "### Application: SpeculativeColoring" << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -d2 = " << distance2
+            << " -balanced = " << balanced << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+  assert(P.getOption("-s"));
+
+  timer t;
+  t.start();
+  auto colors = SpeculativeColoring(G, distance2, balanced);
+  double tt = t.stop();
+  if (P.getOption("-stats")) {
+    size_t num_colors = (G.n == 0) ? 0 : parlay::reduce_max(colors) + 1;
+    auto sizes = sequence<size_t>(num_colors, 0);
+    for (size_t i = 0; i < G.n; i++) {
+      sizes[colors[i]]++;
+    }
+    std::cout << "num_colors = " << num_colors << "\n";
+    std::cout << "largest class = " << parlay::reduce_max(sizes) << "\n";
+  }
+  if (P.getOption("-verify")) {
+    using W = typename Graph::weight_type;
+    auto conflicts = parlay::delayed_seq<size_t>(G.n, [&](size_t v) {
+      auto pred = [&](const uintE& src, const uintE& ngh, const W& wgh) {
+        return colors[src] == colors[ngh];
+      };
+      return G.get_vertex(v).out_neighbors().count(pred);
+    });
+    size_t ct = parlay::reduce(conflicts);
+    std::cout << (ct > 0 ? "Invalid coloring" : "Valid coloring") << "\n";
+  }
+
+  std::cout << "### Running Time: " << tt << std::endl;
+  return tt;
+}
+}  // namespace gbbs
+
+generate_symmetric_main(gbbs::SpeculativeColoring_runner, false);
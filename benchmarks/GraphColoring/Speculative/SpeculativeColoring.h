@@ -0,0 +1,248 @@
+// Speculative graph coloring, following Gebremedhin and Manne ("Scalable
+// parallel graph coloring algorithms") and Catalyurek et al. ("Graph coloring
+// algorithms for multi-core and massively multithreaded architectures").
+// Every round colors a worklist of vertices in parallel, each vertex taking
+// the smallest color not used by its neighbors (first fit) while ignoring
+// that its neighbors may be colored concurrently. A second parallel pass then
+// detects the conflicts, i.e., pairs of adjacent worklist vertices that got
+// the same color, and the larger endpoint of every conflict forms the
+// worklist of the next round. The smallest vertex of a worklist never
+// conflicts, so every round makes progress, and in practice few rounds are
+// needed.
+//
+// The colors used by the neighbors of a vertex are collected in a bitset, and
+// the first free color is found by scanning the bitset a word at a time with
+// count-trailing-zeros. Every worker owns one bitset that is reused (and
+// cleared word by word) across vertices; a vertex is colored without nested
+// parallelism, so a worker never interleaves two vertices.
+//
+// Options:
+//  - distance2: computes a distance-2 coloring, in which vertices at distance
+//    at most two get different colors.
+//  - balanced: after the coloring, rebalances the sizes of the color classes
+//    (Lu et al., "Balanced coloring for parallel computing applications").
+//    Every color class larger than ceil(n / C), where C is the number of
+//    colors, gives away vertices to the smallest free color whose class is
+//    below that size, and the resulting conflicts are resolved as above.
+
+#pragma once
+
+#include "gbbs/gbbs.h"
+
+namespace gbbs {
+namespace speculative_coloring {
+
+constexpr uintE kUncolored = UINT_E_MAX;
+
+template <class Graph>
+struct SpeculativeColorer {
+  using W = typename Graph::weight_type;
+
+  Graph& G;
+  size_t n;
+  bool distance2;
+  sequence<uintE> colors;
+  // One bitset of forbidden colors per worker; all zero between uses.
+  sequence<sequence<uint64_t>> scratch;
+  // Class sizes and the maximum class size, used when rebalancing.
+  sequence<intE> class_sizes;
+  intE capacity;
+  size_t rounds;
+
+  SpeculativeColorer(Graph& G, bool distance2)
+      : G(G),
+        n(G.n),
+        distance2(distance2),
+        colors(G.n, kUncolored),
+        scratch(num_workers()),
+        capacity(0),
+        rounds(0) {}
+
+  // Calls f(u) for every vertex u != v within distance one (or two) of v.
+  template <class F>
+  void map_neighborhood(uintE v, F f) {
+    auto map_f = [&](const uintE& src, const uintE& ngh, const W& wgh) {
+      f(ngh);
+      if (distance2) {
+        auto map2_f = [&](const uintE& ngh, const uintE& ngh2, const W& wgh2) {
+          if (ngh2 != v) f(ngh2);
+        };
+        G.get_vertex(ngh).out_neighbors().map(map2_f, /*parallel=*/false);
+      }
+    };
+    G.get_vertex(v).out_neighbors().map(map_f, /*parallel=*/false);
+  }
+
+  // An upper bound on the number of vertices in the neighborhood of v.
+  size_t neighborhood_size(uintE v) {
+    size_t total = G.get_vertex(v).out_degree();
+    if (distance2) {
+      auto map_f = [&](const uintE& src, const uintE& ngh, const W& wgh) {
+        total += G.get_vertex(ngh).out_degree();
+      };
+      G.get_vertex(v).out_neighbors().map(map_f, /*parallel=*/false);
+    }
+    return total;
+  }
+
+  // Returns a color for v that is not used in its neighborhood. The smallest
+  // free color is used unless allowed(c) is given, in which case the smallest
+  // free color c with allowed(c) is preferred.
+  template <class Allowed>
+  uintE choose_color(uintE v, size_t min_colors, Allowed allowed) {
+    // Only colors below `limit` can be the answer. With distance2, the
+    // neighborhood size counts vertices with multiplicity and can far exceed
+    // n, but at most n - 1 distinct colors are forbidden.
+    size_t limit =
+        std::min(std::max(neighborhood_size(v) + 1, min_colors), n + 1);
+    size_t num_words = (limit + 63) / 64;
+    auto& bits = scratch[worker_id()];
+    if (bits.size() < num_words) {
+      bits.resize(num_words, 0);
+    }
+    map_neighborhood(v, [&](const uintE& u) {
+      uintE c = colors[u];
+      if (c < limit) {
+        bits[c >> 6] |= uint64_t{1} << (c & 63);
+      }
+    });
+    uintE first_free = kUncolored;
+    uintE chosen = kUncolored;
+    for (size_t i = 0; i < num_words && chosen == kUncolored; i++) {
+      uint64_t free_bits = ~bits[i];
+      while (free_bits != 0) {
+        uintE c = i * 64 + __builtin_ctzll(free_bits);
+        if (first_free == kUncolored) first_free = c;
+        if (allowed(c)) {
+          chosen = c;
+          break;
+        }
+        free_bits &= free_bits - 1;
+      }
+    }
+    for (size_t i = 0; i < num_words; i++) {
+      bits[i] = 0;
+    }
+    return (chosen == kUncolored) ? first_free : chosen;
+  }
+
+  // Returns true if v shares its color with a smaller vertex in its
+  // neighborhood.
+  bool conflicted(uintE v) {
+    uintE c = colors[v];
+    bool conflict = false;
+    map_neighborhood(v, [&](const uintE& u) {
+      if (u < v && colors[u] == c) conflict = true;
+    });
+    return conflict;
+  }
+
+  // Colors every vertex of the worklist with color_f(v), detects conflicts,
+  // and repeats on the conflicting vertices until there are none.
+  template <class ColorF>
+  void resolve(sequence<uintE> worklist, ColorF color_f) {
+    while (worklist.size() > 0) {
+      parallel_for(0, worklist.size(), 1, [&](size_t i) {
+        uintE v = worklist[i];
+        colors[v] = color_f(v);
+      });
+      auto conflicts = sequence<bool>::from_function(
+          worklist.size(), [&](size_t i) { return conflicted(worklist[i]); });
+      worklist = parlay::pack(worklist, conflicts);
+      gbbs_debug(std::cout << "# round " << rounds
+                           << ": conflicts = " << worklist.size()
+                           << std::endl;);
+      rounds++;
+    }
+  }
+
+  void color() {
+    auto first_fit = [&](uintE v) {
+      return choose_color(v, 0, [](uintE c) { return true; });
+    };
+    resolve(sequence<uintE>::from_function(n, [](size_t i) { return i; }),
+            first_fit);
+  }
+
+  // Moves vertices out of color classes larger than ceil(n / C) into the
+  // smallest free color whose class is smaller.
+  void balance() {
+    size_t num_colors = (n == 0) ? 0 : parlay::reduce_max(colors) + 1;
+    if (num_colors <= 1) return;
+    capacity = (n + num_colors - 1) / num_colors;
+
+    // Group the vertices by color; the vertices beyond the first `capacity`
+    // vertices of each class are moved.
+    auto by_color = parlay::sort(
+        sequence<uintE>::from_function(n, [](size_t i) { return i; }),
+        [&](uintE a, uintE b) {
+          return std::make_pair(colors[a], a) < std::make_pair(colors[b], b);
+        });
+    auto class_starts = sequence<size_t>(num_colors + 1, n);
+    parallel_for(0, n, kDefaultGranularity, [&](size_t i) {
+      uintE c = colors[by_color[i]];
+      if (i == 0 || colors[by_color[i - 1]] != c) class_starts[c] = i;
+    });
+    // Empty classes start where the next class starts.
+    for (size_t c = num_colors; c > 0; c--) {
+      class_starts[c - 1] = std::min(class_starts[c - 1], class_starts[c]);
+    }
+    class_sizes = sequence<intE>::from_function(num_colors, [&](size_t c) {
+      return static_cast<intE>(class_starts[c + 1] - class_starts[c]);
+    });
+    auto is_mover = parlay::delayed_seq<bool>(n, [&](size_t i) {
+      size_t rank = i - class_starts[colors[by_color[i]]];
+      return rank >= static_cast<size_t>(capacity);
+    });
+    auto movers = parlay::pack(by_color, is_mover);
+    gbbs_debug(std::cout << "# balancing: capacity = " << capacity
+                         << " movers = " << movers.size() << std::endl;);
+
+    // Tries to reserve a slot in class c.
+    auto reserve = [&](uintE c) {
+      if (c >= num_colors || class_sizes[c] >= capacity) return false;
+      if (gbbs::fetch_and_add(&class_sizes[c], 1) < capacity) return true;
+      gbbs::write_add(&class_sizes[c], -1);
+      return false;
+    };
+    // Moves v to the smallest free color with room, or to its smallest free
+    // color if no class with room is free.
+    auto balanced_fit = [&](uintE v) {
+      uintE old_color = colors[v];
+      if (old_color < num_colors) {
+        gbbs::write_add(&class_sizes[old_color], -1);
+      }
+      bool reserved = false;
+      uintE c = choose_color(v, num_colors, [&](uintE c) {
+        return reserved = reserve(c);
+      });
+      if (!reserved && c < num_colors) {
+        gbbs::write_add(&class_sizes[c], 1);
+      }
+      return c;
+    };
+    resolve(std::move(movers), balanced_fit);
+  }
+};
+
+}  // namespace speculative_coloring
+
+// Returns a (distance-1 or distance-2) coloring of the symmetric graph G.
+template <class Graph>
+inline sequence<uintE> SpeculativeColoring(Graph& G, bool distance2 = false,
+                                           bool balanced = false) {
+  timer t;
+  t.start();
+  auto colorer =
+      speculative_coloring::SpeculativeColorer<Graph>(G, distance2);
+  colorer.color();
+  gbbs_debug(t.next("coloring time"););
+  if (balanced) {
+    colorer.balance();
+    gbbs_debug(t.next("balancing time"););
+  }
+  std::cout << "### Total rounds = " << colorer.rounds << "\n";
+  return std::move(colorer.colors);
+}
+
+}  // namespace gbbs
@@ -0,0 +1,100 @@
+#include "benchmarks/GraphColoring/Speculative/SpeculativeColoring.h"
+
+#include <unordered_set>
+
+#include "gbbs/graph.h"
+#include "gbbs/helpers/undirected_edge.h"
+#include "gbbs/macros.h"
+#include "gbbs/unit_tests/graph_test_utils.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace gbbs {
+
+namespace {
+
+// Returns the number of pairs of distinct vertices within distance one (or
+// two) of each other that share a color.
+template <class Graph>
+size_t NumConflicts(Graph& G, const sequence<uintE>& colors, bool distance2) {
+  size_t conflicts = 0;
+  for (uintE v = 0; v < G.n; v++) {
+    auto map_f = [&](const uintE& src, const uintE& ngh, const auto& wgh) {
+      if (colors[ngh] == colors[v]) conflicts++;
+      if (distance2) {
+        auto map2_f = [&](const uintE& ngh, const uintE& ngh2,
+                          const auto& wgh2) {
+          if (ngh2 != v && colors[ngh2] == colors[v]) conflicts++;
+        };
+        G.get_vertex(ngh).out_neighbors().map(map2_f, /*parallel=*/false);
+      }
+    };
+    G.get_vertex(v).out_neighbors().map(map_f, /*parallel=*/false);
+  }
+  return conflicts;
+}
+
+// A cycle on 200 vertices with chords from every vertex i to i + 7 and
+// i + 31, plus the complete graph on vertices 200, ..., 205.
+auto TestGraph() {
+  constexpr uintE kCycle = 200;
+  std::unordered_set<UndirectedEdge> edges;
+  for (uintE i = 0; i < kCycle; i++) {
+    edges.insert({i, (i + 1) % kCycle});
+    edges.insert({i, (i + 7) % kCycle});
+    edges.insert({i, (i + 31) % kCycle});
+  }
+  for (uintE i = kCycle; i < kCycle + 6; i++) {
+    for (uintE j = i + 1; j < kCycle + 6; j++) {
+      edges.insert({i, j});
+    }
+  }
+  return graph_test::MakeUnweightedSymmetricGraph(kCycle + 6, edges);
+}
+
+size_t NumColors(const sequence<uintE>& colors) {
+  return parlay::reduce_max(colors) + 1;
+}
+
+}  // namespace
+
+TEST(SpeculativeColoring, Distance1) {
+  auto graph = TestGraph();
+  auto colors = SpeculativeColoring(graph);
+  EXPECT_EQ(NumConflicts(graph, colors, /*distance2=*/false), size_t{0});
+  // The clique needs 6 colors and first fit uses at most max degree + 1.
+  EXPECT_GE(NumColors(colors), size_t{6});
+  EXPECT_LE(NumColors(colors), size_t{7});
+}
+
+TEST(SpeculativeColoring, Distance2) {
+  auto graph = TestGraph();
+  auto colors = SpeculativeColoring(graph, /*distance2=*/true);
+  EXPECT_EQ(NumConflicts(graph, colors, /*distance2=*/true), size_t{0});
+  // Every closed neighborhood in the cycle part has 7 vertices.
+  EXPECT_GE(NumColors(colors), size_t{7});
+}
+
+TEST(SpeculativeColoring, Balanced) {
+  auto graph = TestGraph();
+  for (bool distance2 : {false, true}) {
+    auto colors = SpeculativeColoring(graph, distance2, /*balanced=*/true);
+    EXPECT_EQ(NumConflicts(graph, colors, distance2), size_t{0});
+  }
+}
+
+TEST(SpeculativeColoring, BalancedMovesIsolatedVertices) {
+  // One edge, 0 - 1, and eight isolated vertices: first fit puts nine
+  // vertices into color 0 and balancing moves four of them to color 1.
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(
+      10, std::unordered_set<UndirectedEdge>{{0, 1}});
+  auto colors = SpeculativeColoring(graph, /*distance2=*/false,
+                                    /*balanced=*/true);
+  EXPECT_EQ(NumConflicts(graph, colors, /*distance2=*/false), size_t{0});
+  EXPECT_EQ(NumColors(colors), size_t{2});
+  size_t num_zero = 0;
+  for (uintE v = 0; v < graph.n; v++) num_zero += (colors[v] == 0);
+  EXPECT_EQ(num_zero, size_t{5});
+}
+
+}  // namespace gbbs
@@ -0,0 +1,57 @@
+// Usage:
+// numactl -i all ./Partitioning -k 16 -eps 0.03 -rounds 3 -s -m
+// com-orkut.ungraph.txt_SJ
+// flags:
+//   required:
+//     -s : indicates that the graph is symmetric
+//   optional:
+//     -m : indicate that the graph should be mmap'd
+//     -c : indicate that the graph is compressed
+//     -rounds : the number of times to run the algorithm
+//     -k : the number of parts
+//     -eps : the allowed imbalance
+//     -refine : the maximum number of refinement rounds per level
+//     -stats : print the cut and balance statistics of the partition
+
+#include "Partitioning.h"
+
+namespace gbbs {
+
+template <class Graph>
+double Partitioning_runner(Graph& G, commandLine P) {
+  partitioning::PartitionParams params;
+  long k = P.getOptionLongValue("-k", 2);
+  if (k < 1 || static_cast<size_t>(k) > std::max<size_t>(G.n, 1)) {
+    std::cout << "-k must be between 1 and the number of vertices."
+              << std::endl;
+    exit(-1);
+  }
+  params.k = k;
+  params.epsilon = P.getOptionDoubleValue("-eps", 0.03);
+  params.refine_rounds = P.getOptionLongValue("-refine", 10);
+  std::cout << "### Application: Partitioning (Multilevel k-way)" << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -k = " << params.k << " -eps = " << params.epsilon
+            << " -refine = " << params.refine_rounds << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+  assert(P.getOption("-s"));
+
+  timer t;
+  t.start();
+  auto parts = partitioning::Partition(G, params);
+  double tt = t.stop();
+  if (P.getOption("-stats")) {
+    auto stats = partitioning::partition_stats(G, parts, params.k);
+    partitioning::print_stats(stats);
+  }
+
+  std::cout << "### Running Time: " << tt << std::endl;
+  return tt;
+}
+
+}  // namespace gbbs
+
+generate_symmetric_main(gbbs::Partitioning_runner, false);
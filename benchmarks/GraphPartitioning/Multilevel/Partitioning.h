@@ -0,0 +1,413 @@
+// This file provides a multilevel k-way graph partitioner. The graph is
+// coarsened with heavy-edge matchings into a contraction hierarchy
+// (gbbs/contraction_hierarchy.h), the coarsest graph is partitioned by cutting
+// a BFS order into k pieces of equal weight, and the partition is projected
+// back through the hierarchy and improved on every level with parallel,
+// balance-constrained label-propagation refinement.
+
+#pragma once
+
+#include <algorithm>
+#include <queue>
+
+#include "gbbs/contraction_hierarchy.h"
+#include "gbbs/gbbs.h"
+#include "gbbs/helpers/assert.h"
+
+namespace gbbs {
+namespace partitioning {
+
+using part_id = uintE;
+
+struct PartitionParams {
+  // The number of parts.
+  size_t k = 2;
+  // Allowed imbalance: every part has weight at most (1 + epsilon) times the
+  // average part weight.
+  double epsilon = 0.03;
+  // The maximum number of refinement rounds per level.
+  size_t refine_rounds = 10;
+  // The maximum number of matching rounds per coarsening step.
+  size_t matching_rounds = 5;
+  // Coarsening stops once the coarsest graph has at most
+  // coarsest_per_part * k vertices.
+  size_t coarsest_per_part = 40;
+  // The maximum weight of a coarse vertex, as a fraction of the average part
+  // weight. Keeps the coarsest graph partitionable under the balance
+  // constraint.
+  double max_vertex_weight_fraction = 0.25;
+};
+
+namespace internal {
+
+template <class W>
+inline double edge_weight(const W& w) {
+  if constexpr (std::is_same_v<W, gbbs::empty>) {
+    return 1.0;
+  } else {
+    return static_cast<double>(w);
+  }
+}
+
+template <class Graph>
+inline double vertex_weight(const Graph& G, uintE v) {
+  return (G.vertex_weights == nullptr) ? 1.0 : G.vertex_weights[v];
+}
+
+template <class Graph>
+inline double total_vertex_weight(const Graph& G) {
+  return parlay::reduce(parlay::delayed_seq<double>(
+      G.n, [&](size_t i) { return vertex_weight(G, i); }));
+}
+
+// Atomically adds `w` to `*a` unless the result would exceed `cap`. Returns
+// whether the addition happened.
+inline bool add_with_cap(double* a, double w, double cap) {
+  double old_v = *a;
+  while (old_v + w <= cap) {
+    if (gbbs::atomic_compare_and_swap(a, old_v, old_v + w)) return true;
+    old_v = *a;
+  }
+  return false;
+}
+
+// Computes a heavy-edge matching of G and returns it as a clustering where
+// every matched pair forms a cluster (the other vertices are singletons). In
+// every round, each unmatched vertex proposes to its heaviest eligible
+// unmatched neighbor, with ties broken by a hash of the edge, and mutual
+// proposals are matched. Since the order on edges is strict, each round
+// matches every locally-dominant edge. A pair is eligible only if its total
+// vertex weight is at most max_vertex_weight.
+template <class Graph>
+inline sequence<uintE> heavy_edge_matching(Graph& G, double max_vertex_weight,
+                                           size_t max_rounds) {
+  using W = typename Graph::weight_type;
+  size_t n = G.n;
+  auto mate = sequence<uintE>(n, UINT_E_MAX);
+  auto proposal = sequence<uintE>(n, UINT_E_MAX);
+
+  for (size_t round = 0; round < max_rounds; round++) {
+    parallel_for(0, n, 1, [&](size_t i) {
+      proposal[i] = UINT_E_MAX;
+      if (mate[i] != UINT_E_MAX) return;
+      double w_i = vertex_weight(G, i);
+      uintE best = UINT_E_MAX;
+      double best_w = 0;
+      uint64_t best_h = 0;
+      auto map_f = [&](const uintE& u, const uintE& v, const W& wgh) {
+        if (u == v || mate[v] != UINT_E_MAX) return;
+        if (w_i + vertex_weight(G, v) > max_vertex_weight) return;
+        double w = edge_weight(wgh);
+        uint64_t h = parlay::hash64((static_cast<uint64_t>(std::min(u, v))
+                                     << 32) |
+                                    std::max(u, v));
+        if (best == UINT_E_MAX || w > best_w || (w == best_w && h > best_h)) {
+          best = v;
+          best_w = w;
+          best_h = h;
+        }
+      };
+      G.get_vertex(i).out_neighbors().map(map_f, false);
+      proposal[i] = best;
+    });
+    auto matched_now = parlay::delayed_seq<size_t>(n, [&](size_t i) {
+      uintE p = proposal[i];
+      return static_cast<size_t>(p != UINT_E_MAX && proposal[p] == i);
+    });
+    size_t num_matched = parlay::reduce(matched_now);
+    if (num_matched == 0) break;
+    parallel_for(0, n, kDefaultGranularity, [&](size_t i) {
+      uintE p = proposal[i];
+      if (p != UINT_E_MAX && proposal[p] == i) mate[i] = p;
+    });
+  }
+  return sequence<uintE>::from_function(n, [&](size_t i) {
+    return (mate[i] == UINT_E_MAX) ? static_cast<uintE>(i)
+                                   : std::min(static_cast<uintE>(i), mate[i]);
+  });
+}
+
+// Partitions a (small) graph by cutting a BFS order into k contiguous pieces
+// of equal vertex weight, so that most parts are connected. Runs sequentially;
+// it is only called on the coarsest level of the hierarchy.
+template <class Graph>
+inline sequence<part_id> initial_partition(Graph& G, size_t k) {
+  using W = typename Graph::weight_type;
+  size_t n = G.n;
+  auto order = sequence<uintE>();
+  order.reserve(n);
+  auto visited = sequence<bool>(n, false);
+  std::queue<uintE> frontier;
+  for (size_t s = 0; s < n; s++) {
+    if (visited[s]) continue;
+    visited[s] = true;
+    frontier.push(s);
+    while (!frontier.empty()) {
+      uintE u = frontier.front();
+      frontier.pop();
+      order.push_back(u);
+      auto map_f = [&](const uintE& src, const uintE& ngh, const W& wgh) {
+        if (!visited[ngh]) {
+          visited[ngh] = true;
+          frontier.push(ngh);
+        }
+      };
+      G.get_vertex(u).out_neighbors().map(map_f, false);
+    }
+  }
+
+  double target = total_vertex_weight(G) / k;
+  auto parts = sequence<part_id>(n);
+  double prefix = 0;
+  for (size_t i = 0; i < n; i++) {
+    uintE v = order[i];
+    double w = vertex_weight(G, v);
+    // Place v by the midpoint of its weight interval.
+    size_t p = static_cast<size_t>((prefix + w / 2) / target);
+    parts[v] = std::min(p, k - 1);
+    prefix += w;
+  }
+  return parts;
+}
+
+// Improves `parts` with parallel label propagation. A vertex moves to the
+// neighboring part it has the largest connection weight to, if this strictly
+// reduces the cut and the target part stays below max_part_weight. Vertices in
+// overloaded parts may also make non-improving moves. To avoid neighbors
+// swapping back and forth, even sub-rounds only move vertices to parts with
+// larger ids and odd sub-rounds to parts with smaller ids.
+template <class Graph>
+inline void refine(Graph& G, sequence<part_id>& parts, size_t k,
+                   double max_part_weight, size_t rounds) {
+  using W = typename Graph::weight_type;
+  constexpr size_t kSmallK = 64;
+  size_t n = G.n;
+  auto part_weights = sequence<double>(k, 0.0);
+  parallel_for(0, n, kDefaultGranularity, [&](size_t i) {
+    gbbs::write_add(&part_weights[parts[i]], vertex_weight(G, i));
+  });
+
+  // Returns the best target part for vertex i, or UINT_E_MAX.
+  auto best_move = [&](size_t i, size_t direction) -> part_id {
+    part_id p = parts[i];
+    bool overloaded = part_weights[p] > max_part_weight;
+    double w_i = vertex_weight(G, i);
+    auto eligible = [&](part_id q) {
+      if (q == p) return false;
+      if ((direction == 0) != (q > p)) return false;
+      return part_weights[q] + w_i <= max_part_weight;
+    };
+    part_id best = UINT_E_MAX;
+    double best_gain = 0;
+    auto consider = [&](part_id q, double conn_q, double conn_p) {
+      double gain = conn_q - conn_p;
+      if (!eligible(q)) return;
+      if ((gain > 0 || overloaded) &&
+          (best == UINT_E_MAX || gain > best_gain)) {
+        best = q;
+        best_gain = gain;
+      }
+    };
+    if (k <= kSmallK) {
+      double conn[kSmallK] = {};
+      auto map_f = [&](const uintE& u, const uintE& v, const W& wgh) {
+        conn[parts[v]] += edge_weight(wgh);
+      };
+      G.get_vertex(i).out_neighbors().map(map_f, false);
+      for (part_id q = 0; q < k; q++) {
+        if (conn[q] > 0) consider(q, conn[q], conn[p]);
+      }
+    } else {
+      using Elt = std::pair<part_id, double>;
+      auto conn = sequence<Elt>();
+      auto map_f = [&](const uintE& u, const uintE& v, const W& wgh) {
+        conn.push_back({parts[v], edge_weight(wgh)});
+      };
+      G.get_vertex(i).out_neighbors().map(map_f, false);
+      std::sort(conn.begin(), conn.end());
+      double conn_p = 0;
+      for (auto& [q, w] : conn) {
+        if (q == p) conn_p += w;
+      }
+      for (size_t j = 0; j < conn.size();) {
+        part_id q = conn[j].first;
+        double conn_q = 0;
+        for (; j < conn.size() && conn[j].first == q; j++) {
+          conn_q += conn[j].second;
+        }
+        consider(q, conn_q, conn_p);
+      }
+    }
+    return best;
+  };
+
+  for (size_t round = 0; round < rounds; round++) {
+    size_t num_moved = 0;
+    for (size_t direction = 0; direction < 2; direction++) {
+      auto moved = sequence<bool>(n, false);
+      parallel_for(0, n, 1, [&](size_t i) {
+        part_id q = best_move(i, direction);
+        if (q == UINT_E_MAX) return;
+        double w_i = vertex_weight(G, i);
+        if (add_with_cap(&part_weights[q], w_i, max_part_weight)) {
+          gbbs::write_add(&part_weights[parts[i]], -w_i);
+          parts[i] = q;
+          moved[i] = true;
+        }
+      });
+      num_moved += parlay::count(moved, true);
+    }
+    gbbs_debug(std::cout << "# refinement round " << round
+                         << ": moved = " << num_moved << std::endl;);
+    if (num_moved == 0) break;
+  }
+}
+
+}  // namespace internal
+
+// Statistics of a vertex partition of a graph.
+//   edge_cut: the total weight of edges whose endpoints are in different
+//     parts (every undirected edge is counted once).
+//   communication_volume: the number of (vertex, part) pairs such that the
+//     vertex has a neighbor in that part other than its own, i.e., the number
+//     of ghost copies an edge-cut distribution must exchange.
+//   replication_factor: the average number of parts each vertex is replicated
+//     to when the edges are distributed instead (vertex-cut), assigning every
+//     edge to the part of its higher-degree endpoint.
+//   imbalance: the maximum part weight over the average part weight.
+struct PartitionStats {
+  double edge_cut;
+  size_t cut_edges;
+  size_t communication_volume;
+  double replication_factor;
+  double max_part_weight;
+  double imbalance;
+};
+
+template <class Graph>
+inline PartitionStats partition_stats(Graph& G, const sequence<part_id>& parts,
+                                      size_t k) {
+  using W = typename Graph::weight_type;
+  size_t n = G.n;
+  if (k < 1) ABORT("k must be >= 1: " << k);
+  auto cut_weight = sequence<double>(n);
+  auto cut_count = sequence<size_t>(n);
+  auto volume = sequence<size_t>(n);
+  auto replicas = sequence<size_t>(n);
+  parallel_for(0, n, 1, [&](size_t i) {
+    double cw = 0;
+    size_t cc = 0;
+    auto remote_parts = sequence<part_id>();
+    auto edge_parts = sequence<part_id>();
+    uintE deg_i = G.get_vertex(i).out_degree();
+    auto map_f = [&](const uintE& u, const uintE& v, const W& wgh) {
+      if (parts[u] != parts[v]) {
+        cw += internal::edge_weight(wgh);
+        cc++;
+        remote_parts.push_back(parts[v]);
+      }
+      uintE deg_v = G.get_vertex(v).out_degree();
+      bool u_owns = (deg_i > deg_v) || (deg_i == deg_v && u < v);
+      edge_parts.push_back(u_owns ? parts[u] : parts[v]);
+    };
+    G.get_vertex(i).out_neighbors().map(map_f, false);
+    cut_weight[i] = cw;
+    cut_count[i] = cc;
+    auto count_distinct = [](sequence<part_id>& s) {
+      std::sort(s.begin(), s.end());
+      return static_cast<size_t>(std::unique(s.begin(), s.end()) - s.begin());
+    };
+    volume[i] = count_distinct(remote_parts);
+    // A vertex with no edges is still placed on its own part.
+    replicas[i] = std::max<size_t>(count_distinct(edge_parts), 1);
+  });
+
+  auto part_weights = sequence<double>(k, 0.0);
+  parallel_for(0, n, kDefaultGranularity, [&](size_t i) {
+    gbbs::write_add(&part_weights[parts[i]], internal::vertex_weight(G, i));
+  });
+  double max_part_weight = parlay::reduce_max(part_weights);
+  double total = parlay::reduce(part_weights);
+
+  PartitionStats stats;
+  stats.edge_cut = parlay::reduce(cut_weight) / 2;
+  stats.cut_edges = parlay::reduce(cut_count) / 2;
+  stats.communication_volume = parlay::reduce(volume);
+  stats.replication_factor =
+      (n == 0) ? 0 : static_cast<double>(parlay::reduce(replicas)) / n;
+  stats.max_part_weight = max_part_weight;
+  stats.imbalance = (total == 0) ? 1 : max_part_weight / (total / k);
+  return stats;
+}
+
+inline void print_stats(const PartitionStats& stats) {
+  std::cout << "### edge cut = " << stats.edge_cut
+            << " (cut edges = " << stats.cut_edges << ")" << std::endl;
+  std::cout << "### communication volume = " << stats.communication_volume
+            << std::endl;
+  std::cout << "### vertex-cut replication factor = "
+            << stats.replication_factor << std::endl;
+  std::cout << "### max part weight = " << stats.max_part_weight
+            << " imbalance = " << stats.imbalance << std::endl;
+}
+
+// Computes a k-way partition of the vertices of the undirected graph G,
+// minimizing the edge cut subject to every part having weight (number of
+// vertices, or total vertex weight if G has vertex weights) at most
+// (1 + epsilon) times the average.
+//
+// Aborts unless 1 <= k <= max(n, 1).
+//
+// Returns:
+//   A `G.n`-length sequence `S` where `S[i]` in [0, k) is the part of vertex
+//   i.
+template <class Graph>
+inline sequence<part_id> Partition(Graph& G, const PartitionParams& params) {
+  using W = typename Graph::weight_type;
+  size_t k = params.k;
+  size_t max_k = std::max<size_t>(G.n, 1);
+  if (k < 1 || k > max_k) {
+    ABORT("k must be in [1, " << max_k << "]: " << k);
+  }
+  double total = internal::total_vertex_weight(G);
+  double max_part_weight = (1 + params.epsilon) * total / k;
+  double max_vertex_weight =
+      std::max(params.max_vertex_weight_fraction * total / k, 2.0);
+
+  timer t;
+  t.start();
+  auto cluster_f = [&](auto& GL, size_t level) {
+    return internal::heavy_edge_matching(GL, max_vertex_weight,
+                                         params.matching_rounds);
+  };
+  auto weight_f = [](const uintE& u, const uintE& v, const W& wgh) {
+    return internal::edge_weight(wgh);
+  };
+  auto H = contract::build_contraction_hierarchy<double>(
+      G, cluster_f, weight_f, parlay::plus<double>(),
+      /* max_levels = */ std::numeric_limits<size_t>::max(),
+      /* min_vertices = */ params.coarsest_per_part * k);
+  gbbs_debug(t.next("coarsening time");
+             std::cout << "# levels = " << H.num_levels() << std::endl;);
+
+  size_t coarsest = H.num_levels() - 1;
+  sequence<part_id> parts;
+  if (coarsest == 0) {
+    parts = internal::initial_partition(G, k);
+  } else {
+    parts = internal::initial_partition(H.graph(coarsest), k);
+  }
+  gbbs_debug(t.next("initial partition time"););
+
+  for (size_t level = coarsest; level > 0; level--) {
+    internal::refine(H.graph(level), parts, k, max_part_weight,
+                     params.refine_rounds);
+    parts = H.project_down(parts, level, level - 1);
+  }
+  internal::refine(G, parts, k, max_part_weight, params.refine_rounds);
+  gbbs_debug(t.next("uncoarsening and refinement time"););
+  return parts;
+}
+
+}  // namespace partitioning
+}  // namespace gbbs
@@ -0,0 +1,68 @@
+#include "benchmarks/GraphPartitioning/Multilevel/Partitioning.h"
+
+#include <unordered_set>
+
+#include "gbbs/graph.h"
+#include "gbbs/macros.h"
+#include "gbbs/unit_tests/graph_test_utils.h"
+#include "gtest/gtest.h"
+
+namespace gbbs {
+
+TEST(Partitioning, TwoCliquesJoinedByAnEdge) {
+  // Graph diagram: two 4-cliques {0, 1, 2, 3} and {4, 5, 6, 7}, joined by the
+  // edge 3 - 4.
+  constexpr uintE kNumVertices{8};
+  std::unordered_set<UndirectedEdge> edges;
+  for (uintE u = 0; u < 4; u++) {
+    for (uintE v = u + 1; v < 4; v++) {
+      edges.insert({u, v});
+      edges.insert({u + 4, v + 4});
+    }
+  }
+  edges.insert({3, 4});
+  auto graph{graph_test::MakeUnweightedSymmetricGraph(kNumVertices, edges)};
+
+  partitioning::PartitionParams params;
+  params.k = 2;
+  params.epsilon = 0;
+  params.coarsest_per_part = 1;
+  auto parts = partitioning::Partition(graph, params);
+
+  auto stats = partitioning::partition_stats(graph, parts, params.k);
+  EXPECT_EQ(stats.cut_edges, 1);
+  EXPECT_EQ(stats.max_part_weight, 4);
+  EXPECT_EQ(stats.communication_volume, 2);
+  for (uintE v = 1; v < 4; v++) {
+    EXPECT_EQ(parts[v], parts[0]);
+    EXPECT_EQ(parts[v + 4], parts[4]);
+  }
+}
+
+TEST(Partitioning, EdgelessGraphIsBalanced) {
+  constexpr uintE kNumVertices{6};
+  const std::unordered_set<UndirectedEdge> kEdges{};
+  auto graph{graph_test::MakeUnweightedSymmetricGraph(kNumVertices, kEdges)};
+
+  partitioning::PartitionParams params;
+  params.k = 3;
+  auto parts = partitioning::Partition(graph, params);
+
+  auto stats = partitioning::partition_stats(graph, parts, params.k);
+  EXPECT_EQ(stats.cut_edges, 0);
+  EXPECT_EQ(stats.max_part_weight, 2);
+}
+
+TEST(PartitioningDeathTest, RejectsInvalidK) {
+  constexpr uintE kNumVertices{4};
+  const std::unordered_set<UndirectedEdge> kEdges{{0, 1}, {1, 2}, {2, 3}};
+  auto graph{graph_test::MakeUnweightedSymmetricGraph(kNumVertices, kEdges)};
+
+  partitioning::PartitionParams params;
+  params.k = 0;
+  EXPECT_DEATH(partitioning::Partition(graph, params), "k must be in");
+  params.k = kNumVertices + 1;
+  EXPECT_DEATH(partitioning::Partition(graph, params), "k must be in");
+}
+
+}  // namespace gbbs
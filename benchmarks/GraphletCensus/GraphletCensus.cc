@@ -0,0 +1,54 @@
+// Usage:
+// numactl -i all ./GraphletCensus -s -rounds 3 com-orkut.ungraph.txt_SJ
+// flags:
+//   required:
+//     -s : indicates that the graph is symmetric
+//   optional:
+//     -m : indicate that the graph should be mmap'd
+//     -c : indicate that the graph is compressed
+//     -rounds : the number of times to run the algorithm
+//     -stats : print the total of every orbit count over all vertices
+
+#include "GraphletCensus.h"
+
+namespace gbbs {
+template <class Graph>
+double GraphletCensus_runner(Graph& G, commandLine P) {
+  std::cout << "### Application: GraphletCensus" << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -stats = " << P.getOption("-stats") << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+  assert(P.getOption("-s"));
+
+  timer t;
+  t.start();
+  auto census = GraphletCensus(G);
+  double tt = t.stop();
+
+  for (size_t g = 0; g < graphlet_census::kNumGraphlets3; g++) {
+    std::cout << "### Num " << graphlet_census::kGraphlet3Names[g]
+              << " (3 vertices) = "
+              << graphlet_census::ToString(census.graphlets3[g]) << std::endl;
+  }
+  for (size_t g = 0; g < graphlet_census::kNumGraphlets4; g++) {
+    std::cout << "### Num " << graphlet_census::kGraphlet4Names[g]
+              << " (4 vertices) = "
+              << graphlet_census::ToString(census.graphlets4[g]) << std::endl;
+  }
+  if (P.getOption("-stats")) {
+    for (size_t o = 0; o < graphlet_census::kNumOrbits; o++) {
+      auto total = parlay::reduce(parlay::delayed_seq<size_t>(
+          G.n, [&](size_t v) { return census.orbits[v][o]; }));
+      std::cout << "orbit " << o << ": " << total << std::endl;
+    }
+  }
+
+  std::cout << "### Running Time: " << tt << std::endl;
+  return tt;
+}
+}  // namespace gbbs
+
+generate_symmetric_main(gbbs::GraphletCensus_runner, false);
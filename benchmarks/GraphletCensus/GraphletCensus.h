@@ -0,0 +1,325 @@
+// Counts all 3- and 4-vertex graphlets (connected and disconnected) of a
+// symmetric graph, and the per-vertex orbit counts of the connected ones.
+//
+// A graphlet count is the number of vertex subsets that induce the graphlet.
+// The orbits follow the numbering of Przulj ("Biological network comparison
+// using graphlet degree distribution"):
+//   0: edge                     1, 2: end, middle of a 2-path
+//   3: triangle                 4, 5: end, middle of a 3-path
+//   6, 7: leaf, center of a 3-star
+//   8: 4-cycle                  9, 10, 11: tail, triangle vertex of degree
+//                               2, triangle vertex of degree 3 of a tailed
+//                               triangle
+//   12, 13: vertex of degree 2, 3 of a diamond (a 4-cycle with a chord)
+//   14: 4-clique
+//
+// Nothing is enumerated beyond triangles and 4-cliques. With t(v) the number
+// of triangles containing v and s(e) the number of triangles containing edge
+// e (its support), the number of copies of every graphlet that are not
+// necessarily induced (edge subsets) follows from degrees, supports,
+// triangle counts, 4-cycle counts and 4-clique counts, e.g., a vertex v is
+// the center of C(deg(v), 3) stars and the degree-3 vertex of
+// t(v) (deg(v) - 2) tailed triangles. A subset inducing graphlet H contains a
+// fixed number of copies of every graphlet with fewer edges (kOverlap4 and
+// kOrbitOverlap below), so the induced counts follow by back substitution,
+// from the 4-clique down. The disconnected graphlets are counted the same
+// way from combinatorial identities, e.g., there are C(m, 2) - sum_v
+// C(deg(v), 2) pairs of disjoint edges.
+//
+// The counting uses one degree ordering of the vertices: the triangles are
+// found with the degree-ordered kernels of Triangle.h (twice, since the
+// second pass needs the final supports), the 4-cliques with the hybrid
+// counting of CliqueCounting on the graph oriented by the ordering, and the
+// 4-cycles by counting, for every vertex v, the wedges v - u - w with u and w
+// before v in the ordering (every 4-cycle is found once, from its last
+// vertex, which takes O(m alpha) work). The 4-cycle pass uses a scratch
+// array of n counters per worker.
+//
+// The graphlet counts are 128-bit, since a graph with n vertices has about
+// n^4 / 24 4-vertex subsets; the per-vertex orbit counts are 64-bit.
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "benchmarks/CliqueCounting/Clique.h"
+#include "benchmarks/GraphletFeatures/GraphletFeatures.h"
+#include "benchmarks/KTruss/KTruss.h"
+#include "benchmarks/TriangleCounting/ShunTangwongsan15/Triangle.h"
+#include "gbbs/gbbs.h"
+
+namespace gbbs {
+namespace graphlet_census {
+
+using Count = __int128;
+
+constexpr size_t kNumOrbits = 15;
+using Orbits = std::array<size_t, kNumOrbits>;
+
+// The 3-vertex graphlets.
+enum Graphlet3 : size_t { kEmpty3, kEdge3, kPath3, kTriangle };
+constexpr size_t kNumGraphlets3 = 4;
+constexpr const char* kGraphlet3Names[kNumGraphlets3] = {
+    "empty", "edge", "2-path", "triangle"};
+
+// The 4-vertex graphlets, by number of edges.
+enum Graphlet4 : size_t {
+  kEmpty4,
+  kEdge4,
+  kPath3Isolated,
+  kTwoEdges,
+  kTriangleIsolated,
+  kStar,
+  kPath4,
+  kTailedTriangle,
+  kCycle4,
+  kDiamond,
+  kClique4
+};
+constexpr size_t kNumGraphlets4 = 11;
+constexpr const char* kGraphlet4Names[kNumGraphlets4] = {
+    "empty",  "edge",   "2-path + vertex", "2 edges", "triangle + vertex",
+    "3-star", "3-path", "tailed triangle", "4-cycle", "diamond",
+    "4-clique"};
+
+// kOverlap4[g][h] is the number of copies of graphlet g (as edge subsets) in
+// a set of four vertices inducing graphlet h.
+constexpr int kOverlap4[kNumGraphlets4][kNumGraphlets4] = {
+    {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1}, {0, 1, 2, 2, 3, 3, 3, 4, 4, 5, 6},
+    {0, 0, 1, 0, 3, 3, 2, 5, 4, 8, 12}, {0, 0, 0, 1, 0, 0, 1, 1, 2, 2, 3},
+    {0, 0, 0, 0, 1, 0, 0, 1, 0, 2, 4},  {0, 0, 0, 0, 0, 1, 0, 1, 0, 2, 4},
+    {0, 0, 0, 0, 0, 0, 1, 2, 4, 6, 12}, {0, 0, 0, 0, 0, 0, 0, 1, 0, 4, 12},
+    {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 3},  {0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 6},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1}};
+
+// kOrbitOverlap[o - 4][p - 4] is the number of copies of a connected
+// 4-vertex graphlet (as edge subsets) in which a vertex has orbit o, in a set
+// of four vertices inducing a graphlet in which the vertex has orbit p.
+constexpr int kOrbitOverlap[11][11] = {
+    {1, 0, 0, 0, 2, 2, 1, 0, 4, 2, 6}, {0, 1, 0, 0, 2, 0, 1, 2, 2, 4, 6},
+    {0, 0, 1, 0, 0, 1, 1, 0, 2, 1, 3}, {0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1},
+    {0, 0, 0, 0, 1, 0, 0, 0, 1, 1, 3}, {0, 0, 0, 0, 0, 1, 0, 0, 2, 0, 3},
+    {0, 0, 0, 0, 0, 0, 1, 0, 2, 2, 6}, {0, 0, 0, 0, 0, 0, 0, 1, 0, 2, 3},
+    {0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 3}, {0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 3},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1}};
+
+struct Census {
+  std::array<Count, kNumGraphlets3> graphlets3;
+  std::array<Count, kNumGraphlets4> graphlets4;
+  sequence<Orbits> orbits;
+};
+
+inline std::string ToString(Count x) {
+  if (x == 0) return "0";
+  bool negative = x < 0;
+  std::string digits;
+  for (; x != 0; x /= 10) {
+    int digit = static_cast<int>(x % 10);
+    digits.push_back('0' + (negative ? -digit : digit));
+  }
+  if (negative) digits.push_back('-');
+  return std::string(digits.rbegin(), digits.rend());
+}
+
+inline Count Choose(Count n, size_t k) {
+  Count result = 1;
+  for (size_t i = 0; i < k; i++) {
+    if (n - static_cast<Count>(i) <= 0) return 0;
+    result = result * (n - i) / (i + 1);
+  }
+  return result;
+}
+
+// Returns the number of 4-cycles containing every vertex. A 4-cycle is found
+// from its last vertex v in the ordering and the opposite vertex w, as a pair
+// of wedges v - u - w with u and w before v.
+inline sequence<size_t> VertexFourCycles(const ktruss::EdgeIndex& edges,
+                                         const sequence<uintE>& rank) {
+  const size_t n = edges.n;
+  auto cycles = sequence<size_t>(n, 0);
+  using Wedges = graphlet_features::SparseCounters<size_t>;
+  auto init_wedges = [&](Wedges* wedges) { wedges->alloc(n); };
+  auto finish_wedges = [&](Wedges* wedges) {
+    if (wedges != nullptr) {
+      delete wedges;
+    }
+  };
+  parallel_for_alloc<Wedges>(
+      init_wedges, finish_wedges, 0, n, [&](size_t v, Wedges* wedges) {
+        auto& count = wedges->counts;
+        const auto& reached = wedges->touched;
+
+        // Calls f(w) for the endpoints w of the wedges v - u - w.
+        auto map_wedges = [&](uintE u, auto f) {
+          for (size_t j = edges.offsets[u]; j < edges.offsets[u + 1]; j++) {
+            uintE w = edges.nghs[j];
+            if (rank[w] < rank[v]) f(w);
+          }
+        };
+        for (size_t i = edges.offsets[v]; i < edges.offsets[v + 1]; i++) {
+          uintE u = edges.nghs[i];
+          if (rank[u] >= rank[v]) continue;
+          map_wedges(u, [&](uintE w) { wedges->increment(w); });
+        }
+
+        size_t total = 0;
+        for (uintE w : reached) {
+          size_t pairs = count[w] * (count[w] - 1) / 2;
+          if (pairs > 0) {
+            total += pairs;
+            gbbs::write_add(&cycles[w], pairs);
+          }
+        }
+        if (total > 0) {
+          gbbs::write_add(&cycles[v], total);
+          // The middle vertex u of a wedge to w is in count[w] - 1 of the
+          // cycles.
+          for (size_t i = edges.offsets[v]; i < edges.offsets[v + 1]; i++) {
+            uintE u = edges.nghs[i];
+            if (rank[u] >= rank[v]) continue;
+            size_t middle = 0;
+            map_wedges(u, [&](uintE w) { middle += count[w] - 1; });
+            if (middle > 0) gbbs::write_add(&cycles[u], middle);
+          }
+        }
+
+        wedges->reset();
+      },
+      1, false);
+  return cycles;
+}
+
+}  // namespace graphlet_census
+
+// Computes the 3- and 4-vertex graphlet counts and the orbit counts of every
+// vertex of the symmetric graph G.
+template <class Graph>
+inline graphlet_census::Census GraphletCensus(Graph& G) {
+  using graphlet_census::Count;
+  const size_t n = G.n;
+  timer t;
+  t.start();
+  auto edges = ktruss::EdgeIndex(G);
+  const size_t m = edges.m;
+
+  sequence<uintE> support;
+  auto triangles = graphlet_features::VertexTriangles(G, &edges, &support);
+  // apex[v] is the sum over the triangles {v, a, b} of s({a, b}) - 1, the
+  // number of diamonds in which v has degree 2.
+  auto apex = sequence<size_t>(n, 0);
+  auto apex_f = [&](uintE u, uintE v, uintE w) {
+    gbbs::write_add(&apex[u], size_t{support[edges.edge_id(v, w)]} - 1);
+    gbbs::write_add(&apex[v], size_t{support[edges.edge_id(u, w)]} - 1);
+    gbbs::write_add(&apex[w], size_t{support[edges.edge_id(u, v)]} - 1);
+  };
+  Triangle_degree_ordering(G, apex_f);
+  gbbs_debug(t.next("triangle time"););
+
+  auto rank = degreeOrderNodes(G, n);
+  auto cliques =
+      graphlet_features::VertexCliques(G, 4, rank, nullptr, nullptr);
+  gbbs_debug(t.next("4-clique time"););
+  auto cycles = graphlet_census::VertexFourCycles(edges, rank);
+  gbbs_debug(t.next("4-cycle time"););
+
+  auto degree = [&](uintE v) -> int64_t { return edges.degree(v); };
+  // paths[a] is the number of 2-paths starting at a neighbor of a.
+  auto paths = sequence<int64_t>::from_function(n, [&](size_t a) {
+    int64_t total = 0;
+    for (size_t i = edges.offsets[a]; i < edges.offsets[a + 1]; i++) {
+      total += degree(edges.nghs[i]) - 1;
+    }
+    return total;
+  });
+
+  graphlet_census::Census census;
+  census.orbits = sequence<graphlet_census::Orbits>::uninitialized(n);
+  parallel_for(0, n, 1, [&](size_t v) {
+    int64_t d = degree(v);
+    int64_t tri = triangles[v];
+    // The copies of the graphlets of every orbit that are not necessarily
+    // induced.
+    std::array<int64_t, graphlet_census::kNumOrbits> copies = {};
+    int64_t ngh_paths = 0;
+    for (size_t i = edges.offsets[v]; i < edges.offsets[v + 1]; i++) {
+      uintE a = edges.nghs[i];
+      int64_t da = degree(a);
+      int64_t s = support[edges.slot_ids[i]];
+      ngh_paths += da - 1;
+      copies[4] += paths[a] - (d - 1);
+      copies[6] += (da - 1) * (da - 2) / 2;
+      copies[9] += static_cast<int64_t>(triangles[a]) - s;
+      copies[10] += s * (da - 2);
+      copies[13] += s * (s - 1) / 2;
+    }
+    copies[4] -= 2 * tri;
+    copies[5] = (d - 1) * ngh_paths - 2 * tri;
+    // d (d - 1) (d - 2) overflows 64 bits long before C(d, 3) does.
+    copies[7] = static_cast<int64_t>(graphlet_census::Choose(d, 3));
+    copies[8] = cycles[v];
+    copies[11] = tri * (d - 2);
+    copies[12] = apex[v];
+    copies[14] = cliques[v];
+
+    auto& orbits = census.orbits[v];
+    orbits[0] = d;
+    orbits[1] = ngh_paths - 2 * tri;
+    orbits[2] = static_cast<int64_t>(graphlet_census::Choose(d, 2)) - tri;
+    orbits[3] = tri;
+    for (size_t o = graphlet_census::kNumOrbits; o-- > 4;) {
+      int64_t induced = copies[o];
+      for (size_t p = o + 1; p < graphlet_census::kNumOrbits; p++) {
+        induced -= graphlet_census::kOrbitOverlap[o - 4][p - 4] *
+                   static_cast<int64_t>(orbits[p]);
+      }
+      orbits[o] = induced;
+    }
+  });
+  gbbs_debug(t.next("orbit time"););
+
+  auto orbit_sum = [&](size_t o) {
+    return parlay::reduce(parlay::delayed_seq<Count>(
+        n, [&](size_t v) { return Count{census.orbits[v][o]}; }));
+  };
+  Count N = n, M = m;
+  Count T = orbit_sum(3) / 3;
+  Count wedges = parlay::reduce(parlay::delayed_seq<Count>(
+      n, [&](size_t v) { return graphlet_census::Choose(degree(v), 2); }));
+
+  auto& g3 = census.graphlets3;
+  g3[graphlet_census::kTriangle] = T;
+  g3[graphlet_census::kPath3] = orbit_sum(2);
+  g3[graphlet_census::kEdge3] =
+      (N < 3) ? 0 : M * (N - 2) - 2 * g3[graphlet_census::kPath3] - 3 * T;
+  g3[graphlet_census::kEmpty3] = graphlet_census::Choose(N, 3) -
+                                 g3[graphlet_census::kEdge3] -
+                                 g3[graphlet_census::kPath3] - T;
+
+  // The connected graphlets follow from the orbits, and the disconnected
+  // ones by back substitution from the number of their copies.
+  auto& g4 = census.graphlets4;
+  g4[graphlet_census::kStar] = orbit_sum(7);
+  g4[graphlet_census::kPath4] = orbit_sum(4) / 2;
+  g4[graphlet_census::kTailedTriangle] = orbit_sum(11);
+  g4[graphlet_census::kCycle4] = orbit_sum(8) / 4;
+  g4[graphlet_census::kDiamond] = orbit_sum(13) / 2;
+  g4[graphlet_census::kClique4] = orbit_sum(14) / 4;
+  Count others = (N < 3) ? 0 : N - 3;
+  std::array<Count, graphlet_census::kTriangleIsolated + 1> disconnected = {
+      graphlet_census::Choose(N, 4),
+      M * graphlet_census::Choose(N - 2, 2), wedges * others,
+      graphlet_census::Choose(M, 2) - wedges, T * others};
+  for (size_t g = graphlet_census::kTriangleIsolated + 1; g-- > 0;) {
+    Count induced = disconnected[g];
+    for (size_t h = g + 1; h < graphlet_census::kNumGraphlets4; h++) {
+      induced -= graphlet_census::kOverlap4[g][h] * g4[h];
+    }
+    g4[g] = induced;
+  }
+  gbbs_debug(t.next("census time"););
+  return census;
+}
+
+}  // namespace gbbs
@@ -0,0 +1,160 @@
+#include "benchmarks/GraphletCensus/GraphletCensus.h"
+
+#include <algorithm>
+#include <array>
+#include <set>
+#include <unordered_set>
+#include <vector>
+
+#include "gbbs/graph.h"
+#include "gbbs/helpers/undirected_edge.h"
+#include "gbbs/macros.h"
+#include "gbbs/unit_tests/graph_test_utils.h"
+#include "gtest/gtest.h"
+
+namespace gbbs {
+
+namespace {
+
+using graphlet_census::Count;
+using Adjacency = std::vector<std::set<uintE>>;
+
+struct BruteForceCensus {
+  std::array<Count, graphlet_census::kNumGraphlets3> graphlets3 = {};
+  std::array<Count, graphlet_census::kNumGraphlets4> graphlets4 = {};
+  std::vector<graphlet_census::Orbits> orbits;
+};
+
+// Classifies every subset of three and four vertices by its number of edges
+// and the degrees of its vertices.
+BruteForceCensus Census(const Adjacency& adj) {
+  const size_t n = adj.size();
+  BruteForceCensus census;
+  census.orbits.assign(n, graphlet_census::Orbits{});
+  for (size_t v = 0; v < n; v++) {
+    census.orbits[v][0] = adj[v].size();
+  }
+  auto subgraph_degrees = [&](const std::vector<size_t>& S) {
+    std::vector<size_t> degrees(S.size(), 0);
+    for (size_t i = 0; i < S.size(); i++) {
+      for (size_t j = 0; j < S.size(); j++) {
+        degrees[i] += adj[S[i]].count(S[j]);
+      }
+    }
+    return degrees;
+  };
+
+  for (size_t a = 0; a < n; a++) {
+    for (size_t b = a + 1; b < n; b++) {
+      for (size_t c = b + 1; c < n; c++) {
+        std::vector<size_t> S = {a, b, c};
+        auto degrees = subgraph_degrees(S);
+        size_t num_edges = (degrees[0] + degrees[1] + degrees[2]) / 2;
+        census.graphlets3[num_edges]++;
+        for (size_t i = 0; i < 3; i++) {
+          if (num_edges == 2) census.orbits[S[i]][degrees[i]]++;
+          if (num_edges == 3) census.orbits[S[i]][3]++;
+        }
+        for (size_t d = c + 1; d < n; d++) {
+          std::vector<size_t> S4 = {a, b, c, d};
+          auto degrees4 = subgraph_degrees(S4);
+          auto sorted = degrees4;
+          std::sort(sorted.begin(), sorted.end());
+          size_t e = (sorted[0] + sorted[1] + sorted[2] + sorted[3]) / 2;
+          size_t graphlet;
+          // orbit[k] is the orbit of a vertex of degree k, if connected.
+          std::array<size_t, 4> orbit = {0, 0, 0, 0};
+          using namespace graphlet_census;
+          if (e == 0) {
+            graphlet = kEmpty4;
+          } else if (e == 1) {
+            graphlet = kEdge4;
+          } else if (e == 2) {
+            graphlet = (sorted[0] == 0) ? kPath3Isolated : kTwoEdges;
+          } else if (e == 3 && sorted[0] == 0) {
+            graphlet = kTriangleIsolated;
+          } else if (e == 3 && sorted[3] == 3) {
+            graphlet = kStar;
+            orbit = {0, 6, 0, 7};
+          } else if (e == 3) {
+            graphlet = kPath4;
+            orbit = {0, 4, 5, 0};
+          } else if (e == 4 && sorted[3] == 3) {
+            graphlet = kTailedTriangle;
+            orbit = {0, 9, 10, 11};
+          } else if (e == 4) {
+            graphlet = kCycle4;
+            orbit = {0, 0, 8, 0};
+          } else if (e == 5) {
+            graphlet = kDiamond;
+            orbit = {0, 0, 12, 13};
+          } else {
+            graphlet = kClique4;
+            orbit = {0, 0, 0, 14};
+          }
+          census.graphlets4[graphlet]++;
+          for (size_t i = 0; i < 4; i++) {
+            if (orbit[degrees4[i]] != 0) {
+              census.orbits[S4[i]][orbit[degrees4[i]]]++;
+            }
+          }
+        }
+      }
+    }
+  }
+  return census;
+}
+
+void CheckCensus(size_t n, const std::unordered_set<UndirectedEdge>& edges) {
+  auto adj = graph_test::MakeAdjacencySets(n, edges);
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(n, edges);
+  auto census = GraphletCensus(graph);
+  auto expected = Census(adj);
+  for (size_t g = 0; g < graphlet_census::kNumGraphlets3; g++) {
+    EXPECT_EQ(graphlet_census::ToString(census.graphlets3[g]),
+              graphlet_census::ToString(expected.graphlets3[g]))
+        << graphlet_census::kGraphlet3Names[g];
+  }
+  for (size_t g = 0; g < graphlet_census::kNumGraphlets4; g++) {
+    EXPECT_EQ(graphlet_census::ToString(census.graphlets4[g]),
+              graphlet_census::ToString(expected.graphlets4[g]))
+        << graphlet_census::kGraphlet4Names[g];
+  }
+  for (size_t v = 0; v < n; v++) {
+    for (size_t o = 0; o < graphlet_census::kNumOrbits; o++) {
+      EXPECT_EQ(census.orbits[v][o], expected.orbits[v][o])
+          << "vertex " << v << " orbit " << o;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(GraphletCensus, Diamond) {
+  // A 4-cycle 0 - 1 - 2 - 3 with the chord {0, 2}, and an isolated vertex.
+  const std::unordered_set<UndirectedEdge> edges{
+      {0, 1}, {1, 2}, {2, 3}, {3, 0}, {0, 2}};
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(5, edges);
+  auto census = GraphletCensus(graph);
+  EXPECT_EQ(graphlet_census::ToString(
+                census.graphlets4[graphlet_census::kDiamond]),
+            "1");
+  EXPECT_EQ(graphlet_census::ToString(
+                census.graphlets4[graphlet_census::kTriangleIsolated]),
+            "2");
+  EXPECT_EQ(census.orbits[0][13], 1);
+  EXPECT_EQ(census.orbits[1][12], 1);
+  EXPECT_EQ(census.orbits[4][0], 0);
+  CheckCensus(5, edges);
+}
+
+TEST(GraphletCensus, MatchesBruteForce) {
+  // Pseudo-random graphs on 15 vertices with edge densities of about 1/4,
+  // 1/2 and 3/4.
+  constexpr uintE n = 15;
+  for (double p : {0.25, 0.5, 0.75}) {
+    CheckCensus(n, graph_test::RandomUndirectedEdges(n, p, /*seed=*/2024));
+  }
+}
+
+}  // namespace gbbs
@@ -0,0 +1,72 @@
+// Usage:
+// numactl -i all ./GraphletFeatures -s -k 5 -cycles -edges -out features.bin
+//     com-orkut.ungraph.txt_SJ
+// flags:
+//   required:
+//     -s : indicates that the graph is symmetric
+//   optional:
+//     -m : indicate that the graph should be mmap'd
+//     -c : indicate that the graph is compressed
+//     -rounds : the number of times to run the algorithm
+//     -k : count the k-cliques through every vertex for k = 4, ..., K (the
+//          default is 4; use 3 to only count triangles)
+//     -cycles : count the 5-cycles through every vertex
+//     -edges : also compute per-edge triangle and clique counts
+//     -o : the orientation used for clique counting (see get_ordering in
+//          Clique.h)
+//     -e : the epsilon of the orientation
+//     -out : write the features to this binary file
+
+#include "GraphletFeatures.h"
+
+namespace gbbs {
+template <class Graph>
+double GraphletFeatures_runner(Graph& G, commandLine P) {
+  graphlet_features::Options options;
+  size_t max_k = P.getOptionLongValue("-k", 4);
+  options.clique_sizes.clear();
+  for (size_t k = 4; k <= max_k; k++) options.clique_sizes.push_back(k);
+  options.five_cycles = P.getOption("-cycles");
+  options.per_edge = P.getOption("-edges");
+  options.order_type = P.getOptionLongValue("-o", 0);
+  options.epsilon = P.getOptionDoubleValue("-e", 0.1);
+  std::string out = P.getOptionValue("-out", "");
+  std::cout << "### Application: GraphletFeatures" << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -k = " << max_k
+            << " -cycles = " << options.five_cycles
+            << " -edges = " << options.per_edge << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+  assert(P.getOption("-s"));
+
+  timer t;
+  t.start();
+  auto features = GraphletFeatures(G, options);
+  double tt = t.stop();
+
+  size_t triangles = parlay::reduce(features.triangles) / 3;
+  std::cout << "### Num triangles = " << triangles << std::endl;
+  for (const auto& [k, counts] : features.cliques) {
+    std::cout << "### Num " << k << " cliques = " << parlay::reduce(counts) / k
+              << std::endl;
+  }
+  if (options.five_cycles) {
+    std::cout << "### Num 5-cycles = "
+              << parlay::reduce(features.five_cycles) / 5 << std::endl;
+  }
+  if (!out.empty()) {
+    timer wt;
+    wt.start();
+    graphlet_features::WriteGraphletFeatures(features, out);
+    std::cout << "### Write Time: " << wt.stop() << std::endl;
+  }
+
+  std::cout << "### Running Time: " << tt << std::endl;
+  return tt;
+}
+}  // namespace gbbs
+
+generate_symmetric_main(gbbs::GraphletFeatures_runner, false);
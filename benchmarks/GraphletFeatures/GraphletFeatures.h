@@ -0,0 +1,376 @@
+// Per-vertex and per-edge graphlet counts, for use as features of vertices
+// and edges (e.g., in machine learning pipelines).
+//
+// GraphletFeatures returns dense arrays with, for every vertex v of a
+// symmetric graph,
+//   - the number of triangles containing v, and the local clustering
+//     coefficient of v, 2 t(v) / (deg(v) (deg(v) - 1)), which is filled in
+//     as soon as the triangle counts are known;
+//   - the number of k-cliques containing v, for every requested k >= 4;
+//   - optionally, the number of 5-cycles containing v.
+// Optionally, it also returns the number of triangles and k-cliques
+// containing every edge, indexed by the edge ids of ktruss::EdgeIndex (the
+// edges {u, v} with u < v, numbered in order of u and then of v).
+//
+// Triangles are counted with the degree-ordered counting in Triangle.h (per
+// edge, with ktruss::EdgeSupport). Per-vertex k-cliques are counted on a
+// degeneracy-style orientation of the graph with the hybrid counting of
+// CliqueCounting, which aggregates the counts of every vertex within each
+// recursive call; per-edge k-cliques have to enumerate the cliques and cost
+// O(k^2 log(deg)) per clique.
+//
+// The 5-cycles through v are computed from the closed walks of length 5 from
+// v. Such a walk that is not a 5-cycle traverses a triangle and one edge
+// twice, so with w(x) the number of walks of length 2 from v to x and t(x)
+// the number of triangles containing x,
+//
+//   c5(v) = (A^5)_vv / 2 + 5 t(v) - 2 t(v) deg(v)
+//           - sum_{x in N(v)} (t(x) + w(x) deg(x)),
+//
+// where (A^5)_vv = sum_{x} w(x) sum_{y in N(x)} w(y). The work for v is
+// proportional to the number of edges within two hops of v, so this is meant
+// for sparse graphs. Every worker uses a scratch array of n counters.
+//
+// WriteGraphletFeatures streams the arrays to a binary file (see its comment
+// for the format).
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmarks/CliqueCounting/Clique.h"
+#include "benchmarks/KTruss/KTruss.h"
+#include "benchmarks/TriangleCounting/ShunTangwongsan15/Triangle.h"
+#include "gbbs/gbbs.h"
+#include "gbbs/helpers/assert.h"
+
+namespace gbbs {
+namespace graphlet_features {
+
+struct Options {
+  // The clique sizes (at least 4) to count.
+  std::vector<size_t> clique_sizes = {4};
+  // Whether to count the 5-cycles through every vertex.
+  bool five_cycles = false;
+  // Whether to also return per-edge triangle and clique counts.
+  bool per_edge = false;
+  // The orientation used for clique counting (see get_ordering in Clique.h)
+  // and its epsilon.
+  long order_type = 0;
+  double epsilon = 0.1;
+};
+
+struct Features {
+  size_t n;
+  // Per-vertex features.
+  sequence<size_t> triangles;
+  sequence<double> clustering;
+  // (k, number of k-cliques containing each vertex).
+  std::vector<std::pair<size_t, sequence<size_t>>> cliques;
+  // Empty unless five_cycles is set.
+  sequence<size_t> five_cycles;
+
+  // Per-edge features; edges is empty unless per_edge is set.
+  std::optional<ktruss::EdgeIndex> edges;
+  sequence<uintE> edge_triangles;
+  std::vector<std::pair<size_t, sequence<size_t>>> edge_cliques;
+};
+
+// Returns the number of triangles containing every vertex, and the number of
+// triangles containing every edge if edges is given.
+template <class Graph>
+inline sequence<size_t> VertexTriangles(Graph& G,
+                                        const ktruss::EdgeIndex* edges,
+                                        sequence<uintE>* edge_triangles) {
+  const size_t n = G.n;
+  if (edges == nullptr) {
+    auto triangles = sequence<size_t>(n, 0);
+    auto f = [&](uintE u, uintE v, uintE w) {
+      gbbs::write_add(&triangles[u], size_t{1});
+      gbbs::write_add(&triangles[v], size_t{1});
+      gbbs::write_add(&triangles[w], size_t{1});
+    };
+    Triangle_degree_ordering(G, f);
+    return triangles;
+  }
+  // Every triangle containing v contains two edges incident to v.
+  *edge_triangles = ktruss::EdgeSupport(G, *edges);
+  return sequence<size_t>::from_function(n, [&](size_t v) {
+    size_t total = 0;
+    for (size_t i = edges->offsets[v]; i < edges->offsets[v + 1]; i++) {
+      total += (*edge_triangles)[edges->slot_ids[i]];
+    }
+    return total / 2;
+  });
+}
+
+// Returns the number of k-cliques (k >= 4) containing every vertex, and adds
+// the number of k-cliques containing every edge to edge_counts if edges is
+// given.
+template <class Graph>
+inline sequence<size_t> VertexCliques(Graph& G, size_t k,
+                                      const sequence<uintE>& rank,
+                                      const ktruss::EdgeIndex* edges,
+                                      sequence<size_t>* edge_counts) {
+  using W = typename Graph::weight_type;
+  if (k < 4) ABORT("clique sizes must be at least 4: " << k);
+  auto pack_predicate = [&](const uintE& u, const uintE& v, const W& wgh) {
+    return (rank[u] < rank[v]) && G.get_vertex(u).out_degree() >= k - 1 &&
+           G.get_vertex(v).out_degree() >= k - 1;
+  };
+  auto DG = filterGraph(G, pack_predicate);
+
+  auto counts = sequence<size_t>(G.n, 0);
+  if (edges == nullptr) {
+    auto base_f = [&](uintE v, size_t count) {
+      gbbs::write_add(&counts[v], count);
+    };
+    induced_hybrid::CountCliques(DG, k - 1, base_f, /*use_base=*/true);
+    return counts;
+  }
+  *edge_counts = sequence<size_t>(edges->m, 0);
+  auto enum_f = [&](const sequence<uintE>& clique) {
+    for (size_t i = 0; i < k; i++) {
+      gbbs::write_add(&counts[clique[i]], size_t{1});
+      for (size_t j = i + 1; j < k; j++) {
+        gbbs::write_add(&(*edge_counts)[edges->edge_id(clique[i], clique[j])],
+                        size_t{1});
+      }
+    }
+  };
+  induced_hybrid::CountCliquesEnum(DG, k - 1, enum_f);
+  return counts;
+}
+
+// A counter for every vertex, all zero between uses, and the vertices whose
+// counter is non-zero.
+template <class T>
+struct SparseCounters {
+  sequence<T> counts;
+  std::vector<uintE> touched;
+
+  void alloc(size_t n) {
+    if (counts.size() < n) counts = sequence<T>(n, 0);
+  }
+
+  void increment(uintE v) {
+    if (counts[v]++ == 0) touched.push_back(v);
+  }
+
+  void reset() {
+    for (uintE v : touched) counts[v] = 0;
+    touched.clear();
+  }
+};
+
+// Returns the number of 5-cycles containing every vertex, given the number of
+// triangles containing every vertex.
+template <class Graph>
+inline sequence<size_t> VertexFiveCycles(Graph& G,
+                                         const sequence<size_t>& triangles) {
+  const size_t n = G.n;
+  auto degree = [&](uintE v) -> int64_t {
+    return G.get_vertex(v).out_degree();
+  };
+  auto five_cycles = sequence<size_t>::uninitialized(n);
+  auto init_walks = [&](SparseCounters<int64_t>* walks) { walks->alloc(n); };
+  auto finish_walks = [&](SparseCounters<int64_t>* walks) {
+    if (walks != nullptr) {
+      delete walks;
+    }
+  };
+  parallel_for_alloc<SparseCounters<int64_t>>(
+      init_walks, finish_walks, 0, n,
+      [&](size_t v, SparseCounters<int64_t>* walks) {
+        auto& w = walks->counts;
+        const auto& reached = walks->touched;
+
+        int64_t correction = 0;
+        auto walk_f = [&](const uintE& src, const uintE& x, const auto& wgh) {
+          auto inc_f = [&](const uintE& x2, const uintE& y, const auto& wgh2) {
+            walks->increment(y);
+          };
+          G.get_vertex(x).out_neighbors().map(inc_f, /*parallel=*/false);
+          correction += triangles[x];
+        };
+        G.get_vertex(v).out_neighbors().map(walk_f, /*parallel=*/false);
+
+        int64_t closed_walks = 0;
+        for (uintE x : reached) {
+          int64_t adjacent = 0;
+          auto sum_f = [&](const uintE& x2, const uintE& y, const auto& wgh) {
+            adjacent += w[y];
+          };
+          G.get_vertex(x).out_neighbors().map(sum_f, /*parallel=*/false);
+          closed_walks += w[x] * adjacent;
+        }
+        auto corr_f = [&](const uintE& src, const uintE& x, const auto& wgh) {
+          correction += w[x] * degree(x);
+        };
+        G.get_vertex(v).out_neighbors().map(corr_f, /*parallel=*/false);
+
+        walks->reset();
+
+        int64_t t = triangles[v];
+        int64_t doubled =
+            closed_walks + 2 * (5 * t - 2 * t * degree(v) - correction);
+        five_cycles[v] = static_cast<size_t>(doubled / 2);
+      },
+      1, false);
+  return five_cycles;
+}
+
+}  // namespace graphlet_features
+
+// Computes the graphlet features of the symmetric graph G.
+template <class Graph>
+inline graphlet_features::Features GraphletFeatures(
+    Graph& G, const graphlet_features::Options& options = {}) {
+  const size_t n = G.n;
+  timer t;
+  t.start();
+  graphlet_features::Features features;
+  features.n = n;
+  if (options.per_edge) {
+    features.edges.emplace(G);
+  }
+  const ktruss::EdgeIndex* edges =
+      options.per_edge ? &(*features.edges) : nullptr;
+
+  features.triangles = graphlet_features::VertexTriangles(
+      G, edges, &features.edge_triangles);
+  features.clustering = sequence<double>::from_function(n, [&](size_t v) {
+    double d = G.get_vertex(v).out_degree();
+    return (d < 2) ? 0.0 : 2.0 * features.triangles[v] / (d * (d - 1));
+  });
+  gbbs_debug(t.next("triangle time"););
+
+  if (!options.clique_sizes.empty()) {
+    auto rank = get_ordering(G, options.order_type, options.epsilon);
+    for (size_t k : options.clique_sizes) {
+      sequence<size_t> edge_counts;
+      auto counts = graphlet_features::VertexCliques(G, k, rank, edges,
+                                                     &edge_counts);
+      features.cliques.emplace_back(k, std::move(counts));
+      if (options.per_edge) {
+        features.edge_cliques.emplace_back(k, std::move(edge_counts));
+      }
+    }
+    gbbs_debug(t.next("clique time"););
+  }
+
+  if (options.five_cycles) {
+    features.five_cycles =
+        graphlet_features::VertexFiveCycles(G, features.triangles);
+    gbbs_debug(t.next("5-cycle time"););
+  }
+  return features;
+}
+
+namespace graphlet_features {
+
+// Writes the features to a binary file, in host byte order:
+//
+//   char[8]  magic "GBBSGLF1"
+//   uint64   n, the number of vertices
+//   uint64   m, the number of edges (0 without per-edge features)
+//   uint64   the number of columns
+//   per column: uint64 kind (0 = vertex, 1 = edge), uint64 type (0 = uint64,
+//               1 = float64), uint64 name length, and the name
+//   per column: its n (or m) values of 8 bytes each
+//
+// The vertex columns are "triangles", "clustering", "cliques_<k>" and
+// "five_cycles". If there are per-edge features, the edge columns start with
+// the endpoints "src" < "dst" of every edge, followed by "triangles" and
+// "cliques_<k>". The columns are converted and written a block at a time.
+inline void WriteGraphletFeatures(const Features& features,
+                                  const std::string& filename) {
+  std::ofstream file(filename, std::ios::out | std::ios::binary);
+  if (!file.is_open()) {
+    ABORT("Unable to open file: " << filename);
+  }
+  const size_t n = features.n;
+  const size_t m = features.edges ? features.edges->m : 0;
+
+  struct Column {
+    uint64_t kind;
+    uint64_t type;
+    std::string name;
+    // Returns the i-th value, as the bits of a uint64 or double.
+    std::function<uint64_t(size_t)> value;
+  };
+  auto counts = [](const auto& s) {
+    return [p = &s](size_t i) { return static_cast<uint64_t>((*p)[i]); };
+  };
+  std::vector<Column> columns;
+  columns.push_back({0, 0, "triangles", counts(features.triangles)});
+  columns.push_back({0, 1, "clustering", [&](size_t i) {
+                       uint64_t bits;
+                       std::memcpy(&bits, &features.clustering[i], 8);
+                       return bits;
+                     }});
+  for (const auto& [k, c] : features.cliques) {
+    columns.push_back({0, 0, "cliques_" + std::to_string(k), counts(c)});
+  }
+  if (!features.five_cycles.empty()) {
+    columns.push_back({0, 0, "five_cycles", counts(features.five_cycles)});
+  }
+  sequence<uintE> src, dst;
+  if (features.edges) {
+    const auto& edges = *features.edges;
+    src = sequence<uintE>::uninitialized(m);
+    dst = sequence<uintE>::uninitialized(m);
+    parallel_for(0, n, 1, [&](size_t u) {
+      for (size_t i = edges.upper_starts[u]; i < edges.offsets[u + 1]; i++) {
+        size_t e = edges.upper_offsets[u] + (i - edges.upper_starts[u]);
+        src[e] = u;
+        dst[e] = edges.nghs[i];
+      }
+    });
+    columns.push_back({1, 0, "src", counts(src)});
+    columns.push_back({1, 0, "dst", counts(dst)});
+    columns.push_back({1, 0, "triangles", counts(features.edge_triangles)});
+    for (const auto& [k, c] : features.edge_cliques) {
+      columns.push_back({1, 0, "cliques_" + std::to_string(k), counts(c)});
+    }
+  }
+
+  auto write_u64 = [&](uint64_t x) {
+    file.write(reinterpret_cast<const char*>(&x), sizeof(x));
+  };
+  file.write("GBBSGLF1", 8);
+  write_u64(n);
+  write_u64(m);
+  write_u64(columns.size());
+  for (const auto& c : columns) {
+    write_u64(c.kind);
+    write_u64(c.type);
+    write_u64(c.name.size());
+    file.write(c.name.data(), c.name.size());
+  }
+  constexpr size_t kBlockSize = 1 << 16;
+  auto block = sequence<uint64_t>::uninitialized(kBlockSize);
+  for (const auto& c : columns) {
+    size_t size = (c.kind == 0) ? n : m;
+    for (size_t start = 0; start < size; start += kBlockSize) {
+      size_t end = std::min(start + kBlockSize, size);
+      parallel_for(0, end - start, kDefaultGranularity,
+                   [&](size_t i) { block[i] = c.value(start + i); });
+      file.write(reinterpret_cast<const char*>(block.begin()),
+                 (end - start) * sizeof(uint64_t));
+    }
+  }
+  if (!file) {
+    ABORT("Error writing file: " << filename);
+  }
+}
+
+}  // namespace graphlet_features
+}  // namespace gbbs
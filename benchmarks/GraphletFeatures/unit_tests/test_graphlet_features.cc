@@ -0,0 +1,199 @@
+#include "benchmarks/GraphletFeatures/GraphletFeatures.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <set>
+#include <unordered_set>
+#include <vector>
+
+#include "gbbs/graph.h"
+#include "gbbs/helpers/undirected_edge.h"
+#include "gbbs/macros.h"
+#include "gbbs/unit_tests/graph_test_utils.h"
+#include "gtest/gtest.h"
+
+namespace gbbs {
+
+namespace {
+
+using Adjacency = std::vector<std::set<uintE>>;
+
+// Calls f(clique) for every k-clique, as a sorted vector of vertices.
+template <class F>
+void ForEachClique(const Adjacency& adj, size_t k, std::vector<uintE>& clique,
+                   F f) {
+  if (clique.size() == k) {
+    f(clique);
+    return;
+  }
+  uintE start = clique.empty() ? 0 : clique.back() + 1;
+  for (uintE v = start; v < adj.size(); v++) {
+    bool adjacent_to_all = true;
+    for (uintE u : clique) adjacent_to_all &= (adj[u].count(v) > 0);
+    if (adjacent_to_all) {
+      clique.push_back(v);
+      ForEachClique(adj, k, clique, f);
+      clique.pop_back();
+    }
+  }
+}
+
+// Returns the number of 5-cycles through every vertex by extending the paths
+// that start at the smallest vertex of the cycle.
+std::vector<size_t> BruteForceFiveCycles(const Adjacency& adj) {
+  std::vector<size_t> counts(adj.size(), 0);
+  std::vector<uintE> path;
+  std::function<void()> extend = [&]() {
+    if (path.size() == 5) {
+      // Every cycle is found in both directions; keep one of them.
+      if (adj[path[4]].count(path[0]) > 0 && path[1] < path[4]) {
+        for (uintE v : path) counts[v]++;
+      }
+      return;
+    }
+    for (uintE v : adj[path.back()]) {
+      if (v > path[0] &&
+          std::find(path.begin(), path.end(), v) == path.end()) {
+        path.push_back(v);
+        extend();
+        path.pop_back();
+      }
+    }
+  };
+  for (uintE v = 0; v < adj.size(); v++) {
+    path = {v};
+    extend();
+  }
+  return counts;
+}
+
+}  // namespace
+
+TEST(GraphletFeatures, MatchesBruteForce) {
+  // A pseudo-random graph on 14 vertices with edge density about 1/2.
+  constexpr uintE n = 14;
+  auto edges = graph_test::RandomUndirectedEdges(n, 0.5, /*seed=*/12345);
+  Adjacency adj = graph_test::MakeAdjacencySets(n, edges);
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(n, edges);
+
+  graphlet_features::Options options;
+  options.clique_sizes = {4, 5};
+  options.five_cycles = true;
+  options.per_edge = true;
+  auto features = GraphletFeatures(graph, options);
+  ASSERT_TRUE(features.edges.has_value());
+  const auto& index = *features.edges;
+  EXPECT_EQ(index.m, edges.size());
+
+  std::vector<uintE> clique;
+  for (size_t c = 0; c < 3; c++) {
+    size_t k = c + 3;
+    std::vector<size_t> expected(n, 0);
+    std::vector<size_t> expected_edges(index.m, 0);
+    ForEachClique(adj, k, clique, [&](const std::vector<uintE>& q) {
+      for (size_t i = 0; i < k; i++) {
+        expected[q[i]]++;
+        for (size_t j = i + 1; j < k; j++) {
+          expected_edges[index.edge_id(q[i], q[j])]++;
+        }
+      }
+    });
+    for (uintE v = 0; v < n; v++) {
+      if (k == 3) {
+        EXPECT_EQ(features.triangles[v], expected[v]);
+      } else {
+        EXPECT_EQ(features.cliques[c - 1].first, k);
+        EXPECT_EQ(features.cliques[c - 1].second[v], expected[v]);
+      }
+    }
+    for (size_t e = 0; e < index.m; e++) {
+      if (k == 3) {
+        EXPECT_EQ(features.edge_triangles[e], expected_edges[e]);
+      } else {
+        EXPECT_EQ(features.edge_cliques[c - 1].second[e], expected_edges[e]);
+      }
+    }
+  }
+
+  auto five_cycles = BruteForceFiveCycles(adj);
+  for (uintE v = 0; v < n; v++) {
+    EXPECT_EQ(features.five_cycles[v], five_cycles[v]);
+    double d = adj[v].size();
+    double expected =
+        (d < 2) ? 0.0 : 2.0 * features.triangles[v] / (d * (d - 1));
+    EXPECT_DOUBLE_EQ(features.clustering[v], expected);
+  }
+
+  // The per-vertex counts do not depend on the per-edge ones.
+  options.per_edge = false;
+  auto vertex_features = GraphletFeatures(graph, options);
+  EXPECT_FALSE(vertex_features.edges.has_value());
+  for (uintE v = 0; v < n; v++) {
+    EXPECT_EQ(vertex_features.triangles[v], features.triangles[v]);
+    EXPECT_EQ(vertex_features.cliques[0].second[v],
+              features.cliques[0].second[v]);
+    EXPECT_EQ(vertex_features.cliques[1].second[v],
+              features.cliques[1].second[v]);
+  }
+}
+
+TEST(GraphletFeatures, WritesBinaryFile) {
+  // Two triangles {0, 1, 2} and {1, 2, 3} sharing the edge {1, 2}.
+  const std::unordered_set<UndirectedEdge> edges{
+      {0, 1}, {0, 2}, {1, 2}, {1, 3}, {2, 3}};
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(4, edges);
+  graphlet_features::Options options;
+  options.per_edge = true;
+  auto features = GraphletFeatures(graph, options);
+
+  std::string filename = ::testing::TempDir() + "graphlet_features.bin";
+  graphlet_features::WriteGraphletFeatures(features, filename);
+  std::ifstream file(filename, std::ios::in | std::ios::binary);
+  ASSERT_TRUE(file.is_open());
+  auto read_u64 = [&]() {
+    uint64_t x;
+    file.read(reinterpret_cast<char*>(&x), sizeof(x));
+    return x;
+  };
+  char magic[8];
+  file.read(magic, 8);
+  EXPECT_EQ(std::string(magic, 8), "GBBSGLF1");
+  EXPECT_EQ(read_u64(), 4);
+  EXPECT_EQ(read_u64(), 5);
+  // triangles, clustering, cliques_4, src, dst, triangles, cliques_4.
+  uint64_t num_columns = read_u64();
+  ASSERT_EQ(num_columns, 7);
+  std::vector<std::string> names;
+  for (size_t c = 0; c < num_columns; c++) {
+    read_u64();
+    read_u64();
+    std::string name(read_u64(), ' ');
+    file.read(&name[0], name.size());
+    names.push_back(name);
+  }
+  EXPECT_EQ(names[0], "triangles");
+  EXPECT_EQ(names[3], "src");
+  EXPECT_EQ(names[5], "triangles");
+
+  std::vector<uint64_t> triangles(4);
+  for (auto& t : triangles) t = read_u64();
+  EXPECT_EQ(triangles, (std::vector<uint64_t>{1, 2, 2, 1}));
+  std::vector<double> clustering(4);
+  for (auto& c : clustering) file.read(reinterpret_cast<char*>(&c), 8);
+  EXPECT_DOUBLE_EQ(clustering[0], 1.0);
+  EXPECT_DOUBLE_EQ(clustering[1], 2.0 / 3.0);
+  for (size_t i = 0; i < 4; i++) EXPECT_EQ(read_u64(), 0);  // 4-cliques
+  std::vector<uint64_t> src(5), dst(5), support(5);
+  for (auto& x : src) x = read_u64();
+  for (auto& x : dst) x = read_u64();
+  for (auto& x : support) x = read_u64();
+  EXPECT_EQ(src, (std::vector<uint64_t>{0, 0, 1, 1, 2}));
+  EXPECT_EQ(dst, (std::vector<uint64_t>{1, 2, 2, 3, 3}));
+  EXPECT_EQ(support, (std::vector<uint64_t>{1, 1, 2, 1, 1}));
+  file.close();
+  std::remove(filename.c_str());
+}
+
+}  // namespace gbbs
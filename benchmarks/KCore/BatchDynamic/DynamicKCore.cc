@@ -0,0 +1,83 @@
+// Usage:
+// numactl -i all ./DynamicKCore -rounds 3 -s -m com-orkut.ungraph.txt_SJ
+// flags:
+//   required:
+//     -s : indicates that the graph is symmetric
+//   optional:
+//     -m : indicate that the graph should be mmap'd
+//     -c : indicate that the graph is compressed
+//     -rounds : the number of times to run the algorithm
+//     -bs : the number of edges inserted and deleted by every batch
+//     -nbatches : the number of batches
+//     -verify : compare the maintained coreness against a recomputation
+
+#include "DynamicKCore.h"
+
+namespace gbbs {
+template <class Graph>
+double DynamicKCore_runner(Graph& G, commandLine P) {
+  size_t batch_size = P.getOptionLongValue("-bs", 10000);
+  size_t num_batches = P.getOptionLongValue("-nbatches", 10);
+  std::cout << "### Application: DynamicKCore" << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -bs (batch size) = " << batch_size
+            << " -nbatches = " << num_batches << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+  assert(P.getOption("-s"));
+  using dynamic_kcore::Edge;
+
+  timer st;
+  st.start();
+  auto engine = dynamic_kcore::DynamicKCore(G);
+  st.next("static coreness time");
+
+  // Every batch deletes edges between random vertices and their random
+  // neighbors, and inserts edges between random pairs of vertices.
+  timer t;
+  auto r = parlay::random(P.getOptionLongValue("-seed", 0));
+  for (size_t b = 0; b < num_batches; b++) {
+    auto deletions = sequence<Edge>::from_function(batch_size, [&](size_t i) {
+      uintE u = r.ith_rand(2 * i) % G.n;
+      size_t deg = engine.degree(u);
+      if (deg == 0) return Edge(u, u);
+      return Edge(u, engine.adj[u][r.ith_rand(2 * i + 1) % deg]);
+    });
+    r = r.next();
+    auto insertions = sequence<Edge>::from_function(batch_size, [&](size_t i) {
+      return Edge(r.ith_rand(2 * i) % G.n, r.ith_rand(2 * i + 1) % G.n);
+    });
+    r = r.next();
+    t.start();
+    engine.ApplyBatch(insertions, deletions);
+    t.stop();
+    std::cout << "batch " << b << ": touched = " << engine.touched
+              << " rounds = " << engine.rounds << std::endl;
+  }
+  double tt = t.total_time();
+
+  if (P.getOption("-verify")) {
+    auto edges = parlay::flatten(parlay::tabulate(G.n, [&](size_t u) {
+      auto larger =
+          parlay::filter(engine.adj[u], [&](uintE v) { return v > u; });
+      return parlay::map(larger, [&](uintE v) {
+        return std::make_tuple(static_cast<uintE>(u), v, gbbs::empty());
+      });
+    }));
+    auto H = symmetric_graph<symmetric_vertex, gbbs::empty>::from_edges(
+        edges, G.n);
+    auto cores = KCore(H);
+    size_t mismatches = parlay::count_if(
+        parlay::delayed_seq<size_t>(G.n, [](size_t v) { return v; }),
+        [&](size_t v) { return cores[v] != engine.coreness(v); });
+    std::cout << "coreness mismatches = " << mismatches << "\n";
+  }
+
+  std::cout << "### Running Time: " << tt << std::endl;
+  return tt;
+}
+}  // namespace gbbs
+
+generate_symmetric_main(gbbs::DynamicKCore_runner, false);
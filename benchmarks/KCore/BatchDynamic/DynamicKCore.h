@@ -0,0 +1,308 @@
+// A batch-dynamic k-core (coreness) engine. The engine keeps its own copy of
+// the adjacency lists of a symmetric graph and the coreness of every vertex,
+// and repairs the coreness locally after every batch of edge deletions and
+// insertions. The coreness stays queryable between batches.
+//
+// Deletions. Deleting edges only decreases coreness, so the current values
+// are upper bounds. The coreness is the largest fixed point of the h-index
+// operator, which maps a vertex to the largest h such that at least h of its
+// neighbors have value at least h, and iterating the operator from any upper
+// bound converges to it (Lu et al., "The H-index of a network node and its
+// relation to degree and coreness"). The engine applies the operator to the
+// endpoints of the deleted edges and, whenever the value of a vertex drops
+// from a to b, to the neighbors whose value is in (b, a].
+//
+// Insertions. Inserting edges only increases coreness, so the current values
+// are lower bounds. Every round raises some vertices by exactly one, as in
+// the traversal algorithm of Sariyuce et al. ("Incremental k-core
+// decomposition: algorithms and evaluation"), but for all seeds at once: from
+// every seed with value K, a search explores the connected vertices with
+// value K that have more than K neighbors with value at least K (the
+// subcore). Every explored region is then peeled, repeatedly removing the
+// vertices with at most K neighbors that are either explored and not removed
+// or have value larger than K, and the survivors are raised to K + 1. The
+// endpoints of the inserted edges are the seeds of the first round, and the
+// raised vertices are the seeds of the next one. The engine stops once a
+// round raises no vertex.
+//
+// The work of a batch is proportional to the total degree of the vertices
+// whose value changes or that are explored, not to the size of the graph.
+
+#pragma once
+
+#include <algorithm>
+#include <utility>
+
+#include "benchmarks/KCore/JulienneDBS17/KCore.h"
+#include "gbbs/gbbs.h"
+
+namespace gbbs {
+namespace dynamic_kcore {
+
+using Edge = std::pair<uintE, uintE>;
+
+struct DynamicKCore {
+  size_t n;
+  // The sorted adjacency list of every vertex.
+  sequence<sequence<uintE>> adj;
+  sequence<uintE> core;
+  // Scratch space; all false (zero) between uses.
+  sequence<bool> marked;
+  sequence<bool> visited;
+  sequence<bool> removed;
+  sequence<intE> support;
+
+  // Statistics of the last batch: the number of vertices whose coreness was
+  // re-evaluated, and the number of repair rounds.
+  size_t touched;
+  size_t rounds;
+
+  template <class Graph>
+  explicit DynamicKCore(Graph& G)
+      : n(G.n),
+        marked(G.n, false),
+        visited(G.n, false),
+        removed(G.n, false),
+        support(G.n, 0),
+        touched(0),
+        rounds(0) {
+    using W = typename Graph::weight_type;
+    adj = sequence<sequence<uintE>>::from_function(n, [&](size_t v) {
+      auto vtx = G.get_vertex(v);
+      auto ngh = sequence<uintE>::uninitialized(vtx.out_degree());
+      size_t i = 0;
+      auto map_f = [&](const uintE& u, const uintE& w, const W& wgh) {
+        ngh[i++] = w;
+      };
+      vtx.out_neighbors().map(map_f, /*parallel=*/false);
+      parlay::sort_inplace(make_slice(ngh));
+      return ngh;
+    });
+    core = KCore(G);
+  }
+
+  uintE coreness(uintE v) const { return core[v]; }
+
+  size_t degree(uintE v) const { return adj[v].size(); }
+
+  // Removes duplicates from vs using the `marked` flags.
+  sequence<uintE> dedup(const sequence<uintE>& vs) {
+    auto out = parlay::filter(vs, [&](uintE v) {
+      return !marked[v] && gbbs::atomic_compare_and_swap(&marked[v], false,
+                                                         true);
+    });
+    parallel_for(0, out.size(), kDefaultGranularity,
+                 [&](size_t i) { marked[out[i]] = false; });
+    return out;
+  }
+
+  // Returns the updates (u, v) and (v, u) for every valid edge of the batch,
+  // sorted and without duplicates.
+  sequence<Edge> directed(const sequence<Edge>& edges) {
+    auto both = sequence<Edge>::from_function(2 * edges.size(), [&](size_t i) {
+      auto [u, v] = edges[i / 2];
+      return (i % 2 == 0) ? Edge(u, v) : Edge(v, u);
+    });
+    auto valid = parlay::filter(both, [&](const Edge& e) {
+      return e.first != e.second && e.first < n && e.second < n;
+    });
+    parlay::sort_inplace(make_slice(valid));
+    return parlay::pack(
+        valid, parlay::delayed_seq<bool>(valid.size(), [&](size_t i) {
+          return i == 0 || valid[i] != valid[i - 1];
+        }));
+  }
+
+  // Replaces the adjacency list of every source u in `updates` by
+  // f(adj[u], targets), where targets are the sorted targets of u. Returns
+  // the sources.
+  template <class F>
+  sequence<uintE> update_lists(const sequence<Edge>& updates, F f) {
+    auto starts = parlay::pack_index<size_t>(
+        parlay::delayed_seq<bool>(updates.size(), [&](size_t i) {
+          return i == 0 || updates[i].first != updates[i - 1].first;
+        }));
+    parallel_for(0, starts.size(), 1, [&](size_t g) {
+      size_t start = starts[g];
+      size_t end = (g + 1 == starts.size()) ? updates.size() : starts[g + 1];
+      uintE u = updates[start].first;
+      auto targets = sequence<uintE>::from_function(
+          end - start, [&](size_t i) { return updates[start + i].second; });
+      adj[u] = f(adj[u], targets);
+    });
+    return sequence<uintE>::from_function(
+        starts.size(), [&](size_t g) { return updates[starts[g]].first; });
+  }
+
+  // The h-index of the values of the neighbors of v, capped at core[v].
+  uintE h_index(uintE v) {
+    uintE cap = core[v];
+    if (cap == 0) return 0;
+    auto counts = sequence<uintE>(cap + 1, 0);
+    for (uintE u : adj[v]) {
+      counts[std::min(core[u], cap)]++;
+    }
+    size_t at_least = 0;
+    for (uintE h = cap; h > 0; h--) {
+      at_least += counts[h];
+      if (at_least >= h) return h;
+    }
+    return 0;
+  }
+
+  // The number of neighbors of v with value at least core[v].
+  size_t core_degree(uintE v) {
+    uintE k = core[v];
+    size_t count = 0;
+    for (uintE u : adj[v]) count += (core[u] >= k);
+    return count;
+  }
+
+  void repair_deletions(sequence<uintE> worklist) {
+    worklist = dedup(worklist);
+    while (worklist.size() > 0) {
+      touched += worklist.size();
+      rounds++;
+      auto new_core = sequence<uintE>::from_function(
+          worklist.size(), [&](size_t i) { return h_index(worklist[i]); });
+      auto changed = parlay::pack_index<size_t>(parlay::delayed_seq<bool>(
+          worklist.size(),
+          [&](size_t i) { return new_core[i] < core[worklist[i]]; }));
+      auto old_core = sequence<uintE>::from_function(
+          changed.size(), [&](size_t i) { return core[worklist[changed[i]]]; });
+      parallel_for(0, changed.size(), kDefaultGranularity, [&](size_t i) {
+        core[worklist[changed[i]]] = new_core[changed[i]];
+      });
+      // Neighbors whose count of neighbors with value >= their own dropped.
+      auto affected = parlay::flatten(parlay::tabulate(
+          changed.size(), [&](size_t i) {
+            uintE v = worklist[changed[i]];
+            uintE a = old_core[i], b = core[v];
+            return parlay::filter(adj[v], [&](uintE u) {
+              return core[u] > b && core[u] <= a;
+            });
+          }));
+      worklist = dedup(affected);
+    }
+  }
+
+  void repair_insertions(sequence<uintE> seeds) {
+    while (true) {
+      // Explore the subcores of the seeds.
+      auto frontier = parlay::filter(dedup(seeds), [&](uintE v) {
+        return core_degree(v) > core[v];
+      });
+      parallel_for(0, frontier.size(), kDefaultGranularity,
+                   [&](size_t i) { visited[frontier[i]] = true; });
+      auto explored = frontier;
+      while (frontier.size() > 0) {
+        frontier = parlay::flatten(parlay::tabulate(
+            frontier.size(), [&](size_t i) {
+              uintE v = frontier[i];
+              return parlay::filter(adj[v], [&](uintE u) {
+                return core[u] == core[v] && !visited[u] &&
+                       core_degree(u) > core[u] &&
+                       gbbs::atomic_compare_and_swap(&visited[u], false, true);
+              });
+            }));
+        explored.append(frontier);
+      }
+      if (explored.size() == 0) break;
+      touched += explored.size();
+      rounds++;
+
+      // Peel the explored regions.
+      auto is_support = [&](uintE v, uintE u) {
+        return core[u] > core[v] || (core[u] == core[v] && visited[u]);
+      };
+      parallel_for(0, explored.size(), 1, [&](size_t i) {
+        uintE v = explored[i];
+        intE count = 0;
+        for (uintE u : adj[v]) count += is_support(v, u);
+        support[v] = count;
+      });
+      auto peeled = parlay::filter(explored, [&](uintE v) {
+        return support[v] <= static_cast<intE>(core[v]);
+      });
+      parallel_for(0, peeled.size(), kDefaultGranularity,
+                   [&](size_t i) { removed[peeled[i]] = true; });
+      while (peeled.size() > 0) {
+        peeled = parlay::flatten(parlay::tabulate(peeled.size(), [&](size_t i) {
+          uintE v = peeled[i];
+          return parlay::filter(adj[v], [&](uintE u) {
+            if (!visited[u] || removed[u] || core[u] != core[v]) return false;
+            intE k = core[u];
+            if (gbbs::fetch_and_add(&support[u], -1) == k + 1) {
+              removed[u] = true;
+              return true;
+            }
+            return false;
+          });
+        }));
+      }
+
+      // Raise the survivors and reset the scratch space.
+      seeds = parlay::filter(explored, [&](uintE v) { return !removed[v]; });
+      parallel_for(0, explored.size(), kDefaultGranularity, [&](size_t i) {
+        uintE v = explored[i];
+        visited[v] = false;
+        removed[v] = false;
+        support[v] = 0;
+      });
+      parallel_for(0, seeds.size(), kDefaultGranularity,
+                   [&](size_t i) { core[seeds[i]]++; });
+      gbbs_debug(std::cout << "# insertion round: explored = "
+                           << explored.size() << " raised = " << seeds.size()
+                           << std::endl;);
+      if (seeds.size() == 0) break;
+    }
+  }
+
+  // Deletes the given edges (missing edges are ignored) and repairs the
+  // coreness.
+  void DeleteEdges(const sequence<Edge>& edges) {
+    auto updates = directed(edges);
+    auto sources = update_lists(
+        updates, [](const sequence<uintE>& ngh, const sequence<uintE>& del) {
+          auto out = sequence<uintE>::uninitialized(ngh.size());
+          auto end = std::set_difference(ngh.begin(), ngh.end(), del.begin(),
+                                         del.end(), out.begin());
+          out.resize(end - out.begin());
+          return out;
+        });
+    repair_deletions(std::move(sources));
+  }
+
+  // Inserts the given edges (existing edges are ignored) and repairs the
+  // coreness.
+  void InsertEdges(const sequence<Edge>& edges) {
+    auto updates = directed(edges);
+    auto sources = update_lists(
+        updates, [](const sequence<uintE>& ngh, const sequence<uintE>& ins) {
+          auto out = sequence<uintE>::uninitialized(ngh.size() + ins.size());
+          auto end = std::set_union(ngh.begin(), ngh.end(), ins.begin(),
+                                    ins.end(), out.begin());
+          out.resize(end - out.begin());
+          return out;
+        });
+    repair_insertions(std::move(sources));
+  }
+
+  // Applies a batch of deletions followed by a batch of insertions.
+  void ApplyBatch(const sequence<Edge>& insertions,
+                  const sequence<Edge>& deletions) {
+    timer t;
+    t.start();
+    touched = 0;
+    rounds = 0;
+    DeleteEdges(deletions);
+    gbbs_debug(t.next("deletion time"););
+    InsertEdges(insertions);
+    gbbs_debug(t.next("insertion time");
+               std::cout << "# touched = " << touched << " rounds = " << rounds
+                         << std::endl;);
+  }
+};
+
+}  // namespace dynamic_kcore
+}  // namespace gbbs
@@ -0,0 +1,152 @@
+#include "benchmarks/KCore/BatchDynamic/DynamicKCore.h"
+
+#include <unordered_set>
+
+#include "benchmarks/KCore/JulienneDBS17/KCore.h"
+#include "gbbs/graph.h"
+#include "gbbs/helpers/undirected_edge.h"
+#include "gbbs/macros.h"
+#include "gbbs/unit_tests/graph_test_utils.h"
+#include "gtest/gtest.h"
+
+namespace gbbs {
+
+namespace {
+
+using dynamic_kcore::DynamicKCore;
+using dynamic_kcore::Edge;
+
+constexpr uintE kNumVertices = 60;
+
+// A cycle on 40 vertices with chords from every vertex i to i + 5, a clique
+// on vertices 40, ..., 47, a path on vertices 48, ..., 53, and isolated
+// vertices 54, ..., 59.
+std::unordered_set<UndirectedEdge> TestEdges() {
+  std::unordered_set<UndirectedEdge> edges;
+  for (uintE i = 0; i < 40; i++) {
+    edges.insert({i, (i + 1) % 40});
+    edges.insert({i, (i + 5) % 40});
+  }
+  for (uintE i = 40; i < 48; i++) {
+    for (uintE j = i + 1; j < 48; j++) {
+      edges.insert({i, j});
+    }
+  }
+  for (uintE i = 48; i < 53; i++) {
+    edges.insert({i, i + 1});
+  }
+  return edges;
+}
+
+// Checks the coreness maintained by the engine against a static computation
+// on the graph with the given edges.
+void CheckCoreness(DynamicKCore& engine,
+                   const std::unordered_set<UndirectedEdge>& edges) {
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(kNumVertices, edges);
+  auto expected = KCore(graph);
+  for (uintE v = 0; v < kNumVertices; v++) {
+    EXPECT_EQ(engine.coreness(v), expected[v]) << "vertex " << v;
+  }
+}
+
+}  // namespace
+
+TEST(DynamicKCore, Insertions) {
+  auto edges = TestEdges();
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(kNumVertices, edges);
+  auto engine = DynamicKCore(graph);
+  CheckCoreness(engine, edges);
+
+  // Connect the path and the isolated vertices to the clique, and add
+  // self-loops and duplicates, which are ignored.
+  sequence<Edge> batch = {{48, 40}, {49, 41}, {49, 42}, {54, 43},
+                          {54, 44}, {55, 55}, {48, 40}, {40, 48}};
+  engine.InsertEdges(batch);
+  for (const auto& [u, v] : batch) {
+    if (u != v) edges.insert({u, v});
+  }
+  CheckCoreness(engine, edges);
+
+  // Turning vertices 0, ..., 9 into a clique raises their coreness by more
+  // than one level in a single batch.
+  sequence<Edge> clique;
+  for (uintE i = 0; i < 10; i++) {
+    for (uintE j = i + 1; j < 10; j++) {
+      clique.push_back({i, j});
+      edges.insert({i, j});
+    }
+  }
+  engine.InsertEdges(clique);
+  CheckCoreness(engine, edges);
+  EXPECT_EQ(engine.coreness(0), uintE{9});
+}
+
+TEST(DynamicKCore, Deletions) {
+  auto edges = TestEdges();
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(kNumVertices, edges);
+  auto engine = DynamicKCore(graph);
+
+  // Remove a perfect matching from the clique, one missing edge, and break
+  // the cycle.
+  sequence<Edge> batch = {{40, 41}, {42, 43}, {44, 45}, {46, 47},
+                          {50, 59}, {0, 1},   {0, 5},   {35, 0}};
+  engine.DeleteEdges(batch);
+  for (const auto& [u, v] : batch) {
+    edges.erase({u, v});
+  }
+  CheckCoreness(engine, edges);
+  EXPECT_EQ(engine.coreness(40), uintE{6});
+  EXPECT_EQ(engine.coreness(0), uintE{1});
+
+  // Removing all edges of the clique.
+  sequence<Edge> clique;
+  for (uintE i = 40; i < 48; i++) {
+    for (uintE j = i + 1; j < 48; j++) {
+      clique.push_back({i, j});
+      edges.erase({i, j});
+    }
+  }
+  engine.DeleteEdges(clique);
+  CheckCoreness(engine, edges);
+}
+
+TEST(DynamicKCore, MixedBatches) {
+  auto edges = TestEdges();
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(kNumVertices, edges);
+  auto engine = DynamicKCore(graph);
+
+  auto r = parlay::random(7);
+  for (size_t b = 0; b < 20; b++) {
+    sequence<Edge> insertions;
+    sequence<Edge> deletions;
+    for (size_t i = 0; i < 15; i++) {
+      uintE u = r.ith_rand(4 * i) % kNumVertices;
+      uintE v = r.ith_rand(4 * i + 1) % kNumVertices;
+      if (u != v) deletions.push_back({u, v});
+      u = r.ith_rand(4 * i + 2) % kNumVertices;
+      v = r.ith_rand(4 * i + 3) % kNumVertices;
+      if (u != v) insertions.push_back({u, v});
+    }
+    r = r.next();
+    // Random pairs are rarely edges, so also delete edges of the graph.
+    size_t deleted = 0;
+    for (const auto& e : edges) {
+      if (deleted == 5) break;
+      auto [u, v] = e.endpoints();
+      if ((parlay::hash64(u * kNumVertices + v) + b) % 7 == 0) {
+        deletions.push_back({u, v});
+        deleted++;
+      }
+    }
+    engine.ApplyBatch(insertions, deletions);
+    for (const auto& [u, v] : deletions) {
+      edges.erase({u, v});
+    }
+    for (const auto& [u, v] : insertions) {
+      edges.insert({u, v});
+    }
+    CheckCoreness(engine, edges);
+  }
+}
+
+}  // namespace gbbs
@@ -0,0 +1,41 @@
+// Usage:
+// numactl -i all ./HIndexKCore -rounds 3 -s -m com-orkut.ungraph.txt_SJ
+// flags:
+//   required:
+//     -s : indicates that the graph is symmetric
+//   optional:
+//     -m : indicate that the graph should be mmap'd
+//     -c : indicate that the graph is compressed
+//     -rounds : the number of times to run the algorithm
+//     -eps : compute a (1 + eps)-approximation of the coreness (default 0,
+//            the exact coreness)
+//     -async : update the values in place instead of in synchronous rounds
+
+#include "HIndexKCore.h"
+
+namespace gbbs {
+template <class Graph>
+double HIndexKCore_runner(Graph& G, commandLine P) {
+  double epsilon = P.getOptionDoubleValue("-eps", 0.0);
+  bool asynchronous = P.getOption("-async");
+  std::cout << "### Application: HIndexKCore" << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -eps = " << epsilon
+            << " -async = " << asynchronous << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+  assert(P.getOption("-s"));
+
+  timer t;
+  t.start();
+  auto cores = HIndexKCore(G, epsilon, asynchronous);
+  double tt = t.stop();
+
+  std::cout << "### Running Time: " << tt << std::endl;
+  return tt;
+}
+}  // namespace gbbs
+
+generate_symmetric_main(gbbs::HIndexKCore_runner, false);
@@ -0,0 +1,229 @@
+// Coreness via parallel h-index iteration (Lu et al., "The H-index of a
+// network node and its relation to degree and coreness"; Sariyuce et al.,
+// "Local algorithms for hierarchical dense subgraph discovery"). Every vertex
+// starts at its degree, and a round replaces the value x(v) of every active
+// vertex by the h-index of the values of its neighbors: the largest h such
+// that at least h neighbors have value at least h. The values only decrease
+// and converge to the coreness. The rounds are not tied to the number of
+// distinct coreness values, unlike the peeling in KCore.h, and in practice
+// far fewer rounds are needed.
+//
+// Only the vertices that can change are active: a vertex is re-evaluated in
+// the next round only if the value of a neighbor dropped from a to b with
+// b < x(v) <= a, since other changes do not affect the number of neighbors
+// with value at least x(v).
+//
+// The h-index of v is computed with a counting kernel bounded by x(v): the
+// neighbor values are capped at x(v) and counted in a per-worker array with
+// one counter per allowed value up to x(v) (see below), which is then
+// scanned from the top. No neighbor values are sorted, and the work is
+// linear in the degree.
+//
+// Approximation. With epsilon > 0 the values are restricted to a geometric
+// grid 0 = g_0 < g_1 = 1 < g_2 < ... with g_{i+1} = max(g_i + 1,
+// floor((1 + epsilon) g_i)), and a round sets x(v) to the largest grid value
+// g such that at least g neighbors have value at least g. The iteration stops
+// at a fixed point of this operator, which satisfies
+//
+//   coreness(v) / (1 + epsilon) < x(v) <= coreness(v)  (x(v) = 0 iff
+//   coreness(v) = 0).
+//
+// (The vertices with value at least g induce a subgraph with minimum degree
+// at least g, so x(v) <= coreness(v); the vertices of the k-core never drop
+// below the largest grid value g <= k, so x(v) >= g > k / (1 + epsilon).)
+// Changes of a value within a grid cell are never propagated, so the
+// iteration converges in fewer rounds. epsilon = 0 computes the exact
+// coreness.
+//
+// Options:
+//  - asynchronous: values are updated in place, so a vertex already sees the
+//    new values of the neighbors evaluated before it in the same round
+//    (Gauss-Seidel instead of Jacobi rounds). The result is the same.
+
+#pragma once
+
+#include <algorithm>
+
+#include "gbbs/gbbs.h"
+
+namespace gbbs {
+namespace hindex_kcore {
+
+// The grid of allowed values up to some maximum value.
+struct Grid {
+  // The grid values in increasing order; values[0] = 0.
+  sequence<uintE> values;
+  // level[x] is the index of the largest grid value at most x.
+  sequence<uintE> level;
+
+  Grid(uintE max_value, double epsilon) {
+    values.push_back(0);
+    size_t g = 1;
+    while (g <= max_value) {
+      values.push_back(g);
+      g = std::max<size_t>(g + 1, floor((1 + epsilon) * g));
+    }
+    level = sequence<uintE>::from_function(
+        size_t{max_value} + 1, [&](size_t x) -> uintE {
+          return std::upper_bound(values.begin(), values.end(), x) -
+                 values.begin() - 1;
+        });
+  }
+
+  uintE round_down(uintE x) const { return values[level[x]]; }
+};
+
+// Marks every unmarked d whose count of neighbors with value at least x(d)
+// was affected by a change of x(s) from old_values[s] to values[s].
+struct Notify_F {
+  uintE* values;
+  uintE* old_values;
+  bool* marked;
+
+  Notify_F(uintE* values, uintE* old_values, bool* marked)
+      : values(values), old_values(old_values), marked(marked) {}
+
+  inline bool affected(const uintE& s, const uintE& d) const {
+    return values[d] > values[s] && values[d] <= old_values[s];
+  }
+
+  template <class W>
+  inline bool update(const uintE& s, const uintE& d, const W& w) {
+    if (affected(s, d)) {
+      marked[d] = true;
+      return true;
+    }
+    return false;
+  }
+
+  template <class W>
+  inline bool updateAtomic(const uintE& s, const uintE& d, const W& w) {
+    return affected(s, d) &&
+           gbbs::atomic_compare_and_swap(&marked[d], false, true);
+  }
+
+  inline bool cond(const uintE& d) const { return !marked[d]; }
+};
+
+template <class Graph>
+struct HIndexCoreness {
+  using W = typename Graph::weight_type;
+
+  Graph& G;
+  size_t n;
+  Grid grid;
+  bool asynchronous;
+  sequence<uintE> values;
+  sequence<uintE> old_values;
+  sequence<bool> marked;
+  // One array of counters per worker; all zero between uses.
+  sequence<sequence<uintE>> scratch;
+  size_t rounds;
+
+  HIndexCoreness(Graph& G, uintE max_degree, double epsilon, bool asynchronous)
+      : G(G),
+        n(G.n),
+        grid(max_degree, epsilon),
+        asynchronous(asynchronous),
+        marked(G.n, false),
+        scratch(num_workers()),
+        rounds(0) {
+    values = sequence<uintE>::from_function(n, [&](size_t v) {
+      return grid.round_down(G.get_vertex(v).out_degree());
+    });
+    old_values = values;
+  }
+
+  // The largest grid value h <= x(v) such that at least h neighbors of v
+  // have value at least h.
+  uintE h_index(uintE v) {
+    uintE cap = values[v];
+    if (cap == 0) return 0;
+    uintE top = grid.level[cap];
+    auto& counts = scratch[worker_id()];
+    if (counts.size() < size_t{top} + 1) {
+      counts.resize(size_t{top} + 1, 0);
+    }
+    auto count_f = [&](const uintE& src, const uintE& ngh, const W& wgh) {
+      counts[grid.level[std::min(values[ngh], cap)]]++;
+    };
+    G.get_vertex(v).out_neighbors().map(count_f, /*parallel=*/false);
+    uintE h = 0;
+    size_t at_least = 0;
+    for (uintE i = top; i > 0; i--) {
+      at_least += counts[i];
+      if (at_least >= grid.values[i]) {
+        h = grid.values[i];
+        break;
+      }
+    }
+    for (uintE i = 0; i <= top; i++) {
+      counts[i] = 0;
+    }
+    return h;
+  }
+
+  // Re-evaluates the active vertices and returns the ones whose value
+  // changed.
+  sequence<uintE> evaluate(const sequence<uintE>& active) {
+    if (asynchronous) {
+      parallel_for(0, active.size(), 1, [&](size_t i) {
+        uintE v = active[i];
+        old_values[v] = values[v];
+        values[v] = h_index(v);
+      });
+    } else {
+      auto new_values = sequence<uintE>::from_function(
+          active.size(), [&](size_t i) { return h_index(active[i]); });
+      parallel_for(0, active.size(), kDefaultGranularity, [&](size_t i) {
+        uintE v = active[i];
+        old_values[v] = values[v];
+        values[v] = new_values[i];
+      });
+    }
+    return parlay::filter(
+        active, [&](uintE v) { return values[v] != old_values[v]; });
+  }
+
+  void run() {
+    auto active = sequence<uintE>::from_function(n, [](size_t i) { return i; });
+    while (active.size() > 0) {
+      auto changed = evaluate(active);
+      auto F = Notify_F(values.begin(), old_values.begin(), marked.begin());
+      auto frontier = vertexSubset(n, std::move(changed));
+      auto next = edgeMap(G, frontier, F, -1);
+      next.toSparse();
+      active = std::move(next.s);
+      parallel_for(0, active.size(), kDefaultGranularity,
+                   [&](size_t i) { marked[active[i]] = false; });
+      gbbs_debug(std::cout << "# round " << rounds
+                           << ": changed = " << frontier.size()
+                           << " next = " << active.size() << std::endl;);
+      rounds++;
+    }
+  }
+};
+
+}  // namespace hindex_kcore
+
+// Returns the coreness of every vertex of the symmetric graph G, or a
+// (1 + epsilon)-approximation from below if epsilon > 0.
+template <class Graph>
+inline sequence<uintE> HIndexKCore(Graph& G, double epsilon = 0.0,
+                                   bool asynchronous = false) {
+  timer t;
+  t.start();
+  uintE max_degree = parlay::reduce_max(parlay::delayed_seq<uintE>(
+      G.n, [&](size_t v) { return G.get_vertex(v).out_degree(); }));
+  auto engine = hindex_kcore::HIndexCoreness<Graph>(G, max_degree, epsilon,
+                                                    asynchronous);
+  gbbs_debug(t.next("initialization time"););
+  engine.run();
+  gbbs_debug(t.next("iteration time"););
+  uintE k_max = (G.n == 0) ? 0 : parlay::reduce_max(engine.values);
+  std::cout << "### rounds = " << engine.rounds << " k_{max} = " << k_max
+            << "\n";
+  return std::move(engine.values);
+}
+
+}  // namespace gbbs
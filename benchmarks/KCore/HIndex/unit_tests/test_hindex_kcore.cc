@@ -0,0 +1,84 @@
+#include "benchmarks/KCore/HIndex/HIndexKCore.h"
+
+#include <unordered_set>
+
+#include "benchmarks/KCore/JulienneDBS17/KCore.h"
+#include "gbbs/graph.h"
+#include "gbbs/helpers/undirected_edge.h"
+#include "gbbs/macros.h"
+#include "gbbs/unit_tests/graph_test_utils.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using ::testing::ElementsAre;
+
+namespace gbbs {
+
+namespace {
+
+// Nested cliques: vertex i < 30 is adjacent to every vertex j < 30 with
+// |i - j| <= 1 + i / 3, plus a cycle with chords on vertices 30, ..., 69 and
+// a path on vertices 70, ..., 79.
+auto TestGraph() {
+  std::unordered_set<UndirectedEdge> edges;
+  for (uintE i = 0; i < 30; i++) {
+    for (uintE j = i + 1; j < 30 && j - i <= 1 + i / 3; j++) {
+      edges.insert({i, j});
+    }
+  }
+  for (uintE i = 0; i < 40; i++) {
+    edges.insert({30 + i, 30 + (i + 1) % 40});
+    edges.insert({30 + i, 30 + (i + 3) % 40});
+  }
+  for (uintE i = 70; i < 79; i++) {
+    edges.insert({i, i + 1});
+  }
+  return graph_test::MakeUnweightedSymmetricGraph(80, edges);
+}
+
+}  // namespace
+
+TEST(HIndexKCore, BasicUsage) {
+  // Graph diagram:
+  //     0 - 1    2 - 3 - 4
+  //                    \ |
+  //                      5 -- 6    7
+  constexpr uintE kNumVertices{8};
+  const std::unordered_set<UndirectedEdge> kEdges{
+      {0, 1}, {2, 3}, {3, 4}, {3, 5}, {4, 5}, {5, 6},
+  };
+  auto graph{graph_test::MakeUnweightedSymmetricGraph(kNumVertices, kEdges)};
+
+  EXPECT_THAT(HIndexKCore(graph), ElementsAre(1, 1, 1, 2, 2, 2, 1, 0));
+  EXPECT_THAT(HIndexKCore(graph, 0.0, /*asynchronous=*/true),
+              ElementsAre(1, 1, 1, 2, 2, 2, 1, 0));
+}
+
+TEST(HIndexKCore, MatchesPeeling) {
+  auto graph = TestGraph();
+  auto expected = KCore(graph);
+  auto synchronous = HIndexKCore(graph);
+  auto asynchronous = HIndexKCore(graph, 0.0, /*asynchronous=*/true);
+  for (uintE v = 0; v < graph.n; v++) {
+    EXPECT_EQ(synchronous[v], expected[v]) << "vertex " << v;
+    EXPECT_EQ(asynchronous[v], expected[v]) << "vertex " << v;
+  }
+}
+
+TEST(HIndexKCore, Approximation) {
+  auto graph = TestGraph();
+  auto expected = KCore(graph);
+  for (double epsilon : {0.1, 0.5, 1.0}) {
+    for (bool asynchronous : {false, true}) {
+      auto approx = HIndexKCore(graph, epsilon, asynchronous);
+      for (uintE v = 0; v < graph.n; v++) {
+        EXPECT_LE(approx[v], expected[v]) << "vertex " << v;
+        if (expected[v] > 0) {
+          EXPECT_GT(approx[v] * (1 + epsilon), expected[v]) << "vertex " << v;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace gbbs
@@ -0,0 +1,56 @@
+// Usage:
+// numactl -i all ./KTruss -rounds 3 -s -m com-orkut.ungraph.txt_SJ
+// flags:
+//   required:
+//     -s : indicates that the graph is symmetric
+//   optional:
+//     -m : indicate that the graph should be mmap'd
+//     -c : indicate that the graph is compressed
+//     -rounds : the number of times to run the algorithm
+//     -nb : the number of buckets to use in the bucketing implementation
+//     -stats : output the number of edges with each trussness
+
+#include "KTruss.h"
+
+namespace gbbs {
+template <class Graph>
+double KTruss_runner(Graph& G, commandLine P) {
+  size_t num_buckets = P.getOptionLongValue("-nb", 16);
+  std::cout << "### Application: KTruss" << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -nb (num_buckets) = " << num_buckets << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+  if (num_buckets != static_cast<size_t>((1 << parlay::log2_up(num_buckets)))) {
+    std::cout << "Number of buckets must be a power of two."
+              << "\n";
+    exit(-1);
+  }
+  assert(P.getOption("-s"));
+
+  timer t;
+  t.start();
+  auto truss = KTruss(G, num_buckets);
+  double tt = t.stop();
+  if (P.getOption("-stats")) {
+    size_t max_truss =
+        (truss.edges.m == 0) ? 2 : parlay::reduce_max(truss.trussness);
+    auto counts = sequence<size_t>(max_truss + 1, 0);
+    for (size_t e = 0; e < truss.edges.m; e++) {
+      counts[truss.trussness[e]]++;
+    }
+    for (size_t k = 2; k <= max_truss; k++) {
+      if (counts[k] > 0) {
+        std::cout << "trussness " << k << ": " << counts[k] << " edges\n";
+      }
+    }
+  }
+
+  std::cout << "### Running Time: " << tt << std::endl;
+  return tt;
+}
+}  // namespace gbbs
+
+generate_symmetric_main(gbbs::KTruss_runner, false);
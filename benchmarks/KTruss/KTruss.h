@@ -0,0 +1,246 @@
+// Parallel k-truss decomposition. The support of an edge is the number of
+// triangles containing it, and the trussness of an edge is the largest k such
+// that the edge belongs to the k-truss, the largest subgraph in which every
+// edge has support at least k - 2 (edges in no triangle have trussness 2).
+//
+// The supports are computed with the degree-ordered triangle counting in
+// Triangle.h, which calls back once per triangle. They are stored in an
+// edge-indexed array whose ids are aligned with the CSR offsets of the
+// graph: the edges {u, v} with u < v are numbered in order of u and then of
+// the position of v in the (sorted) adjacency list of u.
+//
+// The edges are then peeled with a bucket structure keyed by support, as the
+// vertices are in KCore.h. A round extracts the edges of the lowest bucket k,
+// enumerates the triangles that contain them and no edge peeled in an
+// earlier round by intersecting the adjacency lists of their endpoints, and
+// aggregates the support decrements of the other edges of these triangles in
+// a hash table (decrements never take a support below k). A triangle with two
+// edges in the current bucket decrements its third edge only once, and a
+// triangle with three edges in the current bucket decrements no edge.
+//
+// The edge ids are uintEs, so the graph must have fewer than 2^32 - 1
+// undirected edges.
+
+#pragma once
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+#include "benchmarks/TriangleCounting/ShunTangwongsan15/Triangle.h"
+#include "gbbs/bucket.h"
+#include "gbbs/gbbs.h"
+#include "gbbs/helpers/sparse_additive_map.h"
+
+namespace gbbs {
+namespace ktruss {
+
+// A CSR copy of a symmetric graph with undirected edge ids.
+struct EdgeIndex {
+  size_t n;
+  // The number of undirected edges.
+  size_t m;
+  // The neighbors of u are nghs[offsets[u], offsets[u + 1]), sorted.
+  sequence<size_t> offsets;
+  sequence<uintE> nghs;
+  // nghs[upper_starts[u]] is the first neighbor of u larger than u.
+  sequence<size_t> upper_starts;
+  // The edges {u, v} with u < v have ids [upper_offsets[u],
+  // upper_offsets[u + 1]).
+  sequence<size_t> upper_offsets;
+  // The id of the edge of every slot of nghs.
+  sequence<uintE> slot_ids;
+
+  template <class Graph>
+  explicit EdgeIndex(Graph& G) : n(G.n) {
+    using W = typename Graph::weight_type;
+    offsets = sequence<size_t>::from_function(n + 1, [&](size_t u) -> size_t {
+      return (u == n) ? 0 : G.get_vertex(u).out_degree();
+    });
+    size_t num_slots = parlay::scan_inplace(make_slice(offsets));
+    nghs = sequence<uintE>::uninitialized(num_slots);
+    parallel_for(0, n, 1, [&](size_t u) {
+      size_t i = offsets[u];
+      auto map_f = [&](const uintE& src, const uintE& v, const W& wgh) {
+        nghs[i++] = v;
+      };
+      G.get_vertex(u).out_neighbors().map(map_f, /*parallel=*/false);
+    });
+    upper_starts = sequence<size_t>::from_function(n, [&](size_t u) {
+      return std::upper_bound(nghs.begin() + offsets[u],
+                              nghs.begin() + offsets[u + 1], u) -
+             nghs.begin();
+    });
+    upper_offsets =
+        sequence<size_t>::from_function(n + 1, [&](size_t u) -> size_t {
+          return (u == n) ? 0 : offsets[u + 1] - upper_starts[u];
+        });
+    m = parlay::scan_inplace(make_slice(upper_offsets));
+    slot_ids = sequence<uintE>::uninitialized(num_slots);
+    parallel_for(0, n, 1, [&](size_t u) {
+      for (size_t i = offsets[u]; i < offsets[u + 1]; i++) {
+        slot_ids[i] = edge_id(u, nghs[i]);
+      }
+    });
+  }
+
+  // The id of the edge {u, v}, which must exist.
+  uintE edge_id(uintE u, uintE v) const {
+    if (u > v) std::swap(u, v);
+    size_t slot = std::lower_bound(nghs.begin() + upper_starts[u],
+                                   nghs.begin() + offsets[u + 1], v) -
+                  nghs.begin();
+    return upper_offsets[u] + (slot - upper_starts[u]);
+  }
+
+  // The endpoints (u, v), u < v, of edge e.
+  std::pair<uintE, uintE> endpoints(uintE e) const {
+    uintE u = std::upper_bound(upper_offsets.begin(), upper_offsets.end(),
+                               size_t{e}) -
+              upper_offsets.begin() - 1;
+    uintE v = nghs[upper_starts[u] + (e - upper_offsets[u])];
+    return std::make_pair(u, v);
+  }
+
+  // Calls f(e1, e2) for the edges e1 = {u, w} and e2 = {v, w} of every
+  // triangle {u, v, w} containing the edge {u, v}.
+  template <class F>
+  void map_triangles(uintE u, uintE v, F f) const {
+    size_t i = offsets[u], i_end = offsets[u + 1];
+    size_t j = offsets[v], j_end = offsets[v + 1];
+    while (i < i_end && j < j_end) {
+      if (nghs[i] == nghs[j]) {
+        f(slot_ids[i], slot_ids[j]);
+        i++;
+        j++;
+      } else if (nghs[i] < nghs[j]) {
+        i++;
+      } else {
+        j++;
+      }
+    }
+  }
+
+  size_t degree(uintE u) const { return offsets[u + 1] - offsets[u]; }
+};
+
+// Returns the support of every edge of G, indexed by the ids of `edges`.
+template <class Graph>
+inline sequence<uintE> EdgeSupport(Graph& G, const EdgeIndex& edges) {
+  auto support = sequence<uintE>(edges.m, 0);
+  auto f = [&](uintE u, uintE v, uintE w) {
+    gbbs::write_add(&support[edges.edge_id(u, v)], uintE{1});
+    gbbs::write_add(&support[edges.edge_id(u, w)], uintE{1});
+    gbbs::write_add(&support[edges.edge_id(v, w)], uintE{1});
+  };
+  Triangle_degree_ordering(G, f);
+  return support;
+}
+
+struct TrussDecomposition {
+  EdgeIndex edges;
+  // The initial support and the trussness of every edge.
+  sequence<uintE> support;
+  sequence<uintE> trussness;
+
+  uintE truss(uintE u, uintE v) const {
+    return trussness[edges.edge_id(u, v)];
+  }
+};
+
+}  // namespace ktruss
+
+// Computes the trussness of every edge of the symmetric graph G.
+template <class Graph>
+inline ktruss::TrussDecomposition KTruss(Graph& G, size_t num_buckets = 16) {
+  timer t;
+  t.start();
+  auto edges = ktruss::EdgeIndex(G);
+  gbbs_debug(t.next("edge index time"););
+  auto support = ktruss::EdgeSupport(G, edges);
+  gbbs_debug(t.next("support time"););
+  const size_t m = edges.m;
+  auto trussness = sequence<uintE>(m, 2);
+  if (m == 0) {
+    return ktruss::TrussDecomposition{std::move(edges), std::move(support),
+                                      std::move(trussness)};
+  }
+
+  // D[e] is the current support of e; peeled edges are marked removed, and
+  // the edges of the current bucket are marked current.
+  auto D = support;
+  auto removed = sequence<bool>(m, false);
+  auto current = sequence<bool>(m, false);
+  auto b = make_vertex_buckets(m, D, increasing, num_buckets);
+  timer bt;
+
+  size_t finished = 0, rho = 0, k_max = 0;
+  while (finished != m) {
+    bt.start();
+    auto bkt = b.next_bucket();
+    bt.stop();
+    auto active = std::move(bkt.identifiers);
+    uintE k = bkt.id;
+    finished += active.size();
+    k_max = std::max<size_t>(k_max, k);
+    parallel_for(0, active.size(), kDefaultGranularity,
+                 [&](size_t i) { current[active[i]] = true; });
+
+    // Every active edge {u, v} decrements at most 2 min(deg(u), deg(v))
+    // distinct edges.
+    size_t bound = parlay::reduce(
+        parlay::delayed_seq<size_t>(active.size(), [&](size_t i) {
+          auto [u, v] = edges.endpoints(active[i]);
+          return 2 * std::min(edges.degree(u), edges.degree(v));
+        }));
+    auto decrements = sparse_additive_map<uintE, uintE>(
+        std::max<size_t>(std::min(bound, m), 1),
+        std::make_tuple(UINT_E_MAX, uintE{0}));
+    parallel_for(0, active.size(), 1, [&](size_t i) {
+      uintE e = active[i];
+      auto [u, v] = edges.endpoints(e);
+      auto decrement = [&](uintE x) {
+        if (D[x] > k) decrements.insert(std::make_tuple(x, uintE{1}));
+      };
+      edges.map_triangles(u, v, [&](uintE e1, uintE e2) {
+        if (removed[e1] || removed[e2]) return;
+        bool c1 = current[e1], c2 = current[e2];
+        if (!c1 && !c2) {
+          decrement(e1);
+          decrement(e2);
+        } else if (c1 && !c2) {
+          if (e < e1) decrement(e2);
+        } else if (!c1 && c2) {
+          if (e < e2) decrement(e1);
+        }
+      });
+    });
+
+    auto updates = decrements.entries();
+    decrements.del();
+    auto update_f = [&](size_t i)
+        -> std::optional<std::tuple<uintE, uintE> > {
+      auto [x, count] = updates[i];
+      uintE new_support = (D[x] - k <= count) ? k : D[x] - count;
+      D[x] = new_support;
+      return wrap(x, b.get_bucket(new_support));
+    };
+    bt.start();
+    b.update_buckets(update_f, updates.size());
+    bt.stop();
+
+    parallel_for(0, active.size(), kDefaultGranularity, [&](size_t i) {
+      uintE e = active[i];
+      trussness[e] = k + 2;
+      removed[e] = true;
+      current[e] = false;
+    });
+    rho++;
+  }
+  std::cout << "### rho = " << rho << " k_{max} = " << (k_max + 2) << "\n";
+  gbbs_debug(bt.next("bucket time"););
+  return ktruss::TrussDecomposition{std::move(edges), std::move(support),
+                                    std::move(trussness)};
+}
+
+}  // namespace gbbs
@@ -0,0 +1,112 @@
+#include "benchmarks/KTruss/KTruss.h"
+
+#include <map>
+#include <set>
+#include <unordered_set>
+
+#include "gbbs/graph.h"
+#include "gbbs/helpers/undirected_edge.h"
+#include "gbbs/macros.h"
+#include "gbbs/unit_tests/graph_test_utils.h"
+#include "gtest/gtest.h"
+
+namespace gbbs {
+
+namespace {
+
+using Edge = std::pair<uintE, uintE>;
+
+// Returns the trussness of every edge by computing every k-truss with
+// sequential peeling.
+std::map<Edge, uintE> BruteForceTrussness(
+    const std::unordered_set<UndirectedEdge>& edges) {
+  std::map<Edge, uintE> trussness;
+  std::set<Edge> alive;
+  for (const auto& e : edges) {
+    alive.insert(e.endpoints());
+    trussness[e.endpoints()] = 2;
+  }
+  for (uintE k = 3; !alive.empty(); k++) {
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      std::map<uintE, std::set<uintE>> adj;
+      for (auto [u, v] : alive) {
+        adj[u].insert(v);
+        adj[v].insert(u);
+      }
+      for (auto it = alive.begin(); it != alive.end();) {
+        auto [u, v] = *it;
+        size_t support = 0;
+        for (uintE w : adj[u]) support += adj[v].count(w);
+        if (support < k - 2) {
+          it = alive.erase(it);
+          changed = true;
+        } else {
+          ++it;
+        }
+      }
+    }
+    for (const auto& e : alive) trussness[e] = k;
+  }
+  return trussness;
+}
+
+}  // namespace
+
+TEST(KTruss, BasicUsage) {
+  // A 5-clique on vertices 0, ..., 4, a 4-clique on vertices 4, ..., 7, the
+  // triangle {7, 8, 9}, and the path 9 - 10 - 11.
+  std::unordered_set<UndirectedEdge> edges;
+  for (uintE i = 0; i < 5; i++) {
+    for (uintE j = i + 1; j < 5; j++) edges.insert({i, j});
+  }
+  for (uintE i = 4; i < 8; i++) {
+    for (uintE j = i + 1; j < 8; j++) edges.insert({i, j});
+  }
+  edges.insert({7, 8});
+  edges.insert({8, 9});
+  edges.insert({7, 9});
+  edges.insert({9, 10});
+  edges.insert({10, 11});
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(12, edges);
+
+  auto truss = KTruss(graph);
+  EXPECT_EQ(truss.edges.m, edges.size());
+  EXPECT_EQ(truss.truss(0, 1), uintE{5});
+  EXPECT_EQ(truss.truss(3, 4), uintE{5});
+  EXPECT_EQ(truss.truss(4, 5), uintE{4});
+  EXPECT_EQ(truss.truss(6, 7), uintE{4});
+  EXPECT_EQ(truss.truss(8, 7), uintE{3});
+  EXPECT_EQ(truss.truss(9, 10), uintE{2});
+  EXPECT_EQ(truss.support[truss.edges.edge_id(0, 1)], uintE{3});
+  EXPECT_EQ(truss.support[truss.edges.edge_id(4, 5)], uintE{2});
+  EXPECT_EQ(truss.support[truss.edges.edge_id(10, 11)], uintE{0});
+}
+
+TEST(KTruss, MatchesBruteForce) {
+  constexpr uintE kNumVertices = 80;
+  std::unordered_set<UndirectedEdge> edges;
+  for (uintE i = 0; i < kNumVertices; i++) {
+    for (uintE j = i + 1; j < kNumVertices; j++) {
+      // Denser among the low ids.
+      size_t density = (i < 20 && j < 20) ? 2 : 10;
+      if (parlay::hash64(i * kNumVertices + j) % density == 0) {
+        edges.insert({i, j});
+      }
+    }
+  }
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(kNumVertices, edges);
+  auto truss = KTruss(graph);
+  auto expected = BruteForceTrussness(edges);
+  ASSERT_EQ(truss.edges.m, expected.size());
+  for (const auto& [e, k] : expected) {
+    EXPECT_EQ(truss.truss(e.first, e.second), k)
+        << "edge " << e.first << " " << e.second;
+    auto [u, v] = truss.edges.endpoints(truss.edges.edge_id(e.first, e.second));
+    EXPECT_EQ(u, e.first);
+    EXPECT_EQ(v, e.second);
+  }
+}
+
+}  // namespace gbbs
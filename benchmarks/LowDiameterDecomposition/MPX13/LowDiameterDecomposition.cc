@@ -32,6 +32,8 @@
 //     -rounds : the number of times to run the algorithm
 //     -fa : run the fetch-and-add implementation of k-core
 //     -nb : the number of buckets to use in the bucketing implementation
+//     -engine : run through LDDEngine and report the clustering
+//     -contract : with -engine, also contract the clusters (via contract.h)
 
 #include "LowDiameterDecomposition.h"
 
@@ -50,6 +52,23 @@ double LDD_runner(Graph& G, commandLine P) {
             << std::endl;
   std::cout << "### ------------------------------------" << std::endl;
   assert(P.getOption("-s"));
+  if (P.getOption("-engine")) {
+    timer t;
+    t.start();
+    auto engine = make_ldd_engine(G, permute);
+    auto clustering = engine.run(beta);
+    std::cout << "### num. clusters = " << clustering.num_clusters()
+              << " rounds = " << clustering.rounds << std::endl;
+    if (P.getOption("-contract")) {
+      auto contracted = clustering.contract(G);
+      auto& GC = std::get<0>(contracted);
+      std::cout << "### quotient graph: n = " << GC.n << " m = " << GC.m
+                << std::endl;
+    }
+    double tt = t.stop();
+    std::cout << "### Running Time: " << tt << std::endl;
+    return tt;
+  }
   timer t;
   t.start();
   auto ldd = LDD(G, beta, permute);
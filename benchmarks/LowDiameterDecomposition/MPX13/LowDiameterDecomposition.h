@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "gbbs/contract.h"
 #include "gbbs/gbbs.h"
 
 #include <cmath>
@@ -121,27 +122,24 @@ struct LDD_F {
   inline bool cond(uintE d) { return cluster_ids[d] == UINT_E_MAX; }
 };
 
-template <class Graph, class EO>
-inline sequence<uintE> LDD_impl(Graph& G, const EO& oracle, double beta,
-                                bool permute = true) {
-  // Implementation based on "A Simple and Practical Linear-Work Parallel
-  // Algorithm for Connectivity" by Shun, Dhulipala, and Blelloch, which is in
-  // turn based on "Parallel Graph Decompositions Using Random Shifts" by
-  // Miller, Peng, and Xu.
-  timer gs;
-  gs.start();
-  using W = typename Graph::weight_type;
+namespace ldd_utils {
+// Runs the rounds of the MPX decomposition. On round i, the vertices
+// order(shifts[i]), ..., order(shifts[i+1] - 1) that are still unvisited become
+// new cluster centers, after which every cluster grows by one hop using the
+// edgeMap functor `f`. Returns the number of rounds executed.
+//
+// Arguments:
+//   order: size_t -> uintE
+//     The i-th vertex to be considered as a center.
+//   unvisited: uintE -> bool
+//     Whether a vertex has not yet been assigned to a cluster.
+//   make_center: uintE -> void
+//     Assigns a vertex to the cluster centered at itself.
+template <class Graph, class Order, class Unvisited, class MakeCenter, class F>
+inline size_t ldd_rounds(Graph& G, const sequence<size_t>& shifts,
+                         Order& order, Unvisited& unvisited,
+                         MakeCenter& make_center, F& f) {
   size_t n = G.n;
-
-  sequence<uintE> vertex_perm;
-  if (permute) {
-    vertex_perm = parlay::random_permutation<uintE>(n);
-  }
-  auto shifts = ldd_utils::generate_shifts(n, beta);
-  gs.stop();
-  gbbs_debug(gs.next("generate shifts time"););
-  auto cluster_ids = sequence<uintE>(n, UINT_E_MAX);
-
   timer add_t;
   timer vt;
 
@@ -155,20 +153,12 @@ inline sequence<uintE> LDD_impl(Graph& G, const EO& oracle, double beta,
     if (num_to_add > 0) {
       add_t.start();
       assert((num_added + num_to_add) <= n);
-      auto candidates_f = [&](size_t i) {
-        if (permute)
-          return vertex_perm[num_added + i];
-        else
-          return static_cast<uintE>(num_added + i);
-      };
-      auto candidates = parlay::delayed_seq<uintE>(num_to_add, candidates_f);
-      auto pred = [&](uintE v) { return cluster_ids[v] == UINT_E_MAX; };
-      auto new_centers = parlay::filter(candidates, pred);
+      auto candidates = parlay::delayed_seq<uintE>(
+          num_to_add, [&](size_t i) { return order(num_added + i); });
+      auto new_centers = parlay::filter(candidates, unvisited);
       add_to_vsubset(frontier, new_centers.begin(), new_centers.size());
-      parallel_for(0, new_centers.size(), [&](size_t i) {
-        uintE new_center = new_centers[i];
-        cluster_ids[new_center] = new_center;
-      });
+      parallel_for(0, new_centers.size(),
+                   [&](size_t i) { make_center(new_centers[i]); });
       num_added += num_to_add;
       add_t.stop();
     }
@@ -177,13 +167,44 @@ inline sequence<uintE> LDD_impl(Graph& G, const EO& oracle, double beta,
     if (num_visited >= n) break;
 
     vt.start();
-    auto ldd_f = LDD_F<W, EO>(cluster_ids.begin(), oracle);
-    frontier = edgeMap(G, frontier, ldd_f, -1, sparse_blocked);
+    frontier = edgeMap(G, frontier, f, -1, sparse_blocked);
     vt.stop();
 
     round++;
   }
   gbbs_debug(add_t.next("add vertices time"); vt.next("edge map time"););
+  return round + 1;
+}
+}  // namespace ldd_utils
+
+template <class Graph, class EO>
+inline sequence<uintE> LDD_impl(Graph& G, const EO& oracle, double beta,
+                                bool permute = true) {
+  // Implementation based on "A Simple and Practical Linear-Work Parallel
+  // Algorithm for Connectivity" by Shun, Dhulipala, and Blelloch, which is in
+  // turn based on "Parallel Graph Decompositions Using Random Shifts" by
+  // Miller, Peng, and Xu.
+  timer gs;
+  gs.start();
+  using W = typename Graph::weight_type;
+  size_t n = G.n;
+
+  sequence<uintE> vertex_perm;
+  if (permute) {
+    vertex_perm = parlay::random_permutation<uintE>(n);
+  }
+  auto shifts = ldd_utils::generate_shifts(n, beta);
+  gs.stop();
+  gbbs_debug(gs.next("generate shifts time"););
+  auto cluster_ids = sequence<uintE>(n, UINT_E_MAX);
+
+  auto order = [&](size_t i) {
+    return permute ? vertex_perm[i] : static_cast<uintE>(i);
+  };
+  auto unvisited = [&](uintE v) { return cluster_ids[v] == UINT_E_MAX; };
+  auto make_center = [&](uintE v) { cluster_ids[v] = v; };
+  auto ldd_f = LDD_F<W, EO>(cluster_ids.begin(), oracle);
+  ldd_utils::ldd_rounds(G, shifts, order, unvisited, make_center, ldd_f);
   return cluster_ids;
 }
 
@@ -210,4 +231,137 @@ sequence<uintE> LDD_oracle(Graph& G, EO& oracle, double beta,
   return LDD_impl(G, oracle, beta, permute);
 }
 
+// Same as LDD_F, but additionally records the BFS parent of every vertex that
+// joins a cluster, so that each cluster is represented by a BFS tree rooted at
+// its center.
+template <class W, class EO>
+struct LDD_Tree_F {
+  uintE* cluster_ids;
+  uintE* parents;
+  const EO& oracle;
+
+  LDD_Tree_F(uintE* _cluster_ids, uintE* _parents, const EO& _oracle)
+      : cluster_ids(_cluster_ids), parents(_parents), oracle(_oracle) {}
+
+  inline bool update(const uintE& s, const uintE& d, const W& wgh) {
+    if (oracle(s, d, wgh)) {
+      cluster_ids[d] = cluster_ids[s];
+      parents[d] = s;
+      return true;
+    }
+    return false;
+  }
+
+  inline bool updateAtomic(const uintE& s, const uintE& d, const W& wgh) {
+    if (oracle(s, d, wgh) &&
+        gbbs::atomic_compare_and_swap(&cluster_ids[d], UINT_E_MAX,
+                                      cluster_ids[s])) {
+      parents[d] = s;
+      return true;
+    }
+    return false;
+  }
+
+  inline bool cond(uintE d) { return cluster_ids[d] == UINT_E_MAX; }
+};
+
+// The output of a low-diameter decomposition, retained so that several
+// consumers (sampling, spanners, contraction) can share one decomposition.
+//
+//   cluster_ids[v]: the center of the cluster containing v.
+//   parents[v]: the BFS parent of v in its cluster; parents[c] == c for every
+//     center c.
+//   centers: the cluster centers in increasing order of id.
+//   rounds: the number of rounds the decomposition took, which bounds the
+//     radius of every cluster.
+struct LDDClustering {
+  sequence<uintE> cluster_ids;
+  sequence<uintE> parents;
+  sequence<uintE> centers;
+  double beta;
+  size_t rounds;
+
+  size_t num_clusters() const { return centers.size(); }
+
+  // Returns cluster ids relabeled to be contiguous in [0, num_clusters()).
+  // Cluster i is the cluster centered at centers[i].
+  sequence<uintE> dense_cluster_ids() const {
+    auto ids = cluster_ids;
+    contract::RelabelIds(ids);
+    return ids;
+  }
+
+  // Contracts every cluster of G to a single vertex using contract.h. Returns
+  // the quotient graph, the dense cluster ids of the vertices of G, and the
+  // (flags, mapping) pair returned by contract::contract.
+  template <class Graph>
+  auto contract(Graph& G) const {
+    auto ids = dense_cluster_ids();
+    auto [GC, flags, mapping] = contract::contract(G, ids, num_clusters());
+    return std::make_tuple(std::move(GC), std::move(ids), std::move(flags),
+                           std::move(mapping));
+  }
+};
+
+// A reusable low-diameter decomposition stage. The engine draws the random
+// vertex ordering (the ranking of the exponential shifts) once, and each call
+// to run() only regenerates the O(log(n) / beta)-length shift schedule for the
+// requested beta. This makes parameter sweeps over beta cheap, and makes the
+// decompositions for different values of beta use the same shifts: a vertex
+// that starts earlier than another for one beta does so for every beta.
+template <class Graph>
+struct LDDEngine {
+  using W = typename Graph::weight_type;
+  Graph& G;
+  bool permute;
+  sequence<uintE> vertex_perm;
+
+  LDDEngine(Graph& G, bool permute = true) : G(G), permute(permute) {
+    if (permute) {
+      vertex_perm = parlay::random_permutation<uintE>(G.n);
+    }
+  }
+
+  // Computes a decomposition with parameter beta using only the edges (u, v,
+  // w) for which oracle(u, v, w) is true.
+  template <class EO>
+  LDDClustering run(double beta, const EO& oracle) {
+    size_t n = G.n;
+    auto shifts = ldd_utils::generate_shifts(n, beta);
+    auto cluster_ids = sequence<uintE>(n, UINT_E_MAX);
+    auto parents = sequence<uintE>::uninitialized(n);
+
+    auto order = [&](size_t i) {
+      return permute ? vertex_perm[i] : static_cast<uintE>(i);
+    };
+    auto unvisited = [&](uintE v) { return cluster_ids[v] == UINT_E_MAX; };
+    auto make_center = [&](uintE v) {
+      cluster_ids[v] = v;
+      parents[v] = v;
+    };
+    auto ldd_f =
+        LDD_Tree_F<W, EO>(cluster_ids.begin(), parents.begin(), oracle);
+    size_t rounds =
+        ldd_utils::ldd_rounds(G, shifts, order, unvisited, make_center, ldd_f);
+
+    auto is_center = parlay::delayed_seq<bool>(
+        n, [&](size_t i) { return cluster_ids[i] == i; });
+    auto centers = parlay::pack_index<uintE>(is_center);
+    return LDDClustering{std::move(cluster_ids), std::move(parents),
+                         std::move(centers), beta, rounds};
+  }
+
+  LDDClustering run(double beta) {
+    auto oracle = [&](const uintE& u, const uintE& v, const W& wgh) {
+      return true;
+    };
+    return run(beta, oracle);
+  }
+};
+
+template <class Graph>
+inline LDDEngine<Graph> make_ldd_engine(Graph& G, bool permute = true) {
+  return LDDEngine<Graph>(G, permute);
+}
+
 }  // namespace gbbs
@@ -0,0 +1,138 @@
+#include "benchmarks/LowDiameterDecomposition/MPX13/LowDiameterDecomposition.h"
+
+#include <set>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "gbbs/graph.h"
+#include "gbbs/helpers/undirected_edge.h"
+#include "gbbs/macros.h"
+#include "gbbs/unit_tests/graph_test_utils.h"
+#include "gtest/gtest.h"
+
+namespace gbbs {
+
+namespace {
+
+// Checks that every vertex is in the cluster of a center, and that following
+// the parents from any vertex reaches its center through graph edges within
+// the cluster, so every cluster is connected.
+void CheckClustering(const LDDClustering& clustering, uintE n,
+                     const std::unordered_set<UndirectedEdge>& edges) {
+  ASSERT_EQ(clustering.cluster_ids.size(), n);
+  ASSERT_EQ(clustering.parents.size(), n);
+  std::set<uintE> centers(clustering.centers.begin(),
+                          clustering.centers.end());
+  EXPECT_EQ(centers.size(), clustering.num_clusters());
+  for (uintE v = 0; v < n; v++) {
+    uintE center = clustering.cluster_ids[v];
+    ASSERT_LT(center, n);
+    EXPECT_EQ(centers.count(center), 1) << v;
+    EXPECT_EQ(clustering.cluster_ids[center], center);
+    uintE u = v;
+    size_t steps = 0;
+    while (u != center && steps <= n) {
+      uintE p = clustering.parents[u];
+      ASSERT_LT(p, n);
+      EXPECT_EQ(edges.count(UndirectedEdge{u, p}), 1) << u << " " << p;
+      EXPECT_EQ(clustering.cluster_ids[p], center);
+      u = p;
+      steps++;
+    }
+    EXPECT_EQ(u, center) << v;
+  }
+
+  // The dense ids give every cluster its own id in [0, num_clusters()).
+  auto ids = clustering.dense_cluster_ids();
+  std::set<uintE> dense_centers;
+  for (uintE v = 0; v < n; v++) {
+    EXPECT_LT(ids[v], clustering.num_clusters());
+    EXPECT_EQ(ids[v], ids[clustering.cluster_ids[v]]);
+    if (clustering.cluster_ids[v] == v) dense_centers.insert(ids[v]);
+  }
+  EXPECT_EQ(dense_centers.size(), clustering.num_clusters());
+}
+
+}  // namespace
+
+TEST(LDDEngine, ClustersAreValid) {
+  constexpr uintE n = 300;
+  const auto edges = graph_test::RandomUndirectedEdges(n, 0.02, /*seed=*/26);
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(n, edges);
+  auto engine = make_ldd_engine(graph);
+  for (double beta : {0.05, 0.2, 1.0}) {
+    auto clustering = engine.run(beta);
+    EXPECT_EQ(clustering.beta, beta);
+    EXPECT_GT(clustering.rounds, 0);
+    CheckClustering(clustering, n, edges);
+  }
+}
+
+TEST(LDDEngine, ReusesTheVertexOrder) {
+  constexpr uintE n = 300;
+  const auto edges = graph_test::RandomUndirectedEdges(n, 0.02, /*seed=*/27);
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(n, edges);
+  auto engine = make_ldd_engine(graph);
+  const std::vector<uintE> perm(engine.vertex_perm.begin(),
+                                engine.vertex_perm.end());
+  // The set of centers only depends on the vertex order and beta, not on the
+  // (racy) choice of parents, so rerunning a beta reproduces it.
+  auto first = engine.run(0.2);
+  engine.run(0.5);
+  auto second = engine.run(0.2);
+  EXPECT_EQ(std::vector<uintE>(engine.vertex_perm.begin(),
+                               engine.vertex_perm.end()),
+            perm);
+  EXPECT_EQ(std::vector<uintE>(first.centers.begin(), first.centers.end()),
+            std::vector<uintE>(second.centers.begin(), second.centers.end()));
+
+  // The first vertex of the order always starts a cluster.
+  auto unpermuted = make_ldd_engine(graph, /*permute=*/false);
+  for (double beta : {0.1, 0.5}) {
+    auto clustering = unpermuted.run(beta);
+    EXPECT_EQ(clustering.cluster_ids[0], 0);
+    EXPECT_EQ(clustering.parents[0], 0);
+    CheckClustering(clustering, n, edges);
+  }
+}
+
+TEST(LDDClustering, Contract) {
+  // Two triangles {0, 1, 2} and {3, 4, 5} joined by the edge {2, 3}, and the
+  // isolated vertex 6.
+  constexpr uintE n = 7;
+  const std::unordered_set<UndirectedEdge> edges{
+      {0, 1}, {1, 2}, {0, 2}, {3, 4}, {4, 5}, {3, 5}, {2, 3}};
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(n, edges);
+  auto engine = make_ldd_engine(graph);
+  for (double beta : {0.1, 0.5, 2.0}) {
+    auto clustering = engine.run(beta);
+    CheckClustering(clustering, n, edges);
+    auto [GC, ids, flags, mapping] = clustering.contract(graph);
+    ASSERT_EQ(ids.size(), n);
+
+    // The quotient edges are exactly the pairs of clusters joined by an
+    // edge; clusters without such edges are dropped.
+    std::set<std::pair<uintE, uintE>> expected;
+    for (const auto& edge : edges) {
+      auto [u, v] = edge.endpoints();
+      uintE a = ids[u], b = ids[v];
+      if (a == b) continue;
+      ASSERT_NE(flags[a], flags[a + 1]);
+      ASSERT_NE(flags[b], flags[b + 1]);
+      expected.insert({flags[a], flags[b]});
+      expected.insert({flags[b], flags[a]});
+    }
+    std::set<std::pair<uintE, uintE>> actual;
+    for (uintE c = 0; c < GC.n; c++) {
+      EXPECT_EQ(flags[mapping[c]], c);
+      auto map_f = [&](const uintE& src, const uintE& dst, const auto& wgh) {
+        actual.insert({src, dst});
+      };
+      GC.get_vertex(c).out_neighbors().map(map_f, /*parallel=*/false);
+    }
+    EXPECT_EQ(actual, expected);
+  }
+}
+
+}  // namespace gbbs
@@ -0,0 +1,53 @@
+// Usage:
+// numactl -i all ./MaximalCliques -s -min 3 com-orkut.ungraph.txt_SJ
+// flags:
+//   required:
+//     -s : indicates that the graph is symmetric
+//   optional:
+//     -m : indicate that the graph should be mmap'd
+//     -c : indicate that the graph is compressed
+//     -rounds : the number of times to run the algorithm
+//     -min : only report maximal cliques with at least this many vertices
+//     -max : only report maximal cliques with at most this many vertices
+//     -e : the epsilon of the approximate degeneracy order
+//     -cutoff : the number of candidates above which the branches of a
+//               search node run in parallel
+
+#include "MaximalCliques.h"
+
+namespace gbbs {
+template <class Graph>
+double MaximalCliques_runner(Graph& G, commandLine P) {
+  maximal_cliques::Options options;
+  options.min_size = P.getOptionLongValue("-min", 1);
+  options.max_size = P.getOptionLongValue("-max", options.max_size);
+  options.epsilon = P.getOptionDoubleValue("-e", 0.1);
+  options.parallel_cutoff = P.getOptionLongValue("-cutoff", 32);
+  std::cout << "### Application: MaximalCliques" << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -min = " << options.min_size
+            << " -max = " << options.max_size << " -e = " << options.epsilon
+            << " -cutoff = " << options.parallel_cutoff << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+  assert(P.getOption("-s"));
+
+  timer t;
+  t.start();
+  size_t max_size = 0;
+  auto f = [&](const sequence<uintE>& clique) {
+    gbbs::write_max(&max_size, clique.size(), std::less<size_t>());
+  };
+  size_t count = MaximalCliques(G, f, options);
+  double tt = t.stop();
+  std::cout << "### Num maximal cliques = " << count << std::endl;
+  std::cout << "### Max clique size = " << max_size << std::endl;
+
+  std::cout << "### Running Time: " << tt << std::endl;
+  return tt;
+}
+}  // namespace gbbs
+
+generate_symmetric_main(gbbs::MaximalCliques_runner, false);
@@ -0,0 +1,262 @@
+// Parallel maximal clique enumeration, following Eppstein, Loffler and Strash
+// ("Listing all maximal cliques in sparse graphs in near-optimal time").
+//
+// The vertices are ranked by the (2 + epsilon)-approximate degeneracy order
+// of GoodrichPszona11, and every vertex v seeds one Bron-Kerbosch search with
+// R = {v}, the candidates P = the neighbors of v after v, and the excluded
+// vertices X = the neighbors of v before v, so every maximal clique is found
+// exactly once, from its first vertex. The searches use Tomita pivoting:
+// the pivot u is the vertex of P and X with the most neighbors in P, and only
+// the candidates outside of N(u) are branched on.
+//
+// A seed works on the subgraph induced by the neighbors of v, relabeled to
+// local ids in the style of the induced subgraphs of CliqueCounting. Only the
+// edges with an endpoint in P are kept (edges within X never matter), so
+// building it takes O(sum_{w in P} deg(w)) work, and |P| is at most
+// (2 + epsilon) times the degeneracy. The map from global to local ids is a
+// scratch array of n entries from parallel_for_alloc.
+//
+// The seeds run in parallel, and so do the branches of a search node with at
+// least `parallel_cutoff` candidates: the branch of the i-th candidate w_i is
+// independent of the others once the earlier candidates w_1, ..., w_{i-1} are
+// moved from P to X, so the scheduler steals subtrees for load balance.
+//
+// The cliques are streamed to a callback f(const sequence<uintE>& clique),
+// which is called concurrently by different workers. The vertices of a
+// clique are listed in the order in which they were added (the seed first).
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include "benchmarks/DegeneracyOrder/GoodrichPszona11/DegeneracyOrder.h"
+#include "gbbs/gbbs.h"
+
+namespace gbbs {
+namespace maximal_cliques {
+
+struct Options {
+  // Only the maximal cliques with between min_size and max_size vertices are
+  // reported (and the searches are pruned accordingly).
+  size_t min_size = 1;
+  size_t max_size = std::numeric_limits<size_t>::max();
+  // The epsilon of the approximate degeneracy order.
+  double epsilon = 0.1;
+  // The minimum number of candidates of a search node whose branches run in
+  // parallel.
+  size_t parallel_cutoff = 32;
+};
+
+// The subgraph induced by the neighbors of a seed vertex. Local vertex i is
+// ids[i]; the candidates are exactly the local vertices with in_p[i] set.
+// The row of a candidate lists all of its neighbors, and the row of an
+// excluded vertex only its neighbors that are candidates. Rows are sorted.
+struct LocalGraph {
+  sequence<uintE> ids;
+  sequence<bool> in_p;
+  sequence<size_t> offsets;
+  sequence<uintE> nghs;
+
+  size_t size() const { return ids.size(); }
+  const uintE* begin(uintE u) const { return nghs.begin() + offsets[u]; }
+  const uintE* end(uintE u) const { return nghs.begin() + offsets[u + 1]; }
+};
+
+// A map from global to local ids, all UINT_E_MAX between uses.
+struct LocalIds {
+  sequence<uintE> local;
+
+  void alloc(size_t n) {
+    if (local.size() < n) local = sequence<uintE>(n, UINT_E_MAX);
+  }
+};
+
+// Returns the elements of the sorted sequence A that are in row u.
+inline sequence<uintE> Intersect(const sequence<uintE>& A,
+                                 const LocalGraph& L, uintE u) {
+  sequence<uintE> out;
+  std::set_intersection(A.begin(), A.end(), L.begin(u), L.end(u),
+                        std::back_inserter(out));
+  return out;
+}
+
+inline size_t IntersectionSize(const sequence<uintE>& A, const LocalGraph& L,
+                               uintE u) {
+  size_t count = 0;
+  const uintE *i = A.begin(), *j = L.begin(u);
+  while (i != A.end() && j != L.end(u)) {
+    if (*i == *j) {
+      count++;
+      i++;
+      j++;
+    } else if (*i < *j) {
+      i++;
+    } else {
+      j++;
+    }
+  }
+  return count;
+}
+
+template <class F>
+struct Search {
+  const LocalGraph& L;
+  F& f;
+  const Options& options;
+
+  Search(const LocalGraph& L, F& f, const Options& options)
+      : L(L), f(f), options(options) {}
+
+  // Reports the maximal cliques that contain R, some vertices of P, and no
+  // vertex of X. P and X are sorted local ids; R holds global ids. Returns
+  // the number of cliques reported.
+  size_t Expand(const sequence<uintE>& R, const sequence<uintE>& P,
+                const sequence<uintE>& X) {
+    if (R.size() > options.max_size ||
+        R.size() + P.size() < options.min_size) {
+      return 0;
+    }
+    if (P.size() == 0) {
+      if (X.size() > 0) return 0;
+      f(R);
+      return 1;
+    }
+
+    // The pivot is the vertex of P and X with the most neighbors in P.
+    uintE pivot = P[0];
+    size_t best = 0;
+    auto consider = [&](uintE u) {
+      size_t count = IntersectionSize(P, L, u);
+      if (count > best) {
+        best = count;
+        pivot = u;
+      }
+    };
+    for (uintE u : P) consider(u);
+    for (uintE u : X) consider(u);
+    sequence<uintE> branches;
+    std::set_difference(P.begin(), P.end(), L.begin(pivot), L.end(pivot),
+                        std::back_inserter(branches));
+
+    // The branch of branches[i] excludes branches[0], ..., branches[i - 1].
+    auto branch = [&](size_t i) -> size_t {
+      uintE w = branches[i];
+      auto earlier = branches.cut(0, i);
+      auto next_P = parlay::filter(Intersect(P, L, w), [&](uintE u) {
+        return !std::binary_search(earlier.begin(), earlier.end(), u);
+      });
+      auto moved = parlay::filter(earlier, [&](uintE u) {
+        return std::binary_search(L.begin(w), L.end(w), u);
+      });
+      auto excluded = Intersect(X, L, w);
+      auto next_X = sequence<uintE>::uninitialized(excluded.size() +
+                                                   moved.size());
+      std::merge(excluded.begin(), excluded.end(), moved.begin(), moved.end(),
+                 next_X.begin());
+      auto next_R = R;
+      next_R.push_back(L.ids[w]);
+      return Expand(next_R, next_P, next_X);
+    };
+    if (P.size() < options.parallel_cutoff) {
+      size_t total = 0;
+      for (size_t i = 0; i < branches.size(); i++) total += branch(i);
+      return total;
+    }
+    auto counts = sequence<size_t>::uninitialized(branches.size());
+    parallel_for(0, branches.size(), 1,
+                 [&](size_t i) { counts[i] = branch(i); });
+    return parlay::reduce(counts);
+  }
+};
+
+}  // namespace maximal_cliques
+
+// Calls f(clique) for every maximal clique of the symmetric graph G with
+// between options.min_size and options.max_size vertices, and returns their
+// number. f can be called concurrently.
+template <class Graph, class F>
+inline size_t MaximalCliques(Graph& G, F f,
+                             const maximal_cliques::Options& options = {}) {
+  using maximal_cliques::LocalGraph;
+  using maximal_cliques::LocalIds;
+  const size_t n = G.n;
+  timer t;
+  t.start();
+  auto rank = goodrichpszona_degen::DegeneracyOrder_intsort(G, options.epsilon);
+  gbbs_debug(t.next("degeneracy order time"););
+
+  auto counts = sequence<size_t>::uninitialized(n);
+  auto init_ids = [&](LocalIds* ids) { ids->alloc(n); };
+  auto finish_ids = [&](LocalIds* ids) {
+    if (ids != nullptr) {
+      delete ids;
+    }
+  };
+  parallel_for_alloc<LocalIds>(
+      init_ids, finish_ids, 0, n, [&](size_t v, LocalIds* ids) {
+        LocalGraph L;
+        auto vtx = G.get_vertex(v);
+        size_t degree = vtx.out_degree();
+        L.ids = sequence<uintE>::uninitialized(degree);
+        L.in_p = sequence<bool>::uninitialized(degree);
+        L.offsets = sequence<size_t>(degree + 1, 0);
+        // The local ids are released at the end of this block, before the
+        // search, whose parallel branches may let another seed reuse them.
+        std::vector<uintE> candidates, excluded;
+        {
+          auto& local = ids->local;
+          size_t k = 0;
+          auto id_f = [&](const uintE& src, const uintE& u, const auto& wgh) {
+            local[u] = k;
+            L.ids[k] = u;
+            L.in_p[k] = rank[u] > rank[v];
+            (L.in_p[k] ? candidates : excluded).push_back(k);
+            k++;
+          };
+          vtx.out_neighbors().map(id_f, /*parallel=*/false);
+
+          // Calls edge_fn(i, j) for every edge between a candidate i and a
+          // local vertex j, in increasing order of i and then of j.
+          auto map_edges = [&](auto edge_fn) {
+            for (uintE i : candidates) {
+              auto edge_f = [&](const uintE& src, const uintE& u,
+                                const auto& wgh) {
+                if (local[u] != UINT_E_MAX) edge_fn(i, local[u]);
+              };
+              G.get_vertex(L.ids[i]).out_neighbors().map(edge_f, false);
+            }
+          };
+          map_edges([&](uintE i, uintE j) {
+            L.offsets[i]++;
+            if (!L.in_p[j]) L.offsets[j]++;
+          });
+          size_t num_edges = 0;
+          for (size_t i = 0; i <= degree; i++) {
+            size_t row = L.offsets[i];
+            L.offsets[i] = num_edges;
+            num_edges += row;
+          }
+          L.nghs = sequence<uintE>::uninitialized(num_edges);
+          auto cursor = std::vector<size_t>(L.offsets.begin(),
+                                            L.offsets.begin() + degree);
+          map_edges([&](uintE i, uintE j) {
+            L.nghs[cursor[i]++] = j;
+            if (!L.in_p[j]) L.nghs[cursor[j]++] = i;
+          });
+          for (uintE u : L.ids) local[u] = UINT_E_MAX;
+        }
+        auto P = sequence<uintE>(candidates.begin(), candidates.end());
+        auto X = sequence<uintE>(excluded.begin(), excluded.end());
+        auto search = maximal_cliques::Search<F>(L, f, options);
+        counts[v] = search.Expand(sequence<uintE>(1, v), P, X);
+      },
+      1, false);
+  size_t total = parlay::reduce(counts);
+  gbbs_debug(t.next("enumeration time"););
+  return total;
+}
+
+}  // namespace gbbs
@@ -0,0 +1,113 @@
+#include "benchmarks/MaximalCliques/MaximalCliques.h"
+
+#include <algorithm>
+#include <mutex>
+#include <set>
+#include <unordered_set>
+#include <vector>
+
+#include "gbbs/graph.h"
+#include "gbbs/helpers/undirected_edge.h"
+#include "gbbs/macros.h"
+#include "gbbs/unit_tests/graph_test_utils.h"
+#include "gtest/gtest.h"
+
+namespace gbbs {
+
+namespace {
+
+using Clique = std::vector<uintE>;
+
+// Returns the maximal cliques of a small graph by checking every vertex
+// subset.
+std::set<Clique> BruteForceMaximalCliques(
+    size_t n, const std::unordered_set<UndirectedEdge>& edges) {
+  auto adj = graph_test::MakeAdjacencySets(n, edges);
+  auto is_clique = [&](size_t mask) {
+    for (size_t u = 0; u < n; u++) {
+      for (size_t v = u + 1; v < n; v++) {
+        if ((mask >> u & 1) && (mask >> v & 1) && adj[u].count(v) == 0) {
+          return false;
+        }
+      }
+    }
+    return true;
+  };
+  std::set<Clique> cliques;
+  for (size_t mask = 1; mask < (size_t{1} << n); mask++) {
+    if (!is_clique(mask)) continue;
+    bool maximal = true;
+    for (size_t v = 0; v < n && maximal; v++) {
+      if (!(mask >> v & 1) && is_clique(mask | (size_t{1} << v))) {
+        maximal = false;
+      }
+    }
+    if (maximal) {
+      Clique clique;
+      for (uintE v = 0; v < n; v++) {
+        if (mask >> v & 1) clique.push_back(v);
+      }
+      cliques.insert(clique);
+    }
+  }
+  return cliques;
+}
+
+template <class Graph>
+std::set<Clique> Enumerate(Graph& graph,
+                           const maximal_cliques::Options& options) {
+  std::mutex mutex;
+  std::set<Clique> cliques;
+  size_t reported = 0;
+  auto f = [&](const sequence<uintE>& clique) {
+    Clique sorted(clique.begin(), clique.end());
+    std::sort(sorted.begin(), sorted.end());
+    std::lock_guard<std::mutex> lock(mutex);
+    cliques.insert(sorted);
+    reported++;
+  };
+  size_t count = MaximalCliques(graph, f, options);
+  EXPECT_EQ(count, reported);
+  // Every clique is reported once.
+  EXPECT_EQ(cliques.size(), reported);
+  return cliques;
+}
+
+}  // namespace
+
+TEST(MaximalCliques, MatchesBruteForce) {
+  // Pseudo-random graphs on 14 vertices with edge densities of about 1/4,
+  // 1/2 and 3/4.
+  constexpr uintE n = 14;
+  for (double p : {0.25, 0.5, 0.75}) {
+    auto edges = graph_test::RandomUndirectedEdges(n, p, /*seed=*/7);
+    auto graph = graph_test::MakeUnweightedSymmetricGraph(n, edges);
+    auto expected = BruteForceMaximalCliques(n, edges);
+
+    maximal_cliques::Options options;
+    EXPECT_EQ(Enumerate(graph, options), expected);
+    // Run every search node with parallel branches.
+    options.parallel_cutoff = 1;
+    EXPECT_EQ(Enumerate(graph, options), expected);
+
+    options.min_size = 3;
+    options.max_size = 4;
+    std::set<Clique> filtered;
+    for (const auto& clique : expected) {
+      if (clique.size() >= 3 && clique.size() <= 4) filtered.insert(clique);
+    }
+    EXPECT_EQ(Enumerate(graph, options), filtered);
+  }
+}
+
+TEST(MaximalCliques, IsolatedVerticesAndEdges) {
+  // The triangle {0, 1, 2}, the edge {3, 4}, and the isolated vertex 5.
+  const std::unordered_set<UndirectedEdge> edges{{0, 1}, {1, 2}, {0, 2},
+                                                 {3, 4}};
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(6, edges);
+  maximal_cliques::Options options;
+  auto cliques = Enumerate(graph, options);
+  EXPECT_EQ(cliques, (std::set<Clique>{{0, 1, 2}, {3, 4}, {5}}));
+}
+
+}  // namespace gbbs
@@ -0,0 +1,46 @@
+// Usage Example:
+// numactl -i all ./Suitor -s -m clueweb_wgh_sym.bytepda
+// flags:
+//   required:
+//     -s : indicates that the graph is symmetric
+//   optional:
+//     -m : indicate that the graph should be mmap'd
+//     -c : indicate that the graph is compressed
+//     -bmatch : compute a b-matching with this b for every vertex (1 by
+//      default, i.e., a matching)
+
+#include "Suitor.h"
+
+#include <iostream>
+
+namespace gbbs {
+
+template <class Graph>
+double Suitor_runner(Graph& G, commandLine P) {
+  uintE b = P.getOptionLongValue("-bmatch", 1);
+  std::cout << "### Application: Weighted Matching (Suitor)" << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -bmatch = " << b << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+  assert(P.getOption("-s"));  // input graph must be symmetric
+
+  timer t;
+  t.start();
+  auto matching = WeightedBMatching(G, [&](size_t v) { return b; });
+  double tt = t.stop();
+
+  auto weights = parlay::delayed_seq<double>(matching.size(), [&](size_t i) {
+    return static_cast<double>(std::get<2>(matching[i]));
+  });
+  std::cout << "matching weight = " << parlay::reduce(weights) << "\n";
+
+  std::cout << "### Running Time: " << tt << std::endl;
+  return tt;
+}
+
+}  // namespace gbbs
+
+generate_symmetric_weighted_main(gbbs::Suitor_runner, false);
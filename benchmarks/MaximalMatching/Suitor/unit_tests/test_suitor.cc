@@ -0,0 +1,133 @@
+#include "benchmarks/MaximalMatching/Suitor/Suitor.h"
+
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
+#include "gbbs/graph.h"
+#include "gbbs/macros.h"
+#include "gbbs/unit_tests/graph_test_utils.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using ::testing::ElementsAre;
+using ::testing::UnorderedElementsAreArray;
+
+namespace gbbs {
+
+namespace {
+
+using Edge = std::tuple<uintE, uintE, int>;
+using Graph = symmetric_graph<symmetric_vertex, int>;
+
+Graph MakeGraph(sequence<Edge> edges, size_t n) {
+  return Graph::from_edges(edges, n);
+}
+
+// The greedy b-matching that scans the edges from heaviest to lightest; the
+// weights must be distinct.
+std::vector<Edge> GreedyBMatching(std::vector<Edge> edges, size_t n, uintE b) {
+  std::sort(edges.begin(), edges.end(), [](const Edge& l, const Edge& r) {
+    return std::get<2>(l) > std::get<2>(r);
+  });
+  std::vector<uintE> degree(n, 0);
+  std::vector<Edge> matching;
+  for (auto [u, v, w] : edges) {
+    if (degree[u] < b && degree[v] < b) {
+      degree[u]++;
+      degree[v]++;
+      matching.push_back({std::min(u, v), std::max(u, v), w});
+    }
+  }
+  return matching;
+}
+
+std::vector<Edge> ToVector(const sequence<Edge>& matching) {
+  return std::vector<Edge>(matching.begin(), matching.end());
+}
+
+}  // namespace
+
+TEST(Suitor, HeavyMiddleEdge) {
+  // 0 -(1)- 1 -(3)- 2 -(1)- 3
+  auto graph = MakeGraph({{0, 1, 1}, {1, 2, 3}, {2, 3, 1}}, 4);
+  auto matching = WeightedMatching(graph);
+  EXPECT_THAT(ToVector(matching), ElementsAre(Edge{1, 2, 3}));
+}
+
+TEST(Suitor, IncreasingPath) {
+  // A path with increasing weights, where every vertex first proposes to its
+  // heavier neighbor.
+  auto graph = MakeGraph(
+      {{0, 1, 1}, {1, 2, 2}, {2, 3, 3}, {3, 4, 4}, {4, 5, 5}}, 6);
+  auto matching = WeightedMatching(graph);
+  EXPECT_THAT(ToVector(matching),
+              UnorderedElementsAreArray(std::vector<Edge>{
+                  {0, 1, 1}, {2, 3, 3}, {4, 5, 5}}));
+}
+
+TEST(Suitor, NonPositiveWeightsAreNotMatched) {
+  auto graph = MakeGraph({{0, 1, 0}, {1, 2, -2}, {2, 3, 4}}, 4);
+  auto matching = WeightedMatching(graph);
+  EXPECT_THAT(ToVector(matching), ElementsAre(Edge{2, 3, 4}));
+}
+
+TEST(Suitor, StarBMatching) {
+  // The center may take two edges and every leaf one.
+  auto graph = MakeGraph({{0, 1, 1}, {0, 2, 2}, {0, 3, 3}, {0, 4, 4}}, 5);
+  auto matching = WeightedBMatching(
+      graph, [](size_t v) -> uintE { return (v == 0) ? 2 : 1; });
+  EXPECT_THAT(ToVector(matching), UnorderedElementsAreArray(std::vector<Edge>{
+                                      {0, 3, 3}, {0, 4, 4}}));
+}
+
+TEST(Suitor, MatchesGreedy) {
+  // A graph with distinct pseudo-random weights.
+  constexpr uintE kNumVertices = 60;
+  std::vector<Edge> edges;
+  int next_weight = 0;
+  for (uintE u = 0; u < kNumVertices; u++) {
+    for (uintE step : {1, 5, 17}) {
+      uintE v = (u + step) % kNumVertices;
+      edges.push_back({u, v, 1 + (next_weight++ * 37) % 1000});
+    }
+  }
+  auto graph = MakeGraph(sequence<Edge>(edges.begin(), edges.end()),
+                         kNumVertices);
+  for (uintE b : {1, 2, 3}) {
+    auto matching =
+        WeightedBMatching(graph, [&](size_t v) -> uintE { return b; });
+    EXPECT_THAT(ToVector(matching),
+                UnorderedElementsAreArray(
+                    GreedyBMatching(edges, kNumVertices, b)))
+        << "b = " << b;
+  }
+}
+
+TEST(Suitor, UnweightedIsMaximal) {
+  // Graph diagram:
+  //     0 - 1    2 - 3 - 4
+  //                    \ |
+  //                      5 -- 6
+  constexpr uintE kNumVertices{7};
+  const std::unordered_set<UndirectedEdge> kEdges{
+      {0, 1}, {2, 3}, {3, 4}, {3, 5}, {4, 5}, {5, 6},
+  };
+  auto graph{graph_test::MakeUnweightedSymmetricGraph(kNumVertices, kEdges)};
+  auto matching = WeightedMatching(graph);
+  std::vector<int> matched(kNumVertices, 0);
+  for (const auto& [u, v, w] : matching) {
+    matched[u]++;
+    matched[v]++;
+  }
+  for (uintE v = 0; v < kNumVertices; v++) {
+    EXPECT_LE(matched[v], 1);
+  }
+  for (const auto& [u, v] :
+       std::vector<std::pair<uintE, uintE>>{{0, 1}, {2, 3}, {3, 4}, {3, 5},
+                                            {4, 5}, {5, 6}}) {
+    EXPECT_TRUE(matched[u] || matched[v]);
+  }
+}
+
+}  // namespace gbbs
@@ -30,13 +30,32 @@
 //      used by PageRankDelta only
 //     -damping_factor : the damping factor used in the PageRank updates (0.85
 //      by default)
+//     -em : use PageRank_edgeMap
+//     -blocked : use PageRank_blocked (propagation blocking)
+//     -bin_bytes : the size of the PageRank values accumulated by one bin;
+//      used by PageRank_blocked only
+//     -ppr : compute this many personalized PageRank vectors (seeded at
+//      vertices 0, 1, ...) with PersonalizedPageRank_batched
+//     -batch : the number of personalized PageRank vectors computed together;
+//      used with -ppr only
+//     -local : approximate the personalized PageRank vector of -src with
+//      LocalPersonalizedPageRank (forward push); -eps is the residual
+//      threshold per unit of degree
+//     -pull : use PageRank_pull
+//     -gs : use Gauss-Seidel iteration instead of Jacobi iteration; used with
+//      -pull only
+//     -float : store the PageRank vectors as floats; used with -pull only
 //     -c : indicate that the graph is compressed
 //     -m : indicate that the graph should be mmap'd
 //     -s : indicate that the graph is symmetric
 
 #include "PageRank.h"
+#include "PageRank_batched.h"
+#include "PageRank_blocked.h"
 #include "PageRank_delta.h"
 #include "PageRank_edgeMapReduce.h"
+#include "PageRank_pull.h"
+#include "PageRank_push.h"
 
 #include <cstddef>
 #include <iostream>
@@ -71,6 +90,37 @@ double PageRank_runner(Graph& G, commandLine P) {
   size_t iters = P.getOptionLongValue("-iters", 100);
   if (P.getOptionValue("-em")) {
     auto ret = PageRank_edgeMap(G, eps, /*sources=*/{}, damping_factor, iters);
+  } else if (P.getOptionValue("-blocked")) {
+    size_t bin_bytes = P.getOptionLongValue(
+        "-bin_bytes", BlockedSpMV<Graph>::kDefaultBinBytes);
+    auto ret = PageRank_blocked(G, eps, /*sources=*/{}, damping_factor, iters,
+                                /*report_progress=*/std::nullopt, bin_bytes);
+  } else if (P.getOptionValue("-pull")) {
+    PageRankIteration iteration = P.getOptionValue("-gs")
+                                      ? PageRankIteration::kGaussSeidel
+                                      : PageRankIteration::kJacobi;
+    if (P.getOptionValue("-float")) {
+      auto ret = PageRank_pull<float>(G, eps, /*sources=*/{}, damping_factor,
+                                      iters, iteration);
+    } else {
+      auto ret = PageRank_pull<double>(G, eps, /*sources=*/{}, damping_factor,
+                                       iters, iteration);
+    }
+  } else if (P.getOptionValue("-ppr")) {
+    // Personalized PageRank vectors seeded at vertices 0, 1, ...
+    size_t num_vectors = P.getOptionLongValue("-ppr", 64);
+    size_t batch_size = P.getOptionLongValue("-batch", 64);
+    std::vector<std::vector<uintE>> seed_sets(num_vectors);
+    for (size_t i = 0; i < num_vectors; i++) {
+      seed_sets[i] = {static_cast<uintE>(i % G.n)};
+    }
+    auto ret = PersonalizedPageRank_batched(G, seed_sets, eps, damping_factor,
+                                            iters, batch_size);
+  } else if (P.getOptionValue("-local")) {
+    uintE src = P.getOptionLongValue("-src", 0);
+    auto ret = LocalPersonalizedPageRank(G, std::vector<uintE>{src}, eps,
+                                         damping_factor);
+    std::cout << "### Support size: " << ret.size() << std::endl;
   } else if (P.getOptionValue("-delta")) {
     auto ret = delta::PageRankDelta(G, eps, local_eps, damping_factor, iters);
   } else {
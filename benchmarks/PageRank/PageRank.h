@@ -41,7 +41,9 @@
 // matrix-vector product works. We should carefully benchmark the two
 // implementations again, but from a few years ago (~2020), the PageRank code
 // was consistently faster than PageRank_edgeMap by 20--30% on the WDC2012
-// graph.
+// graph. PageRank_blocked (in PageRank_blocked.h) computes the same values as
+// PageRank_edgeMap, but uses propagation blocking for the matrix-vector
+// product to avoid random accesses to the PageRank vectors.
 
 #pragma once
 
@@ -0,0 +1,240 @@
+// This file provides a batched implementation of personalized PageRank (PPR)
+// that computes the PPR vectors of many seed sets at once. Please see
+// PageRank.h for comments that also apply to this file; for each seed set,
+// the result is the vector computed by PageRank_edgeMap with `sources` set to
+// the seed set.
+//
+// The k vectors of a batch are stored as k-wide rows (the k values of a
+// vertex are contiguous), and each iteration pulls the rows of the
+// in-neighbors of every vertex, so an edge is read once per iteration for all
+// vectors in the batch. Convergence is tracked per vector, and vectors that
+// have converged are dropped from the batch (the remaining columns are
+// compacted), so later iterations only pay for the vectors that are still
+// active.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "benchmarks/PageRank/PageRank.h"
+#include "gbbs/bridge.h"
+#include "gbbs/macros.h"
+#include "parlay/monoid.h"
+#include "parlay/sequence.h"
+
+namespace gbbs {
+
+namespace pagerank_batched_utils {
+
+// Number of vertices per block when reducing over k-wide rows.
+constexpr size_t kRowBlockSize = 2048;
+
+// Returns, for every column j < k of the n x k row-major matrix `rows`, the
+// sum of f(v, j, rows[v * k + j]) over the vertices v = ids(i), i < num_ids.
+template <class Ids, class F>
+sequence<double> ColumnSums(size_t num_ids, Ids ids, const double* rows,
+                            size_t k, F f) {
+  size_t num_blocks = (num_ids + kRowBlockSize - 1) / kRowBlockSize;
+  auto block_sums = sequence<double>(num_blocks * k, 0.0);
+  parallel_for(0, num_blocks, 1, [&](size_t b) {
+    double* sums = block_sums.begin() + b * k;
+    size_t end = std::min(num_ids, (b + 1) * kRowBlockSize);
+    for (size_t i = b * kRowBlockSize; i < end; i++) {
+      size_t v = ids(i);
+      const double* row = rows + v * k;
+      for (size_t j = 0; j < k; j++) {
+        sums[j] += f(v, j, row[j]);
+      }
+    }
+  });
+  auto sums = sequence<double>(k, 0.0);
+  for (size_t b = 0; b < num_blocks; b++) {
+    for (size_t j = 0; j < k; j++) {
+      sums[j] += block_sums[b * k + j];
+    }
+  }
+  return sums;
+}
+
+}  // namespace pagerank_batched_utils
+
+// Computes the personalized PageRank vector of every seed set in `seed_sets`,
+// processing at most `batch_size` seed sets at a time. An empty seed set
+// denotes the uniform distribution over all vertices (i.e., global PageRank),
+// and duplicate seeds are ignored. The result has one vector per seed set, in
+// the input order.
+//
+// The arguments `eps`, `damping_factor` and `max_iters` have the same meaning
+// as for PageRank_edgeMap and apply to every vector separately: a vector is
+// final once the L1 distance between two of its consecutive iterates is
+// smaller than `eps * (number of nodes in G)`, or after `max_iters`
+// iterations. The iterations pull over in-edges, so directed graphs must have
+// their in-edges materialized.
+template <class Graph>
+sequence<sequence<double>> PersonalizedPageRank_batched(
+    const Graph& G, const std::vector<std::vector<uintE>>& seed_sets,
+    double eps = 0.000001, double damping_factor = 0.85,
+    size_t max_iters = 100, size_t batch_size = 64) {
+  pagerank_utils::ValidatePageRankParameters(eps, damping_factor);
+  using W = typename Graph::weight_type;
+  const size_t n = G.n;
+  auto result = sequence<sequence<double>>(seed_sets.size());
+  if (n == 0 || seed_sets.empty()) return result;
+  batch_size = std::max<size_t>(batch_size, 1);
+
+  // The (weighted) out-degree of every vertex.
+  auto out_degrees = sequence<double>::from_function(n, [&](size_t i) {
+    if constexpr (pagerank_utils::IsWeighted<Graph>()) {
+      auto get_edge_weight = [](uintE unused_source_id,
+                                uintE unused_target_id, const W weight) {
+        return static_cast<double>(weight);
+      };
+      return G.get_vertex(i).out_neighbors().reduce(get_edge_weight,
+                                                    parlay::plus<double>());
+    } else {
+      return static_cast<double>(G.get_vertex(i).out_degree());
+    }
+  });
+  // Nodes with zero (weighted) out-degree.
+  auto dangling_nodes = parlay::pack_index<uintE>(parlay::delayed_seq<bool>(
+      n, [&](size_t i) { return out_degrees[i] == 0.0; }));
+  auto inv_degrees = sequence<double>::from_function(n, [&](size_t i) {
+    return (out_degrees[i] == 0.0) ? 0.0 : 1.0 / out_degrees[i];
+  });
+
+  for (size_t batch_start = 0; batch_start < seed_sets.size();
+       batch_start += batch_size) {
+    size_t batch_end = std::min(seed_sets.size(), batch_start + batch_size);
+    // ids[j] is the index (in seed_sets) of the vector in column j.
+    std::vector<size_t> ids;
+    std::vector<std::vector<uintE>> seeds;
+    for (size_t i = batch_start; i < batch_end; i++) {
+      ids.push_back(i);
+      auto seed_set = seed_sets[i];
+      std::sort(seed_set.begin(), seed_set.end());
+      seed_set.erase(std::unique(seed_set.begin(), seed_set.end()),
+                     seed_set.end());
+      seeds.push_back(std::move(seed_set));
+    }
+    size_t k = ids.size();
+
+    // Row-major n x k matrices holding the current and next iterates, and
+    // the mass that every vertex sends over an out-edge of unit weight.
+    auto p_curr = sequence<double>(n * k, 0.0);
+    auto p_next = sequence<double>::uninitialized(n * k);
+    auto p_div = sequence<double>::uninitialized(n * k);
+    for (size_t j = 0; j < k; j++) {
+      if (seeds[j].empty()) {
+        parallel_for(0, n, kDefaultGranularity,
+                     [&](size_t v) { p_curr[v * k + j] = 1.0 / n; });
+      } else {
+        for (uintE s : seeds[j]) p_curr[s * k + j] = 1.0 / seeds[j].size();
+      }
+    }
+
+    // Stores the vector in column j in the result.
+    auto emit = [&](size_t j) {
+      result[ids[j]] = sequence<double>::from_function(
+          n, [&](size_t v) { return p_curr[v * k + j]; });
+    };
+    if (max_iters == 0) {
+      for (size_t j = 0; j < k; j++) emit(j);
+      continue;
+    }
+
+    size_t iter = 0;
+    while (k > 0) {
+      gbbs_debug(timer t; t.start(););
+      auto dangling_sums = pagerank_batched_utils::ColumnSums(
+          dangling_nodes.size(), [&](size_t i) { return dangling_nodes[i]; },
+          p_curr.begin(), k, [](size_t v, size_t j, double x) { return x; });
+      parallel_for(0, n * k, kDefaultGranularity, [&](size_t i) {
+        p_div[i] = p_curr[i] * inv_degrees[i / k];
+      });
+
+      // SpMV over the in-edges, fused with damping and uniform teleportation.
+      auto teleport = sequence<double>::from_function(k, [&](size_t j) {
+        return seeds[j].empty()
+                   ? damping_factor * dangling_sums[j] / n +
+                         (1 - damping_factor) / n
+                   : 0.0;
+      });
+      parallel_for(0, n, [&](size_t v) {
+        double* row = p_next.begin() + v * k;
+        for (size_t j = 0; j < k; j++) row[j] = 0.0;
+        auto map_f = [&](const uintE& d, const uintE& s, const W& wgh) {
+          const double* src_row = p_div.begin() + s * k;
+          if constexpr (pagerank_utils::IsWeighted<Graph>()) {
+            double w = static_cast<double>(wgh);
+            for (size_t j = 0; j < k; j++) row[j] += src_row[j] * w;
+          } else {
+            for (size_t j = 0; j < k; j++) row[j] += src_row[j];
+          }
+        };
+        G.get_vertex(v).in_neighbors().map(map_f, /*parallel=*/false);
+        for (size_t j = 0; j < k; j++) {
+          row[j] = damping_factor * row[j] + teleport[j];
+        }
+      });
+      // Teleportation to the seeds.
+      parallel_for(0, k, 1, [&](size_t j) {
+        if (seeds[j].empty()) return;
+        double one_over_num_seeds = 1.0 / seeds[j].size();
+        double added = damping_factor * dangling_sums[j] * one_over_num_seeds +
+                       (1 - damping_factor) * one_over_num_seeds;
+        for (uintE s : seeds[j]) p_next[s * k + j] += added;
+      });
+
+      // Per-vector convergence: compute the L1-norm between the iterates.
+      auto L1_norms = pagerank_batched_utils::ColumnSums(
+          n, [](size_t i) { return i; }, p_curr.begin(), k,
+          [&](size_t v, size_t j, double x) {
+            return fabs(x - p_next[v * k + j]);
+          });
+      std::swap(p_curr, p_next);
+      iter++;
+
+      std::vector<size_t> active;
+      for (size_t j = 0; j < k; j++) {
+        if (L1_norms[j] < eps * n || iter >= max_iters) {
+          emit(j);
+        } else {
+          active.push_back(j);
+        }
+      }
+      gbbs_debug(std::cout << "iteration " << iter << ": active = "
+                           << active.size() << "/" << k << std::endl;
+                 t.stop(); t.next("iteration time"););
+      if (active.size() < k) {
+        // Drop the converged vectors by compacting the active columns.
+        size_t new_k = active.size();
+        auto compacted = sequence<double>::uninitialized(n * new_k);
+        parallel_for(0, n, kDefaultGranularity, [&](size_t v) {
+          for (size_t j = 0; j < new_k; j++) {
+            compacted[v * new_k + j] = p_curr[v * k + active[j]];
+          }
+        });
+        p_curr = std::move(compacted);
+        p_next = sequence<double>::uninitialized(n * new_k);
+        p_div = sequence<double>::uninitialized(n * new_k);
+        std::vector<size_t> new_ids;
+        std::vector<std::vector<uintE>> new_seeds;
+        for (size_t j : active) {
+          new_ids.push_back(ids[j]);
+          new_seeds.push_back(std::move(seeds[j]));
+        }
+        ids = std::move(new_ids);
+        seeds = std::move(new_seeds);
+        k = new_k;
+      }
+    }
+  }
+  return result;
+}
+
+}  // namespace gbbs
@@ -0,0 +1,165 @@
+// This file provides a PageRank implementation whose matrix-vector products
+// use propagation blocking (see gbbs/propagation_blocking.h) instead of
+// edgeMap. Please see PageRank.h for comments that also apply to this file;
+// PageRank_blocked computes the same values as PageRank_edgeMap.
+//
+// Each product streams over the out-edges of the graph, so the in-edges of
+// directed graphs do not need to be materialized. The random accesses of
+// PageRank_edgeMap to the n-sized vectors are replaced by sequential writes to
+// per-bin buffers and by accumulation into a cache-sized range of the output
+// vector, at the cost of m * (sizeof(uintE) + sizeof(double)) bytes of
+// buffers, which are allocated once.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <optional>
+#include <utility>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "benchmarks/PageRank/PageRank.h"
+#include "gbbs/bridge.h"
+#include "gbbs/helpers/progress_reporting.h"
+#include "gbbs/helpers/status_macros.h"
+#include "gbbs/macros.h"
+#include "gbbs/propagation_blocking.h"
+#include "parlay/monoid.h"
+#include "parlay/sequence.h"
+
+namespace gbbs {
+
+// Power iteration implementation of PageRank that computes the sparse
+// matrix-vector (SpMV) products with a BlockedSpMV engine. The arguments and
+// the convergence contract are the same as for PageRank_edgeMap. `bin_bytes`
+// is the size of the part of the PageRank vector accumulated by one bin, and
+// should be at most the size of the L2 cache.
+template <class Graph>
+absl::StatusOr<sequence<double>> PageRank_blocked(
+    const Graph& G, double eps = 0.000001, absl::Span<const uintE> sources = {},
+    double damping_factor = 0.85, size_t max_iters = 100,
+    std::optional<ReportProgressCallback> report_progress = std::nullopt,
+    size_t bin_bytes = BlockedSpMV<Graph>::kDefaultBinBytes) {
+  pagerank_utils::ValidatePageRankParameters(eps, damping_factor);
+  using W = typename Graph::weight_type;
+  const uintE n = G.n;
+  if (n == 0) {
+    if (report_progress.has_value()) (*report_progress)(1.0);
+    return sequence<double>();
+  }
+
+  double one_over_num_sources = 1 / (double)n;
+  // Current PageRank values.
+  sequence<double> p_curr;
+
+  absl::flat_hash_set<uintE> sources_set(sources.begin(), sources.end());
+  if (!sources.empty()) {
+    one_over_num_sources = 1 / (double)sources.size();
+    p_curr = parlay::sequence<double>(n);
+    parlay::parallel_for(0, sources.size(), [&](size_t i) {
+      p_curr[sources[i]] = one_over_num_sources;
+    });
+  } else {
+    p_curr = sequence<double>(n, one_over_num_sources);
+  }
+
+  // PageRank values for the next iteration.
+  auto p_next = sequence<double>(n, 0.0);
+
+  // The (weighted) out-degree of every vertex.
+  auto out_degrees = sequence<double>::from_function(n, [&](size_t i) {
+    if constexpr (pagerank_utils::IsWeighted<Graph>()) {
+      auto get_edge_weight = [](uintE unused_source_id,
+                                uintE unused_target_id, const W weight) {
+        return static_cast<double>(weight);
+      };
+      return G.get_vertex(i).out_neighbors().reduce(get_edge_weight,
+                                                    parlay::plus<double>());
+    } else {
+      return static_cast<double>(G.get_vertex(i).out_degree());
+    }
+  });
+  // Nodes with zero (weighted) out-degree.
+  parlay::sequence<uintE> dangling_nodes =
+      parlay::pack_index<uintE>(parlay::delayed_seq<bool>(
+          n, [&](size_t i) { return out_degrees[i] == 0.0; }));
+  // The mass sent over an out-edge of unit weight by every vertex.
+  auto p_div = sequence<double>(n, 0.0);
+
+  auto spmv = make_blocked_spmv(G, bin_bytes);
+  auto edge_f = [&](const uintE& s, const uintE& d, const W& wgh) -> double {
+    if constexpr (pagerank_utils::IsWeighted<Graph>()) {
+      return p_div[s] * static_cast<double>(wgh);
+    } else {
+      return p_div[s];
+    }
+  };
+
+  std::optional<gbbs::IterationProgressReporter> progress_reporter;
+  if (report_progress.has_value()) {
+    progress_reporter.emplace(
+        gbbs::IterationProgressReporter(*std::move(report_progress), max_iters,
+                                        /*has_preprocessing=*/true));
+    RETURN_IF_ERROR(progress_reporter->PreprocessingComplete());
+  }
+
+  for (size_t iter = 0; iter < max_iters; ++iter) {
+    gbbs_debug(timer t; t.start(););
+
+    // Sum of the PageRank values of the dangling nodes.
+    double dangling_sum = parlay::reduce(parlay::delayed_map(
+        dangling_nodes, [&](uintE v) { return p_curr[v]; }));
+    parallel_for(0, n, kDefaultGranularity, [&](size_t i) {
+      p_div[i] = (out_degrees[i] == 0.0) ? 0.0 : p_curr[i] / out_degrees[i];
+    });
+
+    // SpMV; overwrites p_next.
+    spmv.multiply(edge_f, p_next.begin());
+    if (sources.empty()) {
+      double added_constant = (1 - damping_factor) * one_over_num_sources;
+      parlay::parallel_for(0, n, [&](size_t i) {
+        p_next[i] += dangling_sum * one_over_num_sources;
+        p_next[i] = damping_factor * p_next[i] + added_constant;
+      });
+    } else {
+      double added_constant = (1 - damping_factor) * one_over_num_sources;
+      parlay::parallel_for(0, n, [&](size_t i) {
+        if (sources_set.contains(i)) {
+          p_next[i] += dangling_sum * one_over_num_sources;
+          p_next[i] = damping_factor * p_next[i] + added_constant;
+        } else {
+          p_next[i] = damping_factor * p_next[i];
+        }
+      });
+    }
+
+    // Check convergence: compute L1-norm between p_curr and p_next.
+    auto differences = parlay::delayed_seq<double>(
+        n, [&](size_t i) { return fabs(p_curr[i] - p_next[i]); });
+    double L1_norm = parlay::reduce(differences);
+
+    // Swap p_curr and p_next. The final vector returned will be p_curr.
+    std::swap(p_curr, p_next);
+    if (L1_norm < eps * n) {
+      if (progress_reporter.has_value()) {
+        RETURN_IF_ERROR(progress_reporter->IterationsDoneEarly());
+      }
+      break;
+    }
+
+    gbbs_debug(std::cout << "L1_norm = " << L1_norm << std::endl;);
+    gbbs_debug(t.stop(); t.next("iteration time"););
+    if (progress_reporter.has_value()) {
+      RETURN_IF_ERROR(progress_reporter->IterationComplete(iter));
+    }
+  }
+  gbbs_debug(auto max_pr = parlay::reduce_max(p_curr);
+             std::cout << "max_pr = " << max_pr << std::endl;);
+  return p_curr;
+}
+
+}  // namespace gbbs
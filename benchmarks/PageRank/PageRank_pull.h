@@ -0,0 +1,194 @@
+// This file provides a pull-based PageRank implementation with two optional
+// variations of the power iteration in PageRank.h. Please see PageRank.h for
+// comments that also apply to this file.
+//
+//  - Mixed precision: the PageRank vectors can be stored as `float`, which
+//    halves the memory traffic of an iteration. The contributions of the
+//    in-neighbors of a vertex, the dangling mass, and the L1 error are always
+//    accumulated in `double`.
+//  - Gauss-Seidel iteration: instead of computing a new vector from the
+//    previous one (Jacobi iteration, as in PageRank_edgeMap), the vector is
+//    updated in place. The vertices are split into blocks of consecutive
+//    vertices; blocks are processed in parallel and the vertices of a block
+//    in order, so a vertex sees the new values of the earlier vertices of its
+//    block and, asynchronously, whatever values other blocks have written so
+//    far. Gauss-Seidel typically needs substantially fewer iterations, but
+//    its results depend on the schedule.
+//
+// The convergence contract is the same as for PageRank_edgeMap: the algorithm
+// stops when the L1 distance between the vectors before and after an
+// iteration is smaller than `eps * (number of nodes in G)`, or after
+// `max_iters` iterations.
+//
+// Every iteration pulls over the in-edges of every vertex, so directed graphs
+// must have their in-edges materialized.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <optional>
+#include <utility>
+
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "benchmarks/PageRank/PageRank.h"
+#include "gbbs/bridge.h"
+#include "gbbs/helpers/progress_reporting.h"
+#include "gbbs/helpers/status_macros.h"
+#include "gbbs/macros.h"
+#include "parlay/monoid.h"
+#include "parlay/sequence.h"
+
+namespace gbbs {
+
+enum class PageRankIteration { kJacobi, kGaussSeidel };
+
+namespace pagerank_pull_utils {
+
+// Number of consecutive vertices per block.
+constexpr size_t kBlockSize = 1024;
+
+}  // namespace pagerank_pull_utils
+
+// Pull-based power iteration implementation of PageRank that stores its
+// vectors as `Storage` (float or double) and uses the given iteration scheme.
+// The remaining arguments are the same as for PageRank_edgeMap.
+template <class Storage = double, class Graph>
+absl::StatusOr<sequence<double>> PageRank_pull(
+    const Graph& G, double eps = 0.000001, absl::Span<const uintE> sources = {},
+    double damping_factor = 0.85, size_t max_iters = 100,
+    PageRankIteration iteration = PageRankIteration::kJacobi,
+    std::optional<ReportProgressCallback> report_progress = std::nullopt) {
+  static_assert(std::is_floating_point_v<Storage>);
+  pagerank_utils::ValidatePageRankParameters(eps, damping_factor);
+  using W = typename Graph::weight_type;
+  const uintE n = G.n;
+  if (n == 0) {
+    if (report_progress.has_value()) (*report_progress)(1.0);
+    return sequence<double>();
+  }
+
+  // Teleportation targets. With no sources, every node is a target.
+  auto is_source = sequence<bool>(n, sources.empty());
+  double one_over_num_sources = 1 / (double)n;
+  sequence<Storage> p_curr;
+  if (!sources.empty()) {
+    one_over_num_sources = 1 / (double)sources.size();
+    p_curr = sequence<Storage>(n, Storage{0});
+    parlay::parallel_for(0, sources.size(), [&](size_t i) {
+      is_source[sources[i]] = true;
+      p_curr[sources[i]] = one_over_num_sources;
+    });
+  } else {
+    p_curr = sequence<Storage>(n, one_over_num_sources);
+  }
+
+  // The inverse of the (weighted) out-degree of every vertex, or zero for
+  // nodes with zero (weighted) out-degree.
+  auto inv_out_degrees = sequence<double>::from_function(n, [&](size_t i) {
+    double degree;
+    if constexpr (pagerank_utils::IsWeighted<Graph>()) {
+      auto get_edge_weight = [](uintE unused_source_id,
+                                uintE unused_target_id, const W weight) {
+        return static_cast<double>(weight);
+      };
+      degree = G.get_vertex(i).out_neighbors().reduce(get_edge_weight,
+                                                      parlay::plus<double>());
+    } else {
+      degree = G.get_vertex(i).out_degree();
+    }
+    return (degree == 0.0) ? 0.0 : 1.0 / degree;
+  });
+  parlay::sequence<uintE> dangling_nodes =
+      parlay::pack_index<uintE>(parlay::delayed_seq<bool>(
+          n, [&](size_t i) { return inv_out_degrees[i] == 0.0; }));
+  // The mass that every vertex sends over an out-edge of unit weight.
+  auto p_div = sequence<Storage>::from_function(
+      n, [&](size_t i) { return Storage(p_curr[i] * inv_out_degrees[i]); });
+  // Only used by the Jacobi iteration.
+  sequence<Storage> p_next;
+  if (iteration == PageRankIteration::kJacobi) {
+    p_next = sequence<Storage>::uninitialized(n);
+  }
+
+  constexpr size_t kBlockSize = pagerank_pull_utils::kBlockSize;
+  size_t num_blocks = (n + kBlockSize - 1) / kBlockSize;
+  auto block_errors = sequence<double>(num_blocks);
+
+  std::optional<gbbs::IterationProgressReporter> progress_reporter;
+  if (report_progress.has_value()) {
+    progress_reporter.emplace(
+        gbbs::IterationProgressReporter(*std::move(report_progress), max_iters,
+                                        /*has_preprocessing=*/true));
+    RETURN_IF_ERROR(progress_reporter->PreprocessingComplete());
+  }
+
+  for (size_t iter = 0; iter < max_iters; ++iter) {
+    gbbs_debug(timer t; t.start(););
+
+    // Sum of the PageRank values of the dangling nodes.
+    double dangling_sum = parlay::reduce(parlay::delayed_map(
+        dangling_nodes, [&](uintE v) { return double{p_curr[v]}; }));
+    double teleport = damping_factor * dangling_sum * one_over_num_sources +
+                      (1 - damping_factor) * one_over_num_sources;
+
+    // Returns the new PageRank value of v given the current values of p_div.
+    auto new_value = [&](uintE v) -> double {
+      double contribution = 0;
+      auto map_f = [&](const uintE& d, const uintE& s, const W& wgh) {
+        if constexpr (pagerank_utils::IsWeighted<Graph>()) {
+          contribution += p_div[s] * static_cast<double>(wgh);
+        } else {
+          contribution += p_div[s];
+        }
+      };
+      G.get_vertex(v).in_neighbors().map(map_f, /*parallel=*/false);
+      return damping_factor * contribution + (is_source[v] ? teleport : 0.0);
+    };
+
+    parallel_for(0, num_blocks, 1, [&](size_t b) {
+      size_t start = b * kBlockSize;
+      size_t end = std::min<size_t>(n, start + kBlockSize);
+      double error = 0;
+      for (size_t v = start; v < end; v++) {
+        Storage value = static_cast<Storage>(new_value(v));
+        error += fabs(double{value} - double{p_curr[v]});
+        if (iteration == PageRankIteration::kGaussSeidel) {
+          p_curr[v] = value;
+          p_div[v] = static_cast<Storage>(value * inv_out_degrees[v]);
+        } else {
+          p_next[v] = value;
+        }
+      }
+      block_errors[b] = error;
+    });
+    if (iteration == PageRankIteration::kJacobi) {
+      std::swap(p_curr, p_next);
+      parallel_for(0, n, kDefaultGranularity, [&](size_t i) {
+        p_div[i] = static_cast<Storage>(p_curr[i] * inv_out_degrees[i]);
+      });
+    }
+
+    // Check convergence: the L1-norm between the previous and new values.
+    double L1_norm = parlay::reduce(block_errors);
+    if (L1_norm < eps * n) {
+      if (progress_reporter.has_value()) {
+        RETURN_IF_ERROR(progress_reporter->IterationsDoneEarly());
+      }
+      break;
+    }
+
+    gbbs_debug(std::cout << "L1_norm = " << L1_norm << std::endl;);
+    gbbs_debug(t.stop(); t.next("iteration time"););
+    if (progress_reporter.has_value()) {
+      RETURN_IF_ERROR(progress_reporter->IterationComplete(iter));
+    }
+  }
+  return sequence<double>::from_function(
+      n, [&](size_t i) { return double{p_curr[i]}; });
+}
+
+}  // namespace gbbs
@@ -0,0 +1,190 @@
+// This file provides a local approximation of personalized PageRank (PPR)
+// based on the forward push algorithm of Andersen, Chung, and Lang ("Local
+// Graph Partitioning using PageRank Vectors", FOCS'06), parallelized as in
+// "Parallel Local Graph Clustering" by Shun, Roosta-Khorasani, Fountoulakis,
+// and Mahoney (VLDB'16).
+//
+// Every vertex v has an estimate p[v] and a residual r[v]. Initially, the
+// residual mass is spread uniformly over the sources. A vertex is active if
+// r[v] >= eps * deg(v). In each round, every active vertex v (in parallel)
+// moves (1 - damping_factor) * r[v] into p[v] and sends the remaining
+// damping_factor * r[v] evenly to its out-neighbors (vertices without
+// out-edges send it to the sources, as in PageRank.h). The algorithm stops
+// when no vertex is active. Let ppr be the vector computed by
+// PageRank_edgeMap with the same sources; then p <= ppr, and on undirected
+// graphs ppr[v] - p[v] <= eps * deg(v) for every vertex v. Edge weights are
+// ignored.
+//
+// Every push removes at least (1 - damping_factor) * eps mass of residual, so
+// the number of pushes, and the number of vertices with non-zero estimates or
+// residuals, is at most 1 / ((1 - damping_factor) * eps). Estimates and
+// residuals are stored in hash tables of this size, and frontiers are sparse
+// vertexSubsets, so the work of a query is independent of n.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+#include "absl/types/span.h"
+#include "benchmarks/PageRank/PageRank.h"
+#include "gbbs/bridge.h"
+#include "gbbs/edge_map_data.h"
+#include "gbbs/flags.h"
+#include "gbbs/helpers/assert.h"
+#include "gbbs/helpers/sparse_additive_map.h"
+#include "gbbs/macros.h"
+#include "gbbs/vertex_subset.h"
+#include "parlay/sequence.h"
+
+namespace gbbs {
+namespace push {
+
+using sparse_vector = sparse_additive_map<uintE, double>;
+
+// edgeMap struct that sends the share of every frontier vertex `s` (stored in
+// `shares`) to its out-neighbors. Returns true for a neighbor if its residual
+// is at least its activation threshold after the update; the update that
+// completes last sees the final residual, so every vertex that becomes active
+// is returned at least once.
+template <class Graph>
+struct Push_F {
+  using W = typename Graph::weight_type;
+  const Graph& G;
+  sparse_vector* shares;
+  sparse_vector* residuals;
+  double eps;
+
+  Push_F(const Graph& G, sparse_vector* shares, sparse_vector* residuals,
+         double eps)
+      : G(G), shares(shares), residuals(residuals), eps(eps) {}
+
+  inline bool update(const uintE& s, const uintE& d, const W& wgh) {
+    return updateAtomic(s, d, wgh);
+  }
+
+  inline bool updateAtomic(const uintE& s, const uintE& d, const W& wgh) {
+    residuals->insert(std::make_tuple(d, shares->find(s)));
+    return residuals->find(d) >= threshold(G, d, eps);
+  }
+
+  inline bool cond(const uintE& d) const { return true; }
+
+  static double threshold(const Graph& G, uintE v, double eps) {
+    return eps * std::max<double>(G.get_vertex(v).out_degree(), 1);
+  }
+};
+
+// Removes duplicates from vs using a hash table of size |vs|.
+inline sequence<uintE> RemoveDuplicates(const sequence<uintE>& vs) {
+  if (vs.size() == 0) return sequence<uintE>();
+  auto table = sparse_additive_map<uintE, uintE>(
+      vs.size(), std::make_tuple(UINT_E_MAX, uintE{0}));
+  auto first = sequence<bool>::from_function(vs.size(), [&](size_t i) {
+    return table.insert(std::make_tuple(vs[i], uintE{1}));
+  });
+  table.del();
+  return parlay::pack(vs, first);
+}
+
+}  // namespace push
+
+// Returns the (vertex, estimate) pairs with non-zero estimates of the forward
+// push approximation of the PPR vector of `sources`, sorted by vertex id.
+// `sources` must be non-empty. `damping_factor` has the same meaning as for
+// PageRank_edgeMap, and `eps` > 0 is the residual threshold per unit of
+// degree. At most `max_rounds` rounds of pushes are run.
+template <class Graph>
+sequence<std::pair<uintE, double>> LocalPersonalizedPageRank(
+    const Graph& G, absl::Span<const uintE> sources, double eps = 0.000001,
+    double damping_factor = 0.85,
+    size_t max_rounds = std::numeric_limits<size_t>::max()) {
+  pagerank_utils::ValidatePageRankParameters(eps, damping_factor);
+  ASSERT(eps > 0.0);
+  ASSERT(!sources.empty());
+  using push::sparse_vector;
+  const size_t n = G.n;
+  const double alpha = 1 - damping_factor;
+  const auto empty = std::make_tuple(UINT_E_MAX, 0.0);
+
+  auto seeds = push::RemoveDuplicates(
+      sequence<uintE>(sources.begin(), sources.end()));
+  const double one_over_num_seeds = 1.0 / seeds.size();
+  // Bound on the number of vertices with a non-zero estimate or residual.
+  double max_entries = std::ceil(1 / (alpha * eps)) + seeds.size();
+  size_t capacity = static_cast<size_t>(
+      std::min(max_entries, static_cast<double>(n)));
+  auto estimates = sparse_vector(capacity, empty);
+  auto residuals = sparse_vector(capacity, empty);
+
+  parallel_for(0, seeds.size(), [&](size_t i) {
+    residuals.insert(std::make_tuple(seeds[i], one_over_num_seeds));
+  });
+  auto frontier = parlay::filter(seeds, [&](uintE v) {
+    return residuals.find(v) >= push::Push_F<Graph>::threshold(G, v, eps);
+  });
+
+  size_t rounds = 0, pushes = 0;
+  while (frontier.size() > 0 && rounds < max_rounds) {
+    rounds++;
+    pushes += frontier.size();
+    // Move the residuals of the frontier into the estimates and the shares.
+    auto shares = sparse_vector(frontier.size(), empty);
+    auto residual_of = sequence<double>::from_function(
+        frontier.size(), [&](size_t i) { return residuals.find(frontier[i]); });
+    parallel_for(0, frontier.size(), [&](size_t i) {
+      uintE v = frontier[i];
+      double r = residual_of[i];
+      residuals.insert(std::make_tuple(v, -r));
+      estimates.insert(std::make_tuple(v, alpha * r));
+      uintE degree = G.get_vertex(v).out_degree();
+      shares.insert(std::make_tuple(
+          v, (degree == 0) ? damping_factor * r : damping_factor * r / degree));
+    });
+
+    // Mass of frontier vertices without out-edges goes to the seeds.
+    auto dangling = parlay::filter(
+        frontier, [&](uintE v) { return G.get_vertex(v).out_degree() == 0; });
+    sequence<uintE> activated_seeds;
+    if (dangling.size() > 0) {
+      double dangling_mass = parlay::reduce(parlay::delayed_map(
+          dangling, [&](uintE v) { return shares.find(v); }));
+      parallel_for(0, seeds.size(), [&](size_t i) {
+        residuals.insert(
+            std::make_tuple(seeds[i], dangling_mass * one_over_num_seeds));
+      });
+      activated_seeds = parlay::filter(seeds, [&](uintE v) {
+        return residuals.find(v) >= push::Push_F<Graph>::threshold(G, v, eps);
+      });
+    }
+
+    auto vs = vertexSubset(n, std::move(frontier));
+    auto output = edgeMap(
+        G, vs, push::Push_F<Graph>(G, &shares, &residuals, eps), -1, no_dense);
+    output.toSparse();
+    auto candidates = std::move(output.s);
+    candidates.append(make_slice(activated_seeds));
+    frontier = push::RemoveDuplicates(candidates);
+    shares.del();
+  }
+  gbbs_debug(std::cout << "# local ppr rounds = " << rounds
+                       << " pushes = " << pushes << std::endl;);
+
+  auto entries = estimates.entries();
+  estimates.del();
+  residuals.del();
+  auto result = sequence<std::pair<uintE, double>>::from_function(
+      entries.size(), [&](size_t i) {
+        return std::make_pair(std::get<0>(entries[i]),
+                              std::get<1>(entries[i]));
+      });
+  parlay::sort_inplace(make_slice(result));
+  return result;
+}
+
+}  // namespace gbbs
@@ -12,7 +12,11 @@
 #include "absl/status/statusor.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "benchmarks/PageRank/PageRank_batched.h"
+#include "benchmarks/PageRank/PageRank_blocked.h"
 #include "benchmarks/PageRank/PageRank_edgeMapReduce.h"
+#include "benchmarks/PageRank/PageRank_pull.h"
+#include "benchmarks/PageRank/PageRank_push.h"
 #include "gbbs/bridge.h"
 #include "gbbs/graph.h"
 #include "gbbs/helpers/progress_reporting.h"
@@ -53,6 +57,31 @@ struct PageRank_edgeMapReduceFunctor {
   }
 };
 
+// Uses bins of two vertices so that the small test graphs span several bins.
+struct PageRank_blockedFunctor {
+  template <class Graph>
+  static absl::StatusOr<sequence<double>> compute_pagerank(
+      Graph& G, double eps = 0.000001, std::vector<uintE> sources = {},
+      double damping_factor = 0.85, size_t max_iters = 100,
+      std::optional<ReportProgressCallback> report_progress = std::nullopt) {
+    return PageRank_blocked(G, eps, sources, damping_factor, max_iters,
+                            std::move(report_progress),
+                            /*bin_bytes=*/2 * sizeof(double));
+  }
+};
+
+struct PageRank_pullFunctor {
+  template <class Graph>
+  static absl::StatusOr<sequence<double>> compute_pagerank(
+      Graph& G, double eps = 0.000001, std::vector<uintE> sources = {},
+      double damping_factor = 0.85, size_t max_iters = 100,
+      std::optional<ReportProgressCallback> report_progress = std::nullopt) {
+    return PageRank_pull<double>(G, eps, sources, damping_factor, max_iters,
+                                 PageRankIteration::kJacobi,
+                                 std::move(report_progress));
+  }
+};
+
 template <typename T>
 class PageRankFixture : public testing::Test, public ReportProgressMock {
  public:
@@ -60,7 +89,8 @@ class PageRankFixture : public testing::Test, public ReportProgressMock {
 };
 
 using Implementations =
-    ::testing::Types<PageRank_edgeMapFunctor, PageRank_edgeMapReduceFunctor>;
+    ::testing::Types<PageRank_edgeMapFunctor, PageRank_edgeMapReduceFunctor,
+                     PageRank_blockedFunctor, PageRank_pullFunctor>;
 TYPED_TEST_SUITE(PageRankFixture, Implementations);
 
 TYPED_TEST(PageRankFixture, EmptyGraph) {
@@ -383,6 +413,125 @@ TYPED_TEST(PageRankFixture, FourNodePathOneSource) {
   }
 }
 
+// Gauss-Seidel iteration and float storage converge to the same values as
+// the Jacobi iteration with double storage.
+TEST(PageRankPullTest, GaussSeidelAndMixedPrecision) {
+  // Graph diagram:
+  //     0 - 1    2 - 3 - 4
+  //                    \ |
+  //                      5 -- 6
+  constexpr uintE kNumVertices{7};
+  const std::unordered_set<UndirectedEdge> kEdges{
+      {0, 1}, {2, 3}, {3, 4}, {3, 5}, {4, 5}, {5, 6},
+  };
+  auto graph{graph_test::MakeUnweightedSymmetricGraph(kNumVertices, kEdges)};
+  // See BasicUndirected.
+  const std::vector<double> expected{0.1428571429, 0.1428571429, 0.0802049539,
+                                     0.2074472351, 0.1389813363, 0.2074472351,
+                                     0.0802049539};
+
+  for (auto iteration :
+       {PageRankIteration::kJacobi, PageRankIteration::kGaussSeidel}) {
+    EXPECT_THAT(PageRank_pull<double>(graph, /*eps=*/1e-7, /*sources=*/{},
+                                      /*damping_factor=*/0.85,
+                                      /*max_iters=*/100, iteration),
+                IsOkAndHolds(Pointwise(DoubleNear(1e-4), expected)));
+    EXPECT_THAT(PageRank_pull<float>(graph, /*eps=*/1e-7, /*sources=*/{},
+                                     /*damping_factor=*/0.85,
+                                     /*max_iters=*/100, iteration),
+                IsOkAndHolds(Pointwise(DoubleNear(1e-4), expected)));
+  }
+}
+
+TEST(PersonalizedPageRankBatchedTest, FourNodePath) {
+  // Graph diagram:
+  //     0 - 1 - 2 - 3
+  constexpr uintE kNumVertices{4};
+  const std::unordered_set<UndirectedEdge> kEdges{{0, 1}, {1, 2}, {2, 3}};
+  auto graph{graph_test::MakeUnweightedSymmetricGraph(kNumVertices, kEdges)};
+
+  // See FourNodePathOneSource for the derivation of the expected values. The
+  // seed sets {0, 1, 2, 3} and {} both give global PageRank.
+  const sequence<double> expected_all{0.17543856058862931, 0.32456143941137061,
+                                      0.32456143941137061, 0.17543856058862931};
+  const sequence<double> expected_0{0.3022241274, 0.3581756964, 0.2383155317,
+                                    0.1012846445};
+  const sequence<double> expected_03{0.2017542424, 0.2982457576, 0.2982457576,
+                                     0.2017542424};
+  const std::vector<std::vector<uintE>> seed_sets{
+      {0}, {0, 1, 2, 3}, {3, 0}, {}, {0, 0}};
+  // A batch size of 2 splits the seed sets over three batches.
+  for (size_t batch_size : {1, 2, 64}) {
+    auto result = PersonalizedPageRank_batched(
+        graph, seed_sets, /*eps=*/0.000001, /*damping_factor=*/0.85,
+        /*max_iters=*/100, batch_size);
+    ASSERT_EQ(result.size(), seed_sets.size());
+    EXPECT_THAT(result[0], Pointwise(DoubleNear(1e-4), expected_0));
+    EXPECT_THAT(result[1], Pointwise(DoubleNear(1e-4), expected_all));
+    EXPECT_THAT(result[2], Pointwise(DoubleNear(1e-4), expected_03));
+    EXPECT_THAT(result[3], Pointwise(DoubleNear(1e-4), expected_all));
+    EXPECT_THAT(result[4], Pointwise(DoubleNear(1e-4), expected_0));
+  }
+}
+
+TEST(PersonalizedPageRankBatchedTest, ZeroIterations) {
+  // Graph diagram:
+  //     0 - 1 - 2
+  constexpr uintE kNumVertices{3};
+  const std::unordered_set<UndirectedEdge> kEdges{{0, 1}, {1, 2}};
+  auto graph{graph_test::MakeUnweightedSymmetricGraph(kNumVertices, kEdges)};
+
+  auto result = PersonalizedPageRank_batched(graph, {{1}, {0, 2}},
+                                             /*eps=*/0.1,
+                                             /*damping_factor=*/0.85,
+                                             /*max_iters=*/0);
+  ASSERT_EQ(result.size(), 2);
+  EXPECT_THAT(result[0], ElementsAre(0.0, 1.0, 0.0));
+  EXPECT_THAT(result[1], ElementsAre(0.5, 0.0, 0.5));
+}
+
+TEST(LocalPersonalizedPageRankTest, FourNodePath) {
+  // Graph diagram:
+  //     0 - 1 - 2 - 3
+  constexpr uintE kNumVertices{4};
+  const std::unordered_set<UndirectedEdge> kEdges{{0, 1}, {1, 2}, {2, 3}};
+  auto graph{graph_test::MakeUnweightedSymmetricGraph(kNumVertices, kEdges)};
+
+  // See FourNodePathOneSource for the derivation of the expected values.
+  auto result = LocalPersonalizedPageRank(graph, std::vector<uintE>{0},
+                                          /*eps=*/1e-9);
+  ASSERT_EQ(result.size(), 4);
+  const std::vector<double> expected{0.3022241274, 0.3581756964, 0.2383155317,
+                                     0.1012846445};
+  for (size_t i = 0; i < result.size(); i++) {
+    EXPECT_EQ(result[i].first, i);
+    EXPECT_NEAR(result[i].second, expected[i], 1e-4);
+  }
+
+  // With a coarse threshold, the push stays local: vertex 3 is never reached,
+  // and no estimate exceeds the exact value.
+  auto coarse = LocalPersonalizedPageRank(graph, std::vector<uintE>{0},
+                                          /*eps=*/0.2);
+  for (const auto& [v, estimate] : coarse) {
+    EXPECT_NE(v, 3);
+    EXPECT_LE(estimate, expected[v] + 1e-9);
+  }
+}
+
+TEST(LocalPersonalizedPageRankTest, DanglingMassReturnsToSources) {
+  constexpr uintE kNumVertices{3};
+  const std::unordered_set<UndirectedEdge> kEdges{};
+  auto graph{graph_test::MakeUnweightedSymmetricGraph(kNumVertices, kEdges)};
+
+  auto result = LocalPersonalizedPageRank(graph, std::vector<uintE>{0, 2},
+                                          /*eps=*/1e-9);
+  ASSERT_EQ(result.size(), 2);
+  EXPECT_EQ(result[0].first, 0);
+  EXPECT_NEAR(result[0].second, 0.5, 1e-6);
+  EXPECT_EQ(result[1].first, 2);
+  EXPECT_NEAR(result[1].second, 0.5, 1e-6);
+}
+
 class PageRankEdgeMapFunctorTest : public testing::Test,
                                    public ReportProgressMock {};
 
@@ -415,11 +564,13 @@ TEST_F(PageRankEdgeMapFunctorTest, WeightedDigraph) {
   // P[2] = (0.15 + 0.85 * P[4]) / 5
   // P[3] = (0.15 + 0.85 * P[4]) / 5 + 0.85 * (P[1] * 3/8)
   // P[4] = (0.15 + 0.85 * P[4]) / 5 + 0.85 * (P[1] * 5/8)
+  const std::vector<double> expected{2333.0 / 30348.0, 11360.0 / 30348.0,
+                                     2333.0 / 30348.0, 5954.0 / 30348.0,
+                                     8368.0 / 30348.0};
   EXPECT_THAT(PageRank_edgeMapFunctor::compute_pagerank(graph),
-              IsOkAndHolds(Pointwise(
-                  DoubleNear(1e-4),
-                  {2333.0 / 30348.0, 11360.0 / 30348.0, 2333.0 / 30348.0,
-                   5954.0 / 30348.0, 8368.0 / 30348.0})));
+              IsOkAndHolds(Pointwise(DoubleNear(1e-4), expected)));
+  EXPECT_THAT(PageRank_blockedFunctor::compute_pagerank(graph),
+              IsOkAndHolds(Pointwise(DoubleNear(1e-4), expected)));
 }
 
 // Tests the case where a node (in this case, node 2) does have some outgoing
@@ -452,10 +603,12 @@ TEST_F(PageRankEdgeMapFunctorTest, NodeWithAllOutgoingEdgesHavingZeroWeight) {
   // P[1] = (0.15 + 0.85 * P[2] + 0.85 * P[3]) / 4 + 0.85 * (P[0] * 2/3)
   // P[2] = (0.15 + 0.85 * P[2] + 0.85 * P[3]) / 4 + 0.85 * (P[1] * 1/1)
   // P[3] = (0.15 + 0.85 * P[2] + 0.85 * P[3]) / 4 + 0.85 * (P[0] * 1/3)
+  const std::vector<double> expected{600.0 / 3709.0, 940.0 / 3709.0,
+                                     1399.0 / 3709.0, 770.0 / 3709.0};
   EXPECT_THAT(PageRank_edgeMapFunctor::compute_pagerank(graph),
-              IsOkAndHolds(Pointwise(DoubleNear(1e-4),
-                                     {600.0 / 3709.0, 940.0 / 3709.0,
-                                      1399.0 / 3709.0, 770.0 / 3709.0})));
+              IsOkAndHolds(Pointwise(DoubleNear(1e-4), expected)));
+  EXPECT_THAT(PageRank_blockedFunctor::compute_pagerank(graph),
+              IsOkAndHolds(Pointwise(DoubleNear(1e-4), expected)));
 }
 
 template <typename T>
@@ -0,0 +1,80 @@
+// Usage:
+// numactl -i all ./BidirectionalSearch -src 10012 -dst 5 -s -m -rounds 3
+//     twitter_SJ
+// flags:
+//   optional:
+//     -src : the source of the query
+//     -dst : the target of the query
+//     -queries : the number of random s-t queries to run after the -src -dst
+//                query (they reuse the state of the engine)
+//     -delta : the width of a bucket; the mean edge weight if omitted
+//     -rounds : the number of times to run the algorithm
+//     -c : indicate that the graph is compressed
+//     -m : indicate that the graph should be mmap'd
+//     -s : indicate that the graph is symmetric
+//
+// The binary built with -DUSE_WEIGHTS reads graphs with integer edge weights.
+
+#include "BidirectionalSearch.h"
+
+namespace gbbs {
+
+template <class Graph>
+double BidirectionalSearch_runner(Graph& G, commandLine P) {
+  uintE src = static_cast<uintE>(P.getOptionLongValue("-src", 0));
+  uintE dst = static_cast<uintE>(P.getOptionLongValue("-dst", 0));
+  size_t num_queries = P.getOptionLongValue("-queries", 0);
+  double delta = P.getOptionDoubleValue("-delta", 0);
+
+  std::cout << "### Application: BidirectionalSearch" << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -src = " << src << " -dst = " << dst
+            << " -queries = " << num_queries << " -delta = " << delta
+            << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+
+  auto engine = bidirectional::make_bidirectional_engine(G, delta);
+  using Distance = typename decltype(engine)::Distance;
+  constexpr Distance kMaxDistance = std::numeric_limits<Distance>::max();
+
+  timer t;
+  t.start();
+  auto dist = engine.Query(src, dst);
+  if (dist == kMaxDistance) {
+    std::cout << "### " << dst << " is not reachable from " << src
+              << std::endl;
+  } else {
+    std::cout << "### Distance: " << dist << std::endl;
+  }
+  std::cout << "### Explored: " << engine.explored << std::endl;
+
+  auto r = parlay::random(src);
+  size_t reached = 0, explored = 0;
+  for (size_t i = 0; i < num_queries; i++) {
+    uintE s = r.ith_rand(2 * i) % G.n;
+    uintE d = r.ith_rand(2 * i + 1) % G.n;
+    reached += (engine.Query(s, d) != kMaxDistance);
+    explored += engine.explored;
+  }
+  double tt = t.stop();
+  if (num_queries > 0) {
+    std::cout << "### Random queries: reachable = " << reached
+              << " average explored = "
+              << static_cast<double>(explored) / num_queries
+              << " average time = " << tt / (num_queries + 1) << std::endl;
+  }
+
+  std::cout << "### Running Time: " << tt << std::endl;
+  return tt;
+}
+
+}  // namespace gbbs
+
+#ifdef USE_WEIGHTS
+generate_weighted_main(gbbs::BidirectionalSearch_runner, false);
+#else
+generate_main(gbbs::BidirectionalSearch_runner, false);
+#endif
@@ -0,0 +1,254 @@
+// This file provides an engine for point-to-point (s-t) shortest path queries
+// on graphs with non-negative edge weights (unweighted graphs use unit
+// weights). A query runs two searches, a forward search from s over
+// out-edges and a backward search from t over in-edges. Each search settles
+// vertices one bucket of width delta at a time, as in delta-stepping, and
+// every step advances the side whose next bucket has the smaller volume (sum
+// of degrees). Whenever an edge (u, v) is relaxed and v has been reached by
+// the other side, the length of the s-t path through (u, v) is a candidate
+// for the answer. The query stops once the smallest tentative distances of
+// the two sides sum to at least the best candidate, or once either side runs
+// out of vertices (in which case t is unreachable from s, or the best
+// candidate is already optimal).
+//
+// All per-vertex state is allocated once when the engine is built. A query
+// records every vertex that it reaches, and only these vertices are reset
+// before the next query, so a query that explores a small part of the graph
+// does O(explored) work.
+
+#pragma once
+
+#include "gbbs/gbbs.h"
+
+namespace gbbs {
+namespace bidirectional {
+
+template <class W, class Distance>
+struct Bidirectional_F {
+  static constexpr Distance kMaxDistance = std::numeric_limits<Distance>::max();
+
+  Distance* dist;
+  Distance* other_dist;
+  Distance* best;
+
+  Bidirectional_F(Distance* dist, Distance* other_dist, Distance* best)
+      : dist(dist), other_dist(other_dist), best(best) {}
+
+  static Distance weight_of(const W& w) {
+    if constexpr (std::is_same<W, gbbs::empty>()) {
+      return 1;
+    } else {
+      return w;
+    }
+  }
+
+  inline bool update(const uintE& s, const uintE& d, const W& w) {
+    return updateAtomic(s, d, w);
+  }
+
+  inline bool updateAtomic(const uintE& s, const uintE& d, const W& w) {
+    Distance n_dist = dist[s] + weight_of(w);
+    Distance other = other_dist[d];
+    if (other != kMaxDistance) {
+      gbbs::write_min(best, n_dist + other);
+    }
+    return gbbs::write_min(&dist[d], n_dist);
+  }
+
+  inline bool cond(const uintE& d) const { return true; }
+};
+
+template <class Graph>
+struct BidirectionalEngine {
+  using W = typename Graph::weight_type;
+  using Distance =
+      typename std::conditional<std::is_same<W, gbbs::empty>::value, uintE,
+                                W>::type;
+  static constexpr Distance kMaxDistance = std::numeric_limits<Distance>::max();
+
+  // The state of one of the two searches.
+  struct Side {
+    bool backward;
+    sequence<Distance> dist;
+    // Every vertex with dist != kMaxDistance (possibly with duplicates).
+    sequence<uintE> touched;
+    // Reached vertices that are not yet settled (possibly stale, i.e., in a
+    // bucket that has already been settled, or duplicated).
+    sequence<uintE> pending;
+    // The last bucket that was settled, or -1 if none.
+    int64_t settled_bucket;
+
+    Side(size_t n, bool backward)
+        : backward(backward),
+          dist(n, kMaxDistance),
+          settled_bucket(-1) {}
+  };
+
+  Graph& G;
+  size_t n;
+  double delta;
+  Side fwd;
+  Side bwd;
+  // Scratch flags for removing duplicates; all false between uses.
+  sequence<bool> marked;
+
+  // Statistics of the last query.
+  size_t steps;
+  size_t explored;
+
+  // Builds the engine. If delta <= 0, the mean edge weight is used.
+  BidirectionalEngine(Graph& G, double delta = 0)
+      : G(G),
+        n(G.n),
+        delta(delta),
+        fwd(G.n, false),
+        bwd(G.n, true),
+        marked(G.n, false),
+        steps(0),
+        explored(0) {
+    if (this->delta <= 0) {
+      auto map_w = [&](const uintE& u, const uintE& v, const W& w) {
+        return static_cast<double>(
+            Bidirectional_F<W, Distance>::weight_of(w));
+      };
+      auto vertex_sums = parlay::delayed_seq<double>(n, [&](size_t i) {
+        return G.get_vertex(i).out_neighbors().reduce(map_w,
+                                                      parlay::plus<double>());
+      });
+      double sum_w = parlay::reduce(vertex_sums);
+      this->delta = (G.m == 0) ? 1 : std::max(sum_w / G.m, 1e-9);
+    }
+  }
+
+  size_t bucket_of(Distance d) const {
+    return static_cast<size_t>(static_cast<double>(d) / delta);
+  }
+
+  size_t degree(const Side& side, uintE v) {
+    return side.backward ? G.get_vertex(v).in_degree()
+                         : G.get_vertex(v).out_degree();
+  }
+
+  // Removes duplicates from vs using the `marked` flags, which are cleared
+  // again before returning.
+  sequence<uintE> dedup(const sequence<uintE>& vs) {
+    auto keep = sequence<bool>::from_function(vs.size(), [&](size_t i) {
+      return !marked[vs[i]] &&
+             gbbs::atomic_compare_and_swap(&marked[vs[i]], false, true);
+    });
+    auto out = parlay::pack(vs, keep);
+    parallel_for(0, out.size(), kDefaultGranularity,
+                 [&](size_t i) { marked[out[i]] = false; });
+    return out;
+  }
+
+  // Resets the state touched by the previous query.
+  void reset(Side& side) {
+    auto& touched = side.touched;
+    parallel_for(0, touched.size(), kDefaultGranularity,
+                 [&](size_t i) { side.dist[touched[i]] = kMaxDistance; });
+    touched.clear();
+    side.pending.clear();
+    side.settled_bucket = -1;
+  }
+
+  void start(Side& side, uintE src) {
+    side.dist[src] = 0;
+    side.touched.push_back(src);
+    side.pending.push_back(src);
+  }
+
+  // Drops stale and duplicate entries from the pending set of `side`, and
+  // returns the smallest tentative distance of an unsettled vertex
+  // (kMaxDistance if there is none) and the volume of its bucket.
+  std::pair<Distance, size_t> next_bucket(Side& side) {
+    int64_t settled = side.settled_bucket;
+    auto unsettled = parlay::filter(side.pending, [&](uintE v) {
+      return static_cast<int64_t>(bucket_of(side.dist[v])) > settled;
+    });
+    side.pending = dedup(unsettled);
+    if (side.pending.size() == 0) {
+      return {kMaxDistance, 0};
+    }
+    auto dists = parlay::delayed_seq<Distance>(
+        side.pending.size(),
+        [&](size_t i) { return side.dist[side.pending[i]]; });
+    Distance min_dist = parlay::reduce(dists, parlay::minimum<Distance>());
+    size_t bkt = bucket_of(min_dist);
+    auto volumes = parlay::delayed_seq<size_t>(
+        side.pending.size(), [&](size_t i) -> size_t {
+          uintE v = side.pending[i];
+          return (bucket_of(side.dist[v]) == bkt) ? degree(side, v) : 0;
+        });
+    return {min_dist, parlay::reduce(volumes)};
+  }
+
+  // Settles the next bucket of `side`, whose smallest tentative distance is
+  // min_dist.
+  void step(Side& side, Side& other, Distance min_dist, Distance* best) {
+    size_t bkt = bucket_of(min_dist);
+    auto in_bucket = [&](uintE v) { return bucket_of(side.dist[v]) == bkt; };
+    auto frontier = parlay::filter(side.pending, in_bucket);
+    side.pending =
+        parlay::filter(side.pending, [&](uintE v) { return !in_bucket(v); });
+    flags fl = no_dense;
+    if (side.backward) fl |= in_edges;
+    auto F = Bidirectional_F<W, Distance>(side.dist.begin(),
+                                          other.dist.begin(), best);
+    // Bellman-Ford rounds within the bucket.
+    while (frontier.size() > 0) {
+      explored += frontier.size();
+      auto active = vertexSubset(n, std::move(frontier));
+      auto output = edgeMap(G, active, F, -1, fl);
+      output.toSparse();
+      auto improved = std::move(output.s);
+      side.touched.append(make_slice(improved));
+      frontier = dedup(parlay::filter(improved, in_bucket));
+      auto later =
+          parlay::filter(improved, [&](uintE v) { return !in_bucket(v); });
+      side.pending.append(make_slice(later));
+    }
+    side.settled_bucket = bkt;
+  }
+
+  // Returns the distance from s to t, or kMaxDistance if t is not reachable
+  // from s.
+  Distance Query(uintE s, uintE t) {
+    reset(fwd);
+    reset(bwd);
+    steps = 0;
+    explored = 0;
+    if (s == t) return 0;
+    start(fwd, s);
+    start(bwd, t);
+    Distance best = kMaxDistance;
+    while (true) {
+      auto [fwd_min, fwd_volume] = next_bucket(fwd);
+      auto [bwd_min, bwd_volume] = next_bucket(bwd);
+      if (fwd_min == kMaxDistance || bwd_min == kMaxDistance) break;
+      if (best != kMaxDistance && static_cast<double>(fwd_min) +
+                                          static_cast<double>(bwd_min) >=
+                                      static_cast<double>(best)) {
+        break;
+      }
+      steps++;
+      if (fwd_volume <= bwd_volume) {
+        step(fwd, bwd, fwd_min, &best);
+      } else {
+        step(bwd, fwd, bwd_min, &best);
+      }
+    }
+    gbbs_debug(std::cout << "# s-t query steps = " << steps
+                         << " explored = " << explored << std::endl;);
+    return best;
+  }
+};
+
+template <class Graph>
+inline BidirectionalEngine<Graph> make_bidirectional_engine(Graph& G,
+                                                            double delta = 0) {
+  return BidirectionalEngine<Graph>(G, delta);
+}
+
+}  // namespace bidirectional
+}  // namespace gbbs
@@ -0,0 +1,66 @@
+#include "benchmarks/PointToPointShortestPath/Bidirectional/BidirectionalSearch.h"
+
+#include <unordered_set>
+
+#include "gbbs/graph.h"
+#include "gbbs/helpers/directed_edge.h"
+#include "gbbs/helpers/undirected_edge.h"
+#include "gbbs/macros.h"
+#include "gbbs/unit_tests/graph_test_utils.h"
+#include "gtest/gtest.h"
+
+namespace gbbs {
+
+TEST(BidirectionalSearch, UnweightedPath) {
+  // Graph diagram:
+  // 0 - 1 - 2 - 3 - 4    5
+  const uintE kNumVertices{6};
+  const std::unordered_set<UndirectedEdge> kEdges{
+      {0, 1}, {1, 2}, {2, 3}, {3, 4}};
+  auto graph{graph_test::MakeUnweightedSymmetricGraph(kNumVertices, kEdges)};
+  auto engine = bidirectional::make_bidirectional_engine(graph);
+  constexpr uintE kMax = std::numeric_limits<uintE>::max();
+
+  EXPECT_EQ(engine.Query(0, 4), 4);
+  EXPECT_EQ(engine.Query(4, 0), 4);
+  EXPECT_EQ(engine.Query(1, 3), 2);
+  EXPECT_EQ(engine.Query(2, 2), 0);
+  EXPECT_EQ(engine.Query(0, 5), kMax);
+  // State left over from the previous queries is reset.
+  EXPECT_EQ(engine.Query(3, 4), 1);
+}
+
+TEST(BidirectionalSearch, Directed) {
+  // Graph diagram:
+  // 0 -> 1 -> 2 -> 0
+  const uintE kNumVertices{3};
+  const std::unordered_set<DirectedEdge> kEdges{{0, 1}, {1, 2}, {2, 0}};
+  auto graph{graph_test::MakeUnweightedSymmetricGraph(kNumVertices, kEdges)};
+  auto engine = bidirectional::make_bidirectional_engine(graph);
+
+  EXPECT_EQ(engine.Query(0, 2), 2);
+  EXPECT_EQ(engine.Query(2, 0), 1);
+  EXPECT_EQ(engine.Query(1, 0), 2);
+}
+
+TEST(BidirectionalSearch, Weighted) {
+  // Graph diagram (edge weights in parentheses):
+  //   0 -(1)- 1 -(1)- 2 -(1)- 3
+  //   |                       |
+  //   +---------(10)----------+      4 -(2)- 5
+  using edge = std::tuple<uintE, uintE, int>;
+  sequence<edge> edges = {
+      {0, 1, 1}, {1, 2, 1}, {2, 3, 1}, {0, 3, 10}, {4, 5, 2}};
+  auto graph = symmetric_graph<symmetric_vertex, int>::from_edges(edges, 6);
+  constexpr int kMax = std::numeric_limits<int>::max();
+
+  for (double delta : {0.0, 1.0, 100.0}) {
+    auto engine = bidirectional::make_bidirectional_engine(graph, delta);
+    EXPECT_EQ(engine.Query(0, 3), 3);
+    EXPECT_EQ(engine.Query(3, 1), 2);
+    EXPECT_EQ(engine.Query(4, 5), 2);
+    EXPECT_EQ(engine.Query(0, 5), kMax);
+  }
+}
+
+}  // namespace gbbs
@@ -0,0 +1,72 @@
+// Usage:
+// numactl -i all ./RadiusStepping -src 10012 -s -m -rounds 3 twitter_wgh_SJ
+// flags:
+//   required:
+//     -src: the source to compute shortest path distances from
+//     -w: indicate that the graph is weighted
+//   optional:
+//     -rounds : the number of times to run the algorithm
+//     -c : indicate that the graph is compressed
+//     -m : indicate that the graph should be mmap'd
+//     -s : indicate that the graph is symmetric
+//     -delta : the delta to use; chosen automatically if omitted
+//     -rho : use radius-stepping, with the radius of a vertex being the
+//            weight of its rho-th lightest edge
+//     -nb : the number of buckets to use for delta-stepping
+
+#define WEIGHTED 1
+
+#include "RadiusStepping.h"
+
+namespace gbbs {
+
+template <class Graph>
+double RadiusStepping_runner(Graph& G, commandLine P, uintE src) {
+  size_t num_buckets = P.getOptionLongValue("-nb", 128);
+  double delta = P.getOptionDoubleValue("-delta", 0);
+  size_t rho = P.getOptionLongValue("-rho", 0);
+
+  std::cout << "\n### Application: RadiusStepping" << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -src = " << src << " -delta = " << delta
+            << " -rho = " << rho << " -nb (num_buckets) = " << num_buckets
+            << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+
+  timer pt;
+  pt.start();
+  auto engine = sssp::make_sssp_engine(G, delta);
+  double pre_t = pt.stop();
+  std::cout << "### Using delta = " << engine.delta
+            << " (mean weight = " << engine.stats.mean_weight
+            << ", average degree = " << engine.stats.average_degree << ")"
+            << std::endl;
+  std::cout << "### Preprocessing Time: " << pre_t << std::endl;
+
+  timer t;
+  t.start();
+  auto dists = (rho > 0) ? engine.RadiusStepping(src, rho)
+                         : engine.DeltaStepping(src, num_buckets);
+  double tt = t.stop();
+
+  std::cout << "### Running Time: " << tt << std::endl;
+
+  using Distance = typename decltype(engine)::Distance;
+  constexpr Distance kMaxWeight = std::numeric_limits<Distance>::max();
+  auto not_max = [&](Distance e) { return e != kMaxWeight; };
+  auto reached = parlay::filter(dists, not_max);
+  std::cout << "Nodes reached: " << reached.size() << std::endl;
+  if (reached.size() > 0) {
+    std::cout << "Longest distance: " << parlay::reduce_max(reached)
+              << std::endl;
+  }
+
+  return tt;
+}
+
+}  // namespace gbbs
+
+generate_weighted_traversal_main(gbbs::RadiusStepping_runner, false);
@@ -0,0 +1,388 @@
+// This file provides an SSSP engine for graphs with non-negative edge weights
+// that supports two schedules:
+//
+//   - Delta-stepping with light/heavy edge separation. Each vertex's out-edges
+//     are stored with its light edges (weight < delta) first. A bucket is
+//     processed by relaxing only light edges until no vertex re-enters the
+//     bucket, after which the heavy edges of the bucket's (now settled)
+//     vertices are relaxed exactly once. If no delta is given, it is chosen
+//     from the weight and degree statistics of the graph.
+//
+//   - Radius-stepping ("Parallel Shortest Paths Using Radius Stepping" by
+//     Blelloch, Gu, Sun, and Tangwongsan). Every vertex v has a radius r(v),
+//     the weight of its rho-th lightest out-edge. Each step settles all
+//     vertices within min_{v unsettled} (d(v) + r(v)) using Bellman-Ford
+//     sub-rounds.
+//
+// In both schedules, the tentative distance and the "changed this round" flag
+// of a vertex are packed into a single 64-bit word, so a relaxation is a
+// single compare-and-swap. The engine pre-allocates its per-vertex state once
+// and reuses it across queries.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "gbbs/bucket.h"
+#include "gbbs/gbbs.h"
+
+namespace gbbs {
+namespace sssp {
+
+namespace internal {
+
+// A packed word stores the bits of a (non-negative) distance in its upper 32
+// bits and the "changed" flag in its lowest bit. Non-negative IEEE floats and
+// non-negative integers both compare correctly as unsigned integers.
+template <class Distance>
+inline uint32_t to_bits(Distance d) {
+  static_assert(sizeof(Distance) == sizeof(uint32_t),
+                "packed relaxations require 32-bit distances");
+  uint32_t b;
+  std::memcpy(&b, &d, sizeof(b));
+  return b;
+}
+
+template <class Distance>
+inline Distance from_bits(uint32_t b) {
+  Distance d;
+  std::memcpy(&d, &b, sizeof(b));
+  return d;
+}
+
+inline uint64_t pack(uint32_t dist_bits, bool changed) {
+  return (static_cast<uint64_t>(dist_bits) << 32) | changed;
+}
+
+inline uint32_t dist_bits(uint64_t word) {
+  return static_cast<uint32_t>(word >> 32);
+}
+
+inline bool changed(uint64_t word) { return word & 1; }
+
+// Lowers the distance in *word to new_bits if that is an improvement. Returns
+// true iff this was the first improvement since the flag was last cleared, in
+// which case the distance at that time is written to *old_bits.
+inline bool relax(uint64_t* word, uint32_t new_bits, uint32_t* old_bits) {
+  uint64_t old_w = *word;
+  while (dist_bits(old_w) > new_bits) {
+    if (gbbs::atomic_compare_and_swap(word, old_w, pack(new_bits, true))) {
+      if (changed(old_w)) return false;
+      *old_bits = dist_bits(old_w);
+      return true;
+    }
+    old_w = *word;
+  }
+  return false;
+}
+
+}  // namespace internal
+
+// Statistics used to choose delta automatically.
+struct WeightStats {
+  double min_weight;
+  double max_weight;
+  double mean_weight;
+  double average_degree;
+};
+
+// Chooses delta so that a vertex has a constant expected number of light
+// edges, following the Theta(1 / d) rule of "Delta-stepping: a parallelizable
+// shortest path algorithm" by Meyer and Sanders (for weights uniform in
+// [0, 1], delta = 1 / d). The result is clamped to [min_weight, max_weight]:
+// smaller values create empty buckets, and larger values degenerate to
+// Bellman-Ford.
+inline double choose_delta(const WeightStats& stats) {
+  double d = std::max(stats.average_degree, 1.0);
+  double delta = 2 * stats.mean_weight / d;
+  delta = std::min(delta, stats.max_weight);
+  delta = std::max(delta, stats.min_weight);
+  return std::max(delta, 1e-9);
+}
+
+template <class Graph>
+struct SSSPEngine {
+  using W = typename Graph::weight_type;
+  using Distance =
+      typename std::conditional<std::is_same<W, gbbs::empty>::value, uintE,
+                                W>::type;
+  using neighbor = std::tuple<uintE, Distance>;
+  static constexpr Distance kMaxDistance = std::numeric_limits<Distance>::max();
+
+  Graph& G;
+  size_t n;
+  double delta;
+  WeightStats stats;
+
+  // Out-edges in CSR form. The out-edges of v are
+  // edges[offsets[v], offsets[v + 1]), with its light edges in
+  // edges[offsets[v], light_ends[v]).
+  sequence<size_t> offsets;
+  sequence<size_t> light_ends;
+  sequence<neighbor> edges;
+
+  // Per-vertex state, reused across queries.
+  sequence<uint64_t> words;
+  sequence<uint32_t> old_bits;
+  sequence<bool> marked;
+
+  // Builds the engine. If delta <= 0, delta is chosen by choose_delta.
+  SSSPEngine(Graph& G, double delta = 0) : G(G), n(G.n), delta(delta) {
+    timer pt;
+    pt.start();
+    stats = weight_stats();
+    if (this->delta <= 0) {
+      this->delta = choose_delta(stats);
+    }
+    build_edges();
+    words = sequence<uint64_t>(n, internal::pack(to_bits(kMaxDistance), false));
+    old_bits = sequence<uint32_t>::uninitialized(n);
+    marked = sequence<bool>(n, false);
+    gbbs_debug(pt.next("sssp engine preprocessing time"););
+  }
+
+  static Distance weight_of(const W& w) {
+    if constexpr (std::is_same<W, gbbs::empty>()) {
+      return 1;
+    } else {
+      return w;
+    }
+  }
+
+  static uint32_t to_bits(Distance d) { return internal::to_bits(d); }
+
+  Distance distance(uintE v) const {
+    return internal::from_bits<Distance>(internal::dist_bits(words[v]));
+  }
+
+  WeightStats weight_stats() const {
+    auto map_min = [&](const uintE& u, const uintE& v, const W& w) {
+      return static_cast<double>(weight_of(w));
+    };
+    double min_w = G.reduceEdges(
+        map_min,
+        parlay::make_monoid([](double a, double b) { return std::min(a, b); },
+                            std::numeric_limits<double>::max()));
+    double max_w = G.reduceEdges(map_min, parlay::maxm<double>());
+    double sum_w = G.reduceEdges(map_min, parlay::plus<double>());
+    double m = std::max<double>(G.m, 1);
+    return WeightStats{(G.m == 0) ? 0 : min_w, max_w, sum_w / m,
+                       m / std::max<double>(n, 1)};
+  }
+
+  void build_edges() {
+    offsets = sequence<size_t>::from_function(n + 1, [&](size_t i) -> size_t {
+      return (i == n) ? 0 : G.get_vertex(i).out_degree();
+    });
+    size_t m = parlay::scan_inplace(make_slice(offsets));
+    edges = sequence<neighbor>::uninitialized(m);
+    light_ends = sequence<size_t>::uninitialized(n);
+    parallel_for(0, n, 1, [&](size_t i) {
+      size_t k = offsets[i];
+      auto map_f = [&](const uintE& u, const uintE& v, const W& w) {
+        edges[k++] = std::make_tuple(v, weight_of(w));
+      };
+      G.get_vertex(i).out_neighbors().map(map_f, false);
+      auto begin = edges.begin() + offsets[i];
+      auto end = edges.begin() + offsets[i + 1];
+      auto mid = std::partition(begin, end, [&](const neighbor& e) {
+        return std::get<1>(e) < delta;
+      });
+      light_ends[i] = offsets[i] + (mid - begin);
+    });
+  }
+
+  void reset(uintE src) {
+    parallel_for(0, n, kDefaultGranularity, [&](size_t i) {
+      words[i] = internal::pack(to_bits(kMaxDistance), false);
+    });
+    words[src] = internal::pack(to_bits(Distance(0)), false);
+  }
+
+  // Relaxes the out-edges of the frontier vertices selected by `range`, which
+  // maps v to an [begin, end) range of `edges`. Returns the vertices whose
+  // distance improved for the first time since their flag was cleared; for
+  // each such vertex v, old_bits[v] holds its previous distance. The flags of
+  // the returned vertices are cleared.
+  template <class Range>
+  sequence<uintE> relax_frontier(const sequence<uintE>& frontier,
+                                 Range range) {
+    size_t f = frontier.size();
+    auto degs = sequence<size_t>::from_function(f + 1, [&](size_t i) {
+      if (i == f) return size_t{0};
+      auto [b, e] = range(frontier[i]);
+      return e - b;
+    });
+    size_t total = parlay::scan_inplace(make_slice(degs));
+    auto out = sequence<uintE>::uninitialized(total);
+    parallel_for(0, f, 1, [&](size_t i) {
+      uintE u = frontier[i];
+      auto [b, e] = range(u);
+      Distance d_u = distance(u);
+      size_t out_off = degs[i];
+      parallel_for(b, e, PARALLEL_DEGREE, [&](size_t j) {
+        auto [v, w] = edges[j];
+        uint32_t nd = to_bits(d_u + w);
+        out[out_off + (j - b)] =
+            internal::relax(&words[v], nd, &old_bits[v]) ? v : UINT_E_MAX;
+      });
+    });
+    auto improved = parlay::filter(out, [](uintE v) { return v != UINT_E_MAX; });
+    parallel_for(0, improved.size(), kDefaultGranularity, [&](size_t i) {
+      uintE v = improved[i];
+      words[v] = internal::pack(internal::dist_bits(words[v]), false);
+    });
+    return improved;
+  }
+
+  // Removes duplicates from vs using the `marked` flags, which are cleared
+  // again before returning.
+  sequence<uintE> dedup(const sequence<uintE>& vs) {
+    auto keep = sequence<bool>::from_function(vs.size(), [&](size_t i) {
+      return !marked[vs[i]] &&
+             gbbs::atomic_compare_and_swap(&marked[vs[i]], false, true);
+    });
+    auto out = parlay::pack(vs, keep);
+    parallel_for(0, out.size(), kDefaultGranularity,
+                 [&](size_t i) { marked[out[i]] = false; });
+    return out;
+  }
+
+  // Delta-stepping with light/heavy separation.
+  sequence<Distance> DeltaStepping(uintE src, size_t num_buckets = 128) {
+    reset(src);
+    auto get_bkt = [&](const Distance& dist) -> uintE {
+      return (dist == kMaxDistance) ? UINT_E_MAX : (uintE)(dist / delta);
+    };
+    auto get_ring = parlay::delayed_seq<uintE>(
+        n, [&](const size_t& v) -> uintE { return get_bkt(distance(v)); });
+    auto b = make_vertex_buckets(n, get_ring, increasing, num_buckets);
+
+    auto light = [&](uintE v) {
+      return std::make_pair(offsets[v], light_ends[v]);
+    };
+    auto heavy = [&](uintE v) {
+      return std::make_pair(light_ends[v], offsets[v + 1]);
+    };
+
+    // Moves the improved vertices whose new bucket is not `cur` in the bucket
+    // structure, and returns the ones that are in bucket `cur`.
+    auto update = [&](const sequence<uintE>& improved, uintE cur) {
+      auto dests = sequence<uintE>::from_function(
+          improved.size(), [&](size_t i) {
+            uintE v = improved[i];
+            uintE new_bkt = get_bkt(distance(v));
+            if (new_bkt == cur) return b.null_bkt;
+            uintE prev_bkt = get_bkt(
+                internal::from_bits<Distance>(old_bits[v]));
+            return b.get_bucket(prev_bkt, new_bkt);
+          });
+      b.update_buckets(
+          [&](size_t i) -> std::optional<std::tuple<uintE, uintE>> {
+            if (dests[i] == b.null_bkt) return std::nullopt;
+            return std::make_tuple(improved[i], dests[i]);
+          },
+          improved.size());
+      return parlay::filter(improved, [&](uintE v) {
+        return get_bkt(distance(v)) == cur;
+      });
+    };
+
+    size_t rounds = 0;
+    auto bkt = b.next_bucket();
+    while (bkt.id != b.null_bkt) {
+      uintE cur = bkt.id;
+      auto frontier = std::move(bkt.identifiers);
+      auto settled = sequence<uintE>();
+      // Light phase: vertices may re-enter the current bucket.
+      while (frontier.size() > 0) {
+        rounds++;
+        settled.append(make_slice(frontier));
+        auto improved = relax_frontier(frontier, light);
+        frontier = update(improved, cur);
+      }
+      // Heavy phase: the distances of the settled vertices are final, and
+      // heavy edges cannot reach the current bucket.
+      settled = dedup(settled);
+      auto improved = relax_frontier(settled, heavy);
+      update(improved, cur);
+      bkt = b.next_bucket();
+    }
+    gbbs_debug(std::cout << "# delta-stepping rounds = " << rounds
+                         << std::endl;);
+    return sequence<Distance>::from_function(
+        n, [&](size_t i) { return distance(i); });
+  }
+
+  // Computes the radius of every vertex: the weight of its rho-th lightest
+  // out-edge (its heaviest edge if it has fewer than rho edges).
+  sequence<Distance> radii(size_t rho) const {
+    return sequence<Distance>::from_function(n, [&](size_t i) {
+      size_t deg = offsets[i + 1] - offsets[i];
+      if (deg == 0) return Distance(0);
+      size_t k = std::min(rho, deg) - 1;
+      auto ws = sequence<Distance>::from_function(deg, [&](size_t j) {
+        return std::get<1>(edges[offsets[i] + j]);
+      });
+      std::nth_element(ws.begin(), ws.begin() + k, ws.end());
+      return ws[k];
+    });
+  }
+
+  // Radius-stepping with per-vertex radii `radius`.
+  sequence<Distance> RadiusStepping(uintE src,
+                                    const sequence<Distance>& radius) {
+    reset(src);
+    auto all = [&](uintE v) {
+      return std::make_pair(offsets[v], offsets[v + 1]);
+    };
+    // Reached but unsettled vertices.
+    auto pending = sequence<uintE>(1, src);
+    size_t steps = 0, rounds = 0;
+    while (pending.size() > 0) {
+      steps++;
+      auto bound_seq = parlay::delayed_seq<double>(
+          pending.size(), [&](size_t i) {
+            uintE v = pending[i];
+            return static_cast<double>(distance(v)) + radius[v];
+          });
+      double bound = parlay::reduce(
+          bound_seq,
+          parlay::make_monoid([](double a, double b) { return std::min(a, b); },
+                              std::numeric_limits<double>::max()));
+      auto within = [&](uintE v) {
+        return static_cast<double>(distance(v)) <= bound;
+      };
+      auto frontier = parlay::filter(pending, within);
+      auto rest = parlay::filter(pending, [&](uintE v) { return !within(v); });
+      // Bellman-Ford sub-rounds on the vertices within the bound.
+      while (frontier.size() > 0) {
+        rounds++;
+        auto improved = relax_frontier(frontier, all);
+        frontier = parlay::filter(improved, within);
+        auto beyond =
+            parlay::filter(improved, [&](uintE v) { return !within(v); });
+        rest.append(make_slice(beyond));
+      }
+      pending = dedup(parlay::filter(rest, [&](uintE v) { return !within(v); }));
+    }
+    gbbs_debug(std::cout << "# radius-stepping steps = " << steps
+                         << " rounds = " << rounds << std::endl;);
+    return sequence<Distance>::from_function(
+        n, [&](size_t i) { return distance(i); });
+  }
+
+  sequence<Distance> RadiusStepping(uintE src, size_t rho) {
+    return RadiusStepping(src, radii(rho));
+  }
+};
+
+template <class Graph>
+inline SSSPEngine<Graph> make_sssp_engine(Graph& G, double delta = 0) {
+  return SSSPEngine<Graph>(G, delta);
+}
+
+}  // namespace sssp
+}  // namespace gbbs
@@ -0,0 +1,100 @@
+#include "benchmarks/PositiveWeightSSSP/RadiusStepping/RadiusStepping.h"
+
+#include <vector>
+
+#include "benchmarks/GeneralWeightSSSP/BellmanFord/BellmanFord.h"
+#include "gbbs/graph.h"
+#include "gbbs/helpers/undirected_edge.h"
+#include "gbbs/macros.h"
+#include "gbbs/unit_tests/graph_test_utils.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using ::testing::ElementsAre;
+
+namespace gbbs {
+
+namespace {
+
+// Graph diagram (edge weights in parentheses):
+//   0 -(1)- 1 -(1)- 2 -(1)- 3
+//   |                       |
+//   +---------(10)----------+      4 -(2)- 5
+symmetric_graph<symmetric_vertex, int> WeightedTestGraph() {
+  using edge = std::tuple<uintE, uintE, int>;
+  sequence<edge> edges = {{0, 1, 1}, {1, 2, 1}, {2, 3, 1},
+                          {0, 3, 10}, {4, 5, 2}};
+  return symmetric_graph<symmetric_vertex, int>::from_edges(edges, 6);
+}
+
+constexpr int kMax = std::numeric_limits<int>::max();
+
+// A pseudo-random graph on n vertices with edge probability about p and edge
+// weights in [1, 100].
+symmetric_graph<symmetric_vertex, int> RandomWeightedGraph(uintE n, double p,
+                                                           uint64_t seed) {
+  using edge = std::tuple<uintE, uintE, int>;
+  sequence<edge> edges;
+  for (const auto& e : graph_test::RandomUndirectedEdges(n, p, seed)) {
+    auto [u, v] = e.endpoints();
+    uint64_t h = parlay::hash64((seed << 40) ^ (uint64_t{u} << 20) ^ v);
+    edges.push_back({u, v, static_cast<int>(1 + h % 100)});
+  }
+  return symmetric_graph<symmetric_vertex, int>::from_edges(edges, n);
+}
+
+std::vector<int> ToVector(const sequence<int>& distances) {
+  return std::vector<int>(distances.begin(), distances.end());
+}
+
+}  // namespace
+
+TEST(RadiusStepping, DeltaSteppingWithHeavyEdges) {
+  auto graph = WeightedTestGraph();
+  auto engine = sssp::make_sssp_engine(graph, /* delta = */ 2);
+  // The 0 - 3 edge is heavy and must not shorten the path to 3.
+  EXPECT_THAT(engine.DeltaStepping(0), ElementsAre(0, 1, 2, 3, kMax, kMax));
+  // The engine state is reused across queries.
+  EXPECT_THAT(engine.DeltaStepping(5),
+              ElementsAre(kMax, kMax, kMax, kMax, 2, 0));
+}
+
+TEST(RadiusStepping, AutomaticDelta) {
+  auto graph = WeightedTestGraph();
+  auto engine = sssp::make_sssp_engine(graph);
+  EXPECT_GE(engine.delta, engine.stats.min_weight);
+  EXPECT_LE(engine.delta, engine.stats.max_weight);
+  EXPECT_THAT(engine.DeltaStepping(3), ElementsAre(3, 2, 1, 0, kMax, kMax));
+}
+
+TEST(RadiusStepping, RadiusStepping) {
+  auto graph = WeightedTestGraph();
+  auto engine = sssp::make_sssp_engine(graph);
+  for (size_t rho : {1, 2, 3}) {
+    EXPECT_THAT(engine.RadiusStepping(0, rho),
+                ElementsAre(0, 1, 2, 3, kMax, kMax));
+  }
+}
+
+TEST(RadiusStepping, MatchesBellmanFordOnRandomGraphs) {
+  constexpr uintE n = 300;
+  for (uint64_t seed : {1, 2, 3}) {
+    auto graph = RandomWeightedGraph(n, 0.02, seed);
+    // Small deltas create many buckets, so vertices move between buckets
+    // often; the largest one keeps every edge light.
+    for (double delta : {1.0, 7.0, 40.0, 1000.0}) {
+      auto engine = sssp::make_sssp_engine(graph, delta);
+      for (uintE src : {uintE{0}, uintE{n / 2}, uintE{n - 1}}) {
+        auto expected = ToVector(BellmanFord(graph, src));
+        EXPECT_EQ(ToVector(engine.DeltaStepping(src)), expected)
+            << "seed = " << seed << ", delta = " << delta << ", src = " << src;
+        for (size_t rho : {1, 4, 16}) {
+          EXPECT_EQ(ToVector(engine.RadiusStepping(src, rho)), expected)
+              << "seed = " << seed << ", rho = " << rho << ", src = " << src;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace gbbs
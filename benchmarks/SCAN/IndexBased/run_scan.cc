@@ -13,6 +13,10 @@
 //       construction
 //     -mu : SCAN parameter mu
 //     -epsilon : SCAN parameter epsilon
+//     -load-index : path of an index file written with -save-index to load
+//       instead of constructing the index
+//     -save-index : path at which to save the index
+//     -half : save similarity scores in the index file as half-precision floats
 #include <string>
 
 #include "benchmarks/SCAN/IndexBased/scan.h"
@@ -29,12 +33,24 @@ double RunScan(Graph& graph, commandLine parameters) {
   const uint64_t mu{parameters.getOptionLongValue("-mu", 5)};
   const float epsilon{
       static_cast<float>(parameters.getOptionDoubleValue("-epsilon", 0.6))};
+  const std::string load_index{parameters.getOptionValue("-load-index", "")};
+  const std::string save_index{parameters.getOptionValue("-save-index", "")};
+  const indexed_scan::SimilarityFormat index_format{
+      parameters.getOptionValue("-half")
+          ? indexed_scan::SimilarityFormat::kFloat16
+          : indexed_scan::SimilarityFormat::kFloat32};
   std::cout << "Scan parameters: mu = " << mu << ", epsilon = " << epsilon
             << '\n';
 
-  timer index_construction_timer{"Index construction time"};
-  const indexed_scan::Index scan_index{&graph, scan::CosineSimilarity{}};
+  timer index_construction_timer{load_index.empty() ? "Index construction time"
+                                                    : "Index load time"};
+  const indexed_scan::Index scan_index{
+      load_index.empty() ? indexed_scan::Index{&graph, scan::CosineSimilarity{}}
+                         : indexed_scan::Index::Load(load_index)};
   index_construction_timer.stop();
+  if (!save_index.empty()) {
+    scan_index.Save(save_index, index_format);
+  }
 
   timer cluster_timer{"Clustering time over " + std::to_string(cluster_rounds) +
                       " rounds"};
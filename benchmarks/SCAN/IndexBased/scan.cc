@@ -1,12 +1,18 @@
 #include "benchmarks/SCAN/IndexBased/scan.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
 #include <tuple>
 #include <utility>
 
 #include "benchmarks/Connectivity/UnionFind/union_find_rules.h"
 #include "gbbs/bridge.h"
+#include "gbbs/helpers/assert.h"
 #include "gbbs/helpers/sparse_table.h"
+#include "gbbs/io.h"
 
 namespace gbbs {
 namespace indexed_scan {
@@ -175,11 +181,333 @@ void AttachNoncoresToClustersDeterministic(
   internal::ReportTime(function_timer);
 }
 
+// Magic bytes at the start of an index file written by `Index::Save`.
+constexpr char kIndexMagic[]{"GBBSSCN1"};
+constexpr size_t kIndexMagicLength{8};
+// Number of 64-bit fields in an index file's header after the magic bytes.
+constexpr size_t kIndexHeaderFields{5};
+
+// Returns `num_bytes` rounded up to a multiple of 8.
+size_t PadToWord(const size_t num_bytes) { return (num_bytes + 7) / 8 * 8; }
+
+// Returns the number of bytes that a similarity score occupies in an index
+// file.
+size_t SimilarityBytes(const SimilarityFormat format) {
+  switch (format) {
+    case SimilarityFormat::kFloat32:
+      return sizeof(float);
+    case SimilarityFormat::kFloat16:
+      return sizeof(uint16_t);
+  }
+  ABORT_INVALID_ENUM(SimilarityFormat, format)
+}
+
+// Writes the similarity scores `scores` to `file` in the given format.
+void WriteSimilarities(std::ofstream* file, const sequence<float>& scores,
+                       const SimilarityFormat format) {
+  switch (format) {
+    case SimilarityFormat::kFloat32:
+      file->write(reinterpret_cast<const char*>(scores.begin()),
+                  scores.size() * sizeof(float));
+      return;
+    case SimilarityFormat::kFloat16: {
+      const sequence<uint16_t> halves{
+          parlay::map<uint16_t>(scores, [](const float score) {
+            return internal::FloatToHalf(score);
+          })};
+      file->write(reinterpret_cast<const char*>(halves.begin()),
+                  halves.size() * sizeof(uint16_t));
+      return;
+    }
+  }
+  ABORT_INVALID_ENUM(SimilarityFormat, format)
+}
+
+// Reads the `i`-th similarity score from an array of scores in an index file.
+float ReadSimilarity(const char* scores, const SimilarityFormat format,
+                     const size_t i) {
+  if (format == SimilarityFormat::kFloat16) {
+    uint16_t half;
+    std::memcpy(&half, scores + i * sizeof(half), sizeof(half));
+    return internal::HalfToFloat(half);
+  }
+  float value;
+  std::memcpy(&value, scores + i * sizeof(value), sizeof(value));
+  return value;
+}
+
 }  // namespace
 
 Index::Index()
     : num_vertices_{0U}, neighbor_order_{}, core_order_{neighbor_order_} {}
 
+Index::Index(sequence<scan::EdgeSimilarity>&& similarities,
+             const sequence<uint64_t>& vertex_offsets,
+             sequence<sequence<internal::CoreThreshold>>&& core_order)
+    : num_vertices_{vertex_offsets.size() - 1},
+      neighbor_order_{std::move(similarities), vertex_offsets},
+      core_order_{num_vertices_, std::move(core_order)} {}
+
+void Index::Save(const std::string& filename,
+                 const SimilarityFormat format) const {
+  timer function_timer{"Save index time"};
+  if (num_vertices_ > std::numeric_limits<uint32_t>::max()) {
+    ABORT("Too many vertices to save index: " << num_vertices_);
+  }
+  std::ofstream file(filename, std::ios::out | std::ios::binary);
+  if (!file.is_open()) {
+    ABORT("Unable to open file: " << filename);
+  }
+
+  sequence<uint64_t> vertex_offsets = sequence<uint64_t>::from_function(
+      num_vertices_ + 1, [&](const size_t i) {
+        return i < num_vertices_ ? neighbor_order_[i].size() : 0;
+      });
+  const uint64_t num_edges{parlay::scan_inplace(vertex_offsets)};
+  const auto& core_lists{core_order_.order()};
+  sequence<uint64_t> core_offsets = sequence<uint64_t>::from_function(
+      core_lists.size() + 1, [&](const size_t i) {
+        return i < core_lists.size() ? core_lists[i].size() : 0;
+      });
+  const uint64_t num_core_entries{parlay::scan_inplace(core_offsets)};
+
+  // Flatten the similarity lists and the core lists.
+  auto neighbors{sequence<uint32_t>::uninitialized(num_edges)};
+  auto similarities{sequence<float>::uninitialized(num_edges)};
+  parallel_for(0, num_vertices_, [&](const size_t v) {
+    const auto& vertex_similarities{neighbor_order_[v]};
+    for (size_t i = 0; i < vertex_similarities.size(); i++) {
+      neighbors[vertex_offsets[v] + i] = vertex_similarities[i].neighbor;
+      similarities[vertex_offsets[v] + i] = vertex_similarities[i].similarity;
+    }
+  });
+  auto cores{sequence<uint32_t>::uninitialized(num_core_entries)};
+  auto thresholds{sequence<float>::uninitialized(num_core_entries)};
+  parallel_for(0, core_lists.size(), [&](const size_t mu) {
+    const auto& core_list{core_lists[mu]};
+    parallel_for(0, core_list.size(), [&](const size_t i) {
+      cores[core_offsets[mu] + i] = core_list[i].vertex_id;
+      thresholds[core_offsets[mu] + i] = core_list[i].threshold;
+    });
+  });
+
+  const auto write_u64{[&](const uint64_t x) {
+    file.write(reinterpret_cast<const char*>(&x), sizeof(x));
+  }};
+  const auto pad{[&](const size_t num_bytes) {
+    const char zeros[8]{};
+    file.write(zeros, PadToWord(num_bytes) - num_bytes);
+  }};
+  file.write(kIndexMagic, kIndexMagicLength);
+  write_u64(static_cast<uint64_t>(format));
+  write_u64(num_vertices_);
+  write_u64(num_edges);
+  write_u64(core_lists.size());
+  write_u64(num_core_entries);
+  file.write(reinterpret_cast<const char*>(vertex_offsets.begin()),
+             vertex_offsets.size() * sizeof(uint64_t));
+  file.write(reinterpret_cast<const char*>(core_offsets.begin()),
+             core_offsets.size() * sizeof(uint64_t));
+  file.write(reinterpret_cast<const char*>(neighbors.begin()),
+             num_edges * sizeof(uint32_t));
+  pad(num_edges * sizeof(uint32_t));
+  WriteSimilarities(&file, similarities, format);
+  pad(num_edges * SimilarityBytes(format));
+  file.write(reinterpret_cast<const char*>(cores.begin()),
+             num_core_entries * sizeof(uint32_t));
+  pad(num_core_entries * sizeof(uint32_t));
+  WriteSimilarities(&file, thresholds, format);
+  pad(num_core_entries * SimilarityBytes(format));
+
+  file.close();
+  if (file.fail()) {
+    ABORT("Error writing file: " << filename);
+  }
+  internal::ReportTime(function_timer);
+}
+
+Index Index::Load(const std::string& filename) {
+  timer function_timer{"Load index time"};
+  const auto [bytes, num_bytes]{
+      gbbs_io::mmapStringFromFile(filename.c_str())};
+  constexpr size_t kHeaderBytes{kIndexMagicLength +
+                                kIndexHeaderFields * sizeof(uint64_t)};
+  if (num_bytes < kHeaderBytes ||
+      std::memcmp(bytes, kIndexMagic, kIndexMagicLength) != 0) {
+    ABORT("Not a SCAN index file: " << filename);
+  }
+  uint64_t header[kIndexHeaderFields];
+  std::memcpy(header, bytes + kIndexMagicLength, sizeof(header));
+  const auto [format_id, num_vertices, num_edges, num_core_lists,
+              num_core_entries] = header;
+  if (format_id > static_cast<uint64_t>(SimilarityFormat::kFloat16)) {
+    ABORT("Unknown similarity format " << format_id << " in " << filename);
+  }
+  // Every array entry takes at least one byte, so larger counts cannot fit
+  // in the file, and bounding them keeps the size computations below from
+  // overflowing.
+  if (num_vertices >= num_bytes || num_edges >= num_bytes ||
+      num_core_lists >= num_bytes || num_core_entries >= num_bytes ||
+      num_vertices > std::numeric_limits<uint32_t>::max()) {
+    ABORT("Invalid header in SCAN index file " << filename);
+  }
+  const SimilarityFormat format{static_cast<SimilarityFormat>(format_id)};
+  const size_t similarity_bytes{SimilarityBytes(format)};
+
+  const char* vertex_offsets_bytes{bytes + kHeaderBytes};
+  const char* core_offsets_bytes{vertex_offsets_bytes +
+                                 (num_vertices + 1) * sizeof(uint64_t)};
+  const char* neighbors_bytes{core_offsets_bytes +
+                              (num_core_lists + 1) * sizeof(uint64_t)};
+  const char* similarities_bytes{
+      neighbors_bytes + PadToWord(num_edges * sizeof(uint32_t))};
+  const char* cores_bytes{similarities_bytes +
+                          PadToWord(num_edges * similarity_bytes)};
+  const char* thresholds_bytes{
+      cores_bytes + PadToWord(num_core_entries * sizeof(uint32_t))};
+  const char* end{thresholds_bytes +
+                  PadToWord(num_core_entries * similarity_bytes)};
+  if (end != bytes + num_bytes) {
+    ABORT("Unexpected size of SCAN index file " << filename << ": "
+                                                << num_bytes << " bytes");
+  }
+
+  const auto read_u64{[](const char* array, const size_t i) {
+    uint64_t x;
+    std::memcpy(&x, array + i * sizeof(x), sizeof(x));
+    return x;
+  }};
+  const auto read_u32{[](const char* array, const size_t i) {
+    uint32_t x;
+    std::memcpy(&x, array + i * sizeof(x), sizeof(x));
+    return x;
+  }};
+  const auto vertex_offsets{sequence<uint64_t>::from_function(
+      num_vertices + 1,
+      [&](const size_t i) { return read_u64(vertex_offsets_bytes, i); })};
+  const auto core_offsets{sequence<uint64_t>::from_function(
+      num_core_lists + 1,
+      [&](const size_t i) { return read_u64(core_offsets_bytes, i); })};
+  // Checks that `offsets` starts at 0, never decreases, and ends at `total`.
+  const auto is_valid_offsets{
+      [](const sequence<uint64_t>& offsets, const uint64_t total) {
+        const size_t size{offsets.size()};
+        return offsets[0] == 0 && offsets[size - 1] == total &&
+               parlay::all_of(parlay::iota(size - 1), [&](const size_t i) {
+                 return offsets[i] <= offsets[i + 1];
+               });
+      }};
+  if (!is_valid_offsets(vertex_offsets, num_edges) ||
+      !is_valid_offsets(core_offsets, num_core_entries)) {
+    ABORT("Inconsistent offsets in SCAN index file " << filename);
+  }
+  const auto is_valid_vertices{[&](const char* ids, const uint64_t size) {
+    return parlay::all_of(parlay::iota(size), [&](const size_t i) {
+      return read_u32(ids, i) < num_vertices;
+    });
+  }};
+  if (!is_valid_vertices(neighbors_bytes, num_edges) ||
+      !is_valid_vertices(cores_bytes, num_core_entries)) {
+    ABORT("Out-of-range vertex ID in SCAN index file " << filename);
+  }
+
+  auto similarities{
+      sequence<scan::EdgeSimilarity>::uninitialized(num_edges)};
+  parallel_for(0, num_vertices, [&](const size_t v) {
+    for (size_t i = vertex_offsets[v]; i < vertex_offsets[v + 1]; i++) {
+      similarities[i] = scan::EdgeSimilarity{
+          .source = static_cast<uintE>(v),
+          .neighbor = read_u32(neighbors_bytes, i),
+          .similarity = ReadSimilarity(similarities_bytes, format, i)};
+    }
+  });
+  auto core_order{sequence<sequence<internal::CoreThreshold>>::from_function(
+      num_core_lists, [&](const size_t mu) {
+        const size_t offset{core_offsets[mu]};
+        return sequence<internal::CoreThreshold>::from_function(
+            core_offsets[mu + 1] - offset, [&](const size_t i) {
+              return internal::CoreThreshold{
+                  .vertex_id = read_u32(cores_bytes, offset + i),
+                  .threshold =
+                      ReadSimilarity(thresholds_bytes, format, offset + i)};
+            });
+      })};
+  gbbs_io::unmmap(bytes, num_bytes);
+  internal::ReportTime(function_timer);
+  return Index{std::move(similarities), vertex_offsets, std::move(core_order)};
+}
+
+void Index::ApplyUpdate(
+    const sequence<uintE>& endpoints,
+    sequence<sequence<scan::EdgeSimilarity>>&& endpoint_lists) {
+  timer function_timer{"Apply index update time"};
+  const auto is_endpoint{[&](const uintE vertex) {
+    return std::binary_search(endpoints.begin(), endpoints.end(), vertex);
+  }};
+  const auto compare_similarity_descending{
+      [](const scan::EdgeSimilarity& a, const scan::EdgeSimilarity& b) {
+        return a.similarity > b.similarity;
+      }};
+
+  // The degrees of the other neighbors of the endpoints do not change, but
+  // their scores to the endpoints do.
+  sequence<scan::EdgeSimilarity> neighbor_updates{parlay::map(
+      parlay::filter(parlay::flatten(endpoint_lists),
+                     [&](const scan::EdgeSimilarity& edge) {
+                       return !is_endpoint(edge.neighbor);
+                     }),
+      [](const scan::EdgeSimilarity& edge) {
+        return scan::EdgeSimilarity{.source = edge.neighbor,
+                                    .neighbor = edge.source,
+                                    .similarity = edge.similarity};
+      })};
+  parlay::sample_sort_inplace(
+      make_slice(neighbor_updates),
+      [](const scan::EdgeSimilarity& left, const scan::EdgeSimilarity& right) {
+        // Sort by ascending source, then descending similarity.
+        return std::tie(left.source, right.similarity) <
+               std::tie(right.source, left.similarity);
+      });
+  // `update_starts[j]` is the index of the first update to the j-th updated
+  // neighbor.
+  const sequence<size_t> update_starts{parlay::pack_index<size_t>(
+      parlay::delayed_seq<bool>(neighbor_updates.size(), [&](const size_t i) {
+        return i == 0 ||
+               neighbor_updates[i].source != neighbor_updates[i - 1].source;
+      }))};
+  const size_t num_endpoints{endpoints.size()};
+  const size_t num_vertices{num_endpoints + update_starts.size()};
+  const sequence<uintE> vertices{
+      sequence<uintE>::from_function(num_vertices, [&](const size_t i) {
+        return i < num_endpoints
+                   ? endpoints[i]
+                   : neighbor_updates[update_starts[i - num_endpoints]].source;
+      })};
+  sequence<sequence<scan::EdgeSimilarity>> lists{
+      sequence<sequence<scan::EdgeSimilarity>>::from_function(
+          num_vertices,
+          [&](const size_t i) -> sequence<scan::EdgeSimilarity> {
+            if (i < num_endpoints) {
+              return std::move(endpoint_lists[i]);
+            }
+            const size_t j{i - num_endpoints};
+            const size_t end{j + 1 == update_starts.size()
+                                 ? neighbor_updates.size()
+                                 : update_starts[j + 1]};
+            const auto updates{neighbor_updates.cut(update_starts[j], end)};
+            const sequence<scan::EdgeSimilarity> kept{parlay::filter(
+                neighbor_order_[vertices[i]],
+                [&](const scan::EdgeSimilarity& edge) {
+                  return !is_endpoint(edge.neighbor);
+                })};
+            return parlay::merge(kept, updates, compare_similarity_descending);
+          })};
+  internal::ReportTime(function_timer);
+
+  core_order_.Update(neighbor_order_, vertices, lists);
+  neighbor_order_.ReplaceLists(vertices, std::move(lists));
+}
+
 Clustering Index::Cluster(const uint64_t mu, const float epsilon,
                           const bool get_deterministic_result) const {
   timer preprocessing_timer{"Cluster - additional preprocessing time"};
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <string>
+#include <utility>
+
 #include "benchmarks/SCAN/IndexBased/scan_helpers.h"
 #include "benchmarks/SCAN/IndexBased/similarity_measure.h"
 #include "benchmarks/SCAN/IndexBased/utils.h"
 #include "gbbs/graph.h"
+#include "gbbs/helpers/assert.h"
 #include "gbbs/macros.h"
 
 namespace gbbs {
@@ -12,6 +16,15 @@ namespace indexed_scan {
 using scan::Clustering;
 using scan::kUnclustered;
 
+// How `Index::Save` stores similarity scores.
+enum class SimilarityFormat {
+  // Exact single-precision floats.
+  kFloat32,
+  // IEEE 754 half-precision floats, which halve the space of the scores at the
+  // cost of a relative error of up to 2^-11 in each score.
+  kFloat16,
+};
+
 // Index for an undirected graph from which clustering the graph with SCAN is
 // quick, though index construction may be expensive.
 class Index {
@@ -78,11 +91,142 @@ class Index {
                const std::function<void(Clustering&&, size_t)> f,
                bool get_deterministic_result = false) const;
 
+  // Writes the index to a binary file so that it can later be read with
+  // `Load` instead of being recomputed.
+  //
+  // The file consists of a header followed by arrays, each starting at an
+  // offset that is a multiple of 8 bytes so that the arrays are aligned when
+  // the file is mmap'd. `Load` maps the file and copies the arrays into the
+  // index. Integers and floats are stored in the native byte order.
+  //   char[8] magic = "GBBSSCN1"
+  //   uint64 similarity format (0 = float32, 1 = float16)
+  //   uint64 number of vertices n
+  //   uint64 number of directed edges m
+  //   uint64 number of core lists c (where core list mu holds the possible
+  //     cores for SCAN parameter mu)
+  //   uint64 total length t of the core lists
+  //   uint64[n + 1] vertex offsets into the similarity lists
+  //   uint64[c + 1] offsets into the core lists
+  //   uint32[m] neighbor IDs of the similarity lists, where each vertex's
+  //     neighbors are sorted by descending similarity
+  //   float32[m] or float16[m] similarity scores of the similarity lists
+  //   uint32[t] vertex IDs of the core lists, where each core list is sorted
+  //     by descending core threshold
+  //   float32[t] or float16[t] core thresholds of the core lists
+  //
+  // Arguments:
+  //   filename
+  //     Path of the file to write.
+  //   format
+  //     How to store similarity scores and core thresholds. With `kFloat16`,
+  //     clusterings computed from the loaded index may differ from those of
+  //     this index for epsilon values within the rounding error of a score.
+  void Save(const std::string& filename,
+            SimilarityFormat format = SimilarityFormat::kFloat32) const;
+
+  // Reads an index written by `Save`. Terminates the program with an error
+  // message if the file is not a valid index file, including when its offsets
+  // or vertex IDs are out of range.
+  static Index Load(const std::string& filename);
+
+  // Updates the index after a batch of edge insertions and deletions so that
+  // `Cluster` gives the same results as an index constructed on the updated
+  // graph.
+  //
+  // Inserting or deleting an edge {u, v} only changes the neighborhoods of u
+  // and v, so only the similarity scores of the edges incident on u or v
+  // change. This recomputes those scores, re-sorts the neighbor lists that
+  // contain them, and patches the lists of the core order that contain a
+  // changed core threshold. The other scores are untouched.
+  //
+  // Arguments:
+  //   graph
+  //     The graph after the updates. It must have the same vertices as the
+  //     indexed graph, and the neighbor lists for each vertex must be sorted by
+  //     ascending neighbor ID.
+  //   updated_edges
+  //     The inserted and deleted edges, in any orientation and order.
+  //   similarity_measure: similarity measure from `similarity_measure.h`
+  //     Must be the measure that the index was constructed with. Only the
+  //     measures that implement `OneEdge`, which are the exact measures on
+  //     unweighted graphs, are supported.
+  template <template <typename> class VertexTemplate, typename Weight,
+            class SimilarityMeasure = scan::CosineSimilarity>
+  void Update(
+      symmetric_graph<VertexTemplate, Weight>* graph,
+      const sequence<std::pair<uintE, uintE>>& updated_edges,
+      const SimilarityMeasure& similarity_measure = scan::CosineSimilarity{});
+
  private:
+  // Constructor from precomputed parts of the index (see the constructors of
+  // `internal::NeighborOrder` and `internal::CoreOrder`).
+  Index(sequence<scan::EdgeSimilarity>&& similarities,
+        const sequence<uint64_t>& vertex_offsets,
+        sequence<sequence<internal::CoreThreshold>>&& core_order);
+
+  // Second half of `Update`, which replaces the similarity lists of the
+  // endpoints `endpoints[i]` of the updated edges with `endpoint_lists[i]`
+  // and updates the rest of the index accordingly. `endpoints` must be sorted
+  // and distinct.
+  void ApplyUpdate(
+      const sequence<uintE>& endpoints,
+      sequence<sequence<scan::EdgeSimilarity>>&& endpoint_lists);
+
   size_t num_vertices_;
   internal::NeighborOrder neighbor_order_;
   internal::CoreOrder core_order_;
 };
 
+template <template <typename> class VertexTemplate, typename Weight,
+          class SimilarityMeasure>
+void Index::Update(symmetric_graph<VertexTemplate, Weight>* graph,
+                   const sequence<std::pair<uintE, uintE>>& updated_edges,
+                   const SimilarityMeasure& similarity_measure) {
+  timer function_timer{"Update index time"};
+  if (graph->n != num_vertices_) {
+    ABORT("Graph has " << graph->n << " vertices, but the index has "
+                       << num_vertices_);
+  }
+  sequence<uintE> vertices{sequence<uintE>::from_function(
+      2 * updated_edges.size(), [&](const size_t i) {
+        const auto& edge{updated_edges[i / 2]};
+        return i % 2 == 0 ? edge.first : edge.second;
+      })};
+  if (parlay::any_of(vertices,
+                     [&](const uintE v) { return v >= num_vertices_; })) {
+    ABORT("Updated edge has an endpoint outside of the graph");
+  }
+  parlay::sort_inplace(make_slice(vertices));
+  const sequence<uintE> endpoints{parlay::pack(
+      vertices, parlay::delayed_seq<bool>(vertices.size(), [&](size_t i) {
+        return i == 0 || vertices[i] != vertices[i - 1];
+      }))};
+
+  auto endpoint_lists{sequence<sequence<scan::EdgeSimilarity>>::from_function(
+      endpoints.size(), [&](const size_t i) {
+        const uintE endpoint{endpoints[i]};
+        auto vertex{graph->get_vertex(endpoint)};
+        auto list{sequence<scan::EdgeSimilarity>::uninitialized(
+            vertex.out_degree())};
+        const auto compute_similarity{[&](const uintE, const uintE neighbor,
+                                          const Weight, const uintE index) {
+          list[index] = scan::EdgeSimilarity{
+              .source = endpoint,
+              .neighbor = neighbor,
+              .similarity =
+                  similarity_measure.OneEdge(graph, endpoint, neighbor)};
+        }};
+        vertex.out_neighbors().map_with_index(compute_similarity);
+        parlay::sample_sort_inplace(
+            make_slice(list),
+            [](const scan::EdgeSimilarity& a, const scan::EdgeSimilarity& b) {
+              return a.similarity > b.similarity;
+            });
+        return list;
+      })};
+  internal::ReportTime(function_timer);
+  ApplyUpdate(endpoints, std::move(endpoint_lists));
+}
+
 }  // namespace indexed_scan
 }  // namespace gbbs
@@ -1,6 +1,9 @@
 #include "benchmarks/SCAN/IndexBased/scan_helpers.h"
 
+#include <algorithm>
+#include <cstring>
 #include <limits>
+#include <utility>
 
 namespace gbbs {
 namespace indexed_scan {
@@ -30,7 +33,134 @@ void ReportTime([[maybe_unused]] const timer& t) {
 #endif
 }
 
-NeighborOrder::NeighborOrder() : similarities_{}, similarities_by_source_{} {}
+uint16_t FloatToHalf(const float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const uint16_t sign = (bits >> 16) & 0x8000;
+  const uint32_t exponent{(bits >> 23) & 0xff};
+  uint32_t mantissa{bits & 0x7fffff};
+  if (exponent == 0xff) {  // Infinity or NaN.
+    return sign | 0x7c00 | (mantissa != 0 ? 0x200 : 0);
+  }
+  const int32_t half_exponent{static_cast<int32_t>(exponent) - 127 + 15};
+  if (half_exponent >= 0x1f) {  // Overflows to infinity.
+    return sign | 0x7c00;
+  }
+  if (half_exponent <= 0) {  // Subnormal or zero.
+    if (half_exponent < -10) {
+      return sign;
+    }
+    mantissa |= 0x800000;
+    const uint32_t shift = 14 - half_exponent;
+    uint32_t half_mantissa{mantissa >> shift};
+    const uint32_t remainder{mantissa & ((1U << shift) - 1)};
+    const uint32_t halfway{1U << (shift - 1)};
+    if (remainder > halfway ||
+        (remainder == halfway && (half_mantissa & 1) != 0)) {
+      half_mantissa++;
+    }
+    return sign | half_mantissa;
+  }
+  uint32_t half = (static_cast<uint32_t>(half_exponent) << 10) |
+                  (mantissa >> 13);
+  const uint32_t remainder{mantissa & 0x1fff};
+  // A carry out of the mantissa correctly rounds up the exponent (possibly to
+  // infinity).
+  if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1) != 0)) {
+    half++;
+  }
+  return sign | half;
+}
+
+float HalfToFloat(const uint16_t half) {
+  const uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+  uint32_t exponent = (half >> 10) & 0x1f;
+  uint32_t mantissa = half & 0x3ff;
+  uint32_t bits;
+  if (exponent == 0x1f) {  // Infinity or NaN.
+    bits = sign | 0x7f800000 | (mantissa << 13);
+  } else if (exponent != 0) {
+    bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+  } else if (mantissa == 0) {
+    bits = sign;
+  } else {  // Subnormal, which is a normal float.
+    exponent = 127 - 14;
+    while ((mantissa & 0x400) == 0) {
+      mantissa <<= 1;
+      exponent--;
+    }
+    bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+  }
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+NeighborOrder::NeighborOrder()
+    : similarities_{},
+      replaced_lists_{},
+      num_stale_similarities_{0},
+      similarities_by_source_{} {}
+
+NeighborOrder::NeighborOrder(sequence<EdgeSimilarity>&& similarities,
+                             const sequence<uint64_t>& vertex_offsets)
+    : similarities_{std::move(similarities)}, num_stale_similarities_{0} {
+  SetSlices(vertex_offsets);
+}
+
+void NeighborOrder::SetSlices(const sequence<uint64_t>& vertex_offsets) {
+  const size_t num_vertices{vertex_offsets.size() - 1};
+  similarities_by_source_ =
+      sequence<gbbs::slice<EdgeSimilarity>>::from_function(
+          num_vertices, [&](const size_t i) {
+            return similarities_.cut(vertex_offsets[i], vertex_offsets[i + 1]);
+          });
+}
+
+void NeighborOrder::ReplaceLists(const sequence<uintE>& vertices,
+                                 sequence<sequence<EdgeSimilarity>>&& lists) {
+  if (replaced_lists_.empty()) {
+    replaced_lists_ = sequence<sequence<EdgeSimilarity>>(size());
+  }
+  const EdgeSimilarity* const similarities_begin{similarities_.begin()};
+  const EdgeSimilarity* const similarities_end{similarities_.end()};
+  // Number of scores in `similarities_` that each replacement makes stale.
+  const sequence<size_t> newly_stale{
+      sequence<size_t>::from_function(vertices.size(), [&](const size_t i) {
+        const uintE vertex{vertices[i]};
+        const gbbs::slice<EdgeSimilarity> old_list{
+            similarities_by_source_[vertex]};
+        const bool was_replaced{old_list.begin() < similarities_begin ||
+                                old_list.begin() >= similarities_end};
+        replaced_lists_[vertex] = std::move(lists[i]);
+        similarities_by_source_[vertex] = replaced_lists_[vertex].cut(
+            0, replaced_lists_[vertex].size());
+        return was_replaced ? 0 : old_list.size();
+      })};
+  num_stale_similarities_ += parlay::reduce(newly_stale);
+  if (2 * num_stale_similarities_ > similarities_.size()) {
+    Compact();
+  }
+}
+
+void NeighborOrder::Compact() {
+  sequence<uint64_t> vertex_offsets = sequence<uint64_t>::from_function(
+      size() + 1, [&](const size_t i) {
+        return i < size() ? similarities_by_source_[i].size() : 0;
+      });
+  const size_t num_similarities{parlay::scan_inplace(vertex_offsets)};
+  auto similarities{
+      sequence<EdgeSimilarity>::uninitialized(num_similarities)};
+  parallel_for(0, size(), [&](const size_t i) {
+    const gbbs::slice<EdgeSimilarity>& list{similarities_by_source_[i]};
+    std::copy(list.begin(), list.end(),
+              similarities.begin() + vertex_offsets[i]);
+  });
+  similarities_ = std::move(similarities);
+  replaced_lists_ = sequence<sequence<EdgeSimilarity>>{};
+  num_stale_similarities_ = 0;
+  SetSlices(vertex_offsets);
+}
 
 const gbbs::slice<EdgeSimilarity>& NeighborOrder::operator[](
     size_t source) const {
@@ -122,6 +252,121 @@ CoreOrder::CoreOrder(const NeighborOrder& neighbor_order)
     : num_vertices_{neighbor_order.size()},
       order_{ComputeCoreOrder(neighbor_order)} {}
 
+CoreOrder::CoreOrder(const size_t num_vertices,
+                     sequence<sequence<CoreThreshold>>&& order)
+    : num_vertices_{num_vertices}, order_{std::move(order)} {}
+
+const sequence<sequence<CoreThreshold>>& CoreOrder::order() const {
+  return order_;
+}
+
+void CoreOrder::Update(const NeighborOrder& neighbor_order,
+                       const sequence<uintE>& vertices,
+                       const sequence<sequence<EdgeSimilarity>>& new_lists) {
+  timer function_timer{"Update core order time"};
+  // A core threshold to insert into or to remove from the list of the core
+  // order for some mu.
+  struct CoreChange {
+    size_t mu;
+    bool insert;
+    CoreThreshold core;
+  };
+  // A vertex v appears in the list for mu if it has at least mu - 1 neighbors,
+  // with the threshold `neighbor_order[v][mu - 2].similarity`.
+  const auto changes_by_vertex{sequence<sequence<CoreChange>>::from_function(
+      vertices.size(), [&](const size_t i) {
+        const uintE vertex{vertices[i]};
+        const gbbs::slice<EdgeSimilarity>& old_list{neighbor_order[vertex]};
+        const sequence<EdgeSimilarity>& new_list{new_lists[i]};
+        sequence<CoreChange> changes;
+        const size_t max_mu{std::max(old_list.size(), new_list.size()) + 1};
+        for (size_t mu = 2; mu <= max_mu; mu++) {
+          const bool in_old{old_list.size() >= mu - 1};
+          const bool in_new{new_list.size() >= mu - 1};
+          if (in_old && in_new &&
+              old_list[mu - 2].similarity == new_list[mu - 2].similarity) {
+            continue;
+          }
+          if (in_old) {
+            changes.push_back(CoreChange{
+                .mu = mu,
+                .insert = false,
+                .core = {.vertex_id = vertex,
+                         .threshold = old_list[mu - 2].similarity}});
+          }
+          if (in_new) {
+            changes.push_back(CoreChange{
+                .mu = mu,
+                .insert = true,
+                .core = {.vertex_id = vertex,
+                         .threshold = new_list[mu - 2].similarity}});
+          }
+        }
+        return changes;
+      })};
+  sequence<CoreChange> changes{parlay::flatten(changes_by_vertex)};
+  if (changes.empty()) {
+    internal::ReportTime(function_timer);
+    return;
+  }
+  integer_sort_inplace(make_slice(changes),
+                       [](const CoreChange& change) { return change.mu; });
+
+  const size_t max_mu{changes[changes.size() - 1].mu};
+  if (order_.size() <= max_mu) {
+    sequence<sequence<CoreThreshold>> order(max_mu + 1);
+    parallel_for(0, order_.size(),
+                 [&](const size_t mu) { order[mu] = std::move(order_[mu]); });
+    order_ = std::move(order);
+  }
+  // `group_starts[j]` is the index of the first change in the j-th group of
+  // changes with the same mu.
+  const sequence<size_t> group_starts{parlay::pack_index<size_t>(
+      parlay::delayed_seq<bool>(changes.size(), [&](const size_t i) {
+        return i == 0 || changes[i].mu != changes[i - 1].mu;
+      }))};
+  const auto compare_threshold_descending{
+      [](const CoreThreshold& a, const CoreThreshold& b) {
+        return a.threshold > b.threshold;
+      }};
+  parallel_for(0, group_starts.size(), [&](const size_t j) {
+    const size_t start{group_starts[j]};
+    const size_t end{j + 1 == group_starts.size() ? changes.size()
+                                                   : group_starts[j + 1]};
+    const size_t mu{changes[start].mu};
+    const auto group{changes.cut(start, end)};
+    sequence<uintE> removed{parlay::map<uintE>(
+        parlay::filter(group,
+                       [](const CoreChange& change) { return !change.insert; }),
+        [](const CoreChange& change) { return change.core.vertex_id; })};
+    parlay::sort_inplace(make_slice(removed));
+    sequence<CoreThreshold> inserted{parlay::map<CoreThreshold>(
+        parlay::filter(group,
+                       [](const CoreChange& change) { return change.insert; }),
+        [](const CoreChange& change) { return change.core; })};
+    parlay::sample_sort_inplace(make_slice(inserted),
+                                compare_threshold_descending);
+    const sequence<CoreThreshold> kept{
+        parlay::filter(order_[mu], [&](const CoreThreshold& core) {
+          return !std::binary_search(removed.begin(), removed.end(),
+                                     core.vertex_id);
+        })};
+    order_[mu] = parlay::merge(kept, inserted, compare_threshold_descending);
+  });
+
+  // Drop trailing empty lists so that, as in `ComputeCoreOrder`, the last list
+  // is the one for one more than the maximum degree.
+  size_t num_lists{order_.size()};
+  while (num_lists > 2 && order_[num_lists - 1].empty()) {
+    num_lists--;
+  }
+  if (num_lists < order_.size()) {
+    order_ = sequence<sequence<CoreThreshold>>::from_function(
+        num_lists, [&](const size_t mu) { return std::move(order_[mu]); });
+  }
+  internal::ReportTime(function_timer);
+}
+
 sequence<uintE> CoreOrder::GetCores(const uint64_t mu,
                                     const float epsilon) const {
   if (mu <= 1) {  // All vertices are cores.
@@ -4,6 +4,7 @@
 // main SCAN header file.
 #pragma once
 
+#include <cstdint>
 #include <utility>
 
 #include "benchmarks/SCAN/IndexBased/similarity_measure.h"
@@ -31,6 +32,20 @@ class NeighborOrder {
   NeighborOrder(symmetric_graph<VertexTemplate, Weight>* graph,
                 const SimilarityMeasure& similarity_measure);
 
+  // Constructor from precomputed similarity scores, e.g., ones read from a
+  // file.
+  //
+  // Arguments:
+  //   similarities
+  //     Similarity scores for all edges, sorted by source and then by
+  //     descending similarity.
+  //   vertex_offsets
+  //     `(n + 1)`-length sequence where the similarity scores from vertex `i`
+  //     are `similarities[vertex_offsets[i]]` through
+  //     `similarities[vertex_offsets[i + 1] - 1]`.
+  NeighborOrder(sequence<EdgeSimilarity>&& similarities,
+                const sequence<uint64_t>& vertex_offsets);
+
   NeighborOrder();
 
   // Get all similarity scores from vertex `source` to its neighbors (not
@@ -44,10 +59,33 @@ class NeighborOrder {
   const gbbs::slice<EdgeSimilarity>* begin() const;
   const gbbs::slice<EdgeSimilarity>* end() const;
 
+  // Replaces the similarity scores from each vertex `vertices[i]` with
+  // `lists[i]`, which must be sorted by descending similarity. The vertices
+  // must be distinct.
+  //
+  // The replaced lists are stored separately, so this takes work proportional
+  // to the size of the new lists rather than to the size of the graph, except
+  // for an occasional compaction that keeps the space of stale scores within
+  // half of the space of all scores.
+  void ReplaceLists(const sequence<uintE>& vertices,
+                    sequence<sequence<EdgeSimilarity>>&& lists);
+
  private:
+  // Points `similarities_by_source_` at `similarities_` using the offsets
+  // described in the constructor from precomputed similarity scores.
+  void SetSlices(const sequence<uint64_t>& vertex_offsets);
+  // Moves all similarity scores back into `similarities_`.
+  void Compact();
+
   // Holds similarity scores for all edges, sorted by source and then by
-  // similarity.
+  // similarity, except for the vertices whose lists were replaced.
   sequence<EdgeSimilarity> similarities_;
+  // `replaced_lists_[v]` holds the similarity scores from vertex v if its list
+  // was replaced since the last compaction. Empty if there were no
+  // replacements.
+  sequence<sequence<EdgeSimilarity>> replaced_lists_;
+  // Number of scores in `similarities_` that belong to replaced lists.
+  size_t num_stale_similarities_;
   sequence<gbbs::slice<EdgeSimilarity>> similarities_by_source_;
 };
 
@@ -62,11 +100,28 @@ std::ostream& operator<<(std::ostream& os, const CoreThreshold&);
 class CoreOrder {
  public:
   explicit CoreOrder(const NeighborOrder& neighbor_order);
+  // Constructor from a precomputed core order in the format returned by
+  // `ComputeCoreOrder`, e.g., one read from a file.
+  CoreOrder(size_t num_vertices, sequence<sequence<CoreThreshold>>&& order);
 
   // Return all vertices that are cores under SCAN parameters `mu` and
   // `epsilon`.
   sequence<uintE> GetCores(uint64_t mu, float epsilon) const;
 
+  // Returns the core order in the format returned by `ComputeCoreOrder`.
+  const sequence<sequence<CoreThreshold>>& order() const;
+
+  // Updates the core order after the similarity list of each vertex
+  // `vertices[i]` changes from `neighbor_order[vertices[i]]` to `new_lists[i]`.
+  // The vertices must be distinct.
+  //
+  // Only the pairs (mu, vertex) whose core threshold changes are touched, but
+  // each list of the core order that has such a pair is rewritten, taking work
+  // linear in the length of the list.
+  void Update(const NeighborOrder& neighbor_order,
+              const sequence<uintE>& vertices,
+              const sequence<sequence<EdgeSimilarity>>& new_lists);
+
  private:
   size_t num_vertices_;
   sequence<sequence<CoreThreshold>> order_{};
@@ -76,10 +131,18 @@ class CoreOrder {
 // SCAN_DETAILED_TIMES is defined, otherwise does nothing.
 void ReportTime(const timer&);
 
+// Converts `value` to the nearest IEEE 754 half-precision float (rounding ties
+// to even), returned as its bit pattern. The conversion is monotone, so it
+// preserves the order of the similarity lists and of the core orders.
+uint16_t FloatToHalf(float value);
+// Converts the bit pattern of a half-precision float to a float.
+float HalfToFloat(uint16_t half);
+
 template <template <typename> class VertexTemplate, typename Weight,
           class SimilarityMeasure>
 NeighborOrder::NeighborOrder(symmetric_graph<VertexTemplate, Weight>* graph,
-                             const SimilarityMeasure& similarity_measure) {
+                             const SimilarityMeasure& similarity_measure)
+    : num_stale_similarities_{0} {
   timer function_timer{"Construct neighbor order"};
   similarities_ = similarity_measure.AllEdges(graph);
   parlay::sample_sort_inplace(
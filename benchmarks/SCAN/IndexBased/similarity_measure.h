@@ -42,6 +42,13 @@ std::ostream& operator<<(std::ostream& os, const EdgeSimilarity&);
 //   // for each vertex of the graph must be sorted by ascending neighbor ID.
 //   template <class Graph>
 //   sequence<EdgeSimilarity> AllEdges(Graph* graph) const;
+// The exact measures on unweighted graphs also implement the following
+// function, which `indexed_scan::Index::Update` needs:
+//   // Returns the similarity score between adjacent vertices u and v, equal to
+//   // the score that `AllEdges` gives the edge {u, v}. The neighbor lists for
+//   // each vertex of the graph must be sorted by ascending neighbor ID.
+//   template <class Graph>
+//   float OneEdge(Graph* graph, uintE u, uintE v) const;
 
 // The cosine similarity between two adjacent vertices u and v is
 //   (size of intersection of the closed neighborhoods of u and v) /
@@ -70,6 +77,11 @@ class CosineSimilarity {
   template <template <typename> class VertexTemplate, typename Weight>
   sequence<EdgeSimilarity> AllEdges(
       symmetric_graph<VertexTemplate, Weight>* graph) const;
+
+  // Only implemented for unweighted graphs.
+  template <template <typename> class VertexTemplate>
+  float OneEdge(symmetric_graph<VertexTemplate, gbbs::empty>* graph, uintE u,
+                uintE v) const;
 };
 
 // The Jaccard similarity between two adjacent vertices u and v is
@@ -84,6 +96,10 @@ class JaccardSimilarity {
   template <template <typename> class VertexTemplate>
   sequence<EdgeSimilarity> AllEdges(
       symmetric_graph<VertexTemplate, gbbs::empty>* graph) const;
+
+  template <template <typename> class VertexTemplate>
+  float OneEdge(symmetric_graph<VertexTemplate, gbbs::empty>* graph, uintE u,
+                uintE v) const;
 };
 
 // This is an approximate version of `CosineSimilarity`. Increasing
@@ -192,6 +208,48 @@ sequence<uintT> VertexOutOffsets(
   return vertex_offsets;
 }
 
+// Cosine similarity between adjacent vertices in an unweighted graph given
+// the sizes of their (open) neighborhoods and the number of neighbors they
+// share.
+inline float CosineNeighborhoodSimilarity(const uintE neighborhood_size_1,
+                                          const uintE neighborhood_size_2,
+                                          const uintE num_shared_neighbors) {
+  // SCAN structural/cosine similarities are defined using _closed_
+  // neighborhoods, hence the need to to adjust these values by `+ 1` and
+  // `+ 2`.
+  return (num_shared_neighbors + 2) /
+         (sqrtf(neighborhood_size_1 + 1) * sqrtf(neighborhood_size_2 + 1));
+}
+
+// Jaccard similarity between adjacent vertices given the sizes of their (open)
+// neighborhoods and the number of neighbors they share.
+inline float JaccardNeighborhoodSimilarity(const uintE neighborhood_size_1,
+                                           const uintE neighborhood_size_2,
+                                           const uintE num_shared_neighbors) {
+  const uintE neighborhood_union{neighborhood_size_1 + neighborhood_size_2 -
+                                 num_shared_neighbors};
+  // The `+ 2` accounts for the Jaccard similarity being computed with respect
+  // to closed neighborhoods.
+  return static_cast<float>((num_shared_neighbors + 2)) / neighborhood_union;
+}
+
+// Returns the similarity score between adjacent vertices u and v as given by
+// `neighborhood_sizes_to_similarity` (see
+// `AllEdgeNeighborhoodSimilarities()`), counting their shared neighbors by
+// intersecting their neighbor lists.
+template <template <typename> class VertexTemplate, class F>
+float OneEdgeNeighborhoodSimilarity(
+    symmetric_graph<VertexTemplate, gbbs::empty>* graph, const uintE u,
+    const uintE v, F&& neighborhood_sizes_to_similarity) {
+  auto u_vertex{graph->get_vertex(u)};
+  auto v_vertex{graph->get_vertex(v)};
+  const auto no_op{[](uintE, uintE, uintE) {}};
+  const uintE num_shared_neighbors{static_cast<uintE>(
+      internal::intersect_f_with_index_par(&u_vertex, &v_vertex, no_op))};
+  return neighborhood_sizes_to_similarity(
+      u_vertex.out_degree(), v_vertex.out_degree(), num_shared_neighbors);
+}
+
 // Returns a `graph->m`-length sequence containing the similarity score
 // between every adjacent pair of vertices u and v. The similarity score is
 // provided by `neighborhood_sizes_to_similarity` and must be a function of the
@@ -775,16 +833,8 @@ sequence<EdgeSimilarity> CosineSimilarity::AllEdges(
     symmetric_graph<VertexTemplate, Weight>* graph) const {
   if
     constexpr(std::is_same<Weight, gbbs::empty>::value) {  // unweighted
-      constexpr auto similarity_func{[](const uintE neighborhood_size_1,
-                                        const uintE neighborhood_size_2,
-                                        const uintE num_shared_neighbors) {
-        // SCAN structural/cosine similarities are defined using _closed_
-        // neighborhoods, hence the need to to adjust these values by `+ 1` and
-        // `+ 2`.
-        return (num_shared_neighbors + 2) / (sqrtf(neighborhood_size_1 + 1) *
-                                             sqrtf(neighborhood_size_2 + 1));
-      }};
-      return internal::AllEdgeNeighborhoodSimilarities(graph, similarity_func);
+      return internal::AllEdgeNeighborhoodSimilarities(
+          graph, internal::CosineNeighborhoodSimilarity);
     }
   else {  // weighted case
     auto directed_graph{internal::DirectGraphByDegree(graph)};
@@ -874,19 +924,27 @@ sequence<EdgeSimilarity> CosineSimilarity::AllEdges(
   }
 }
 
+template <template <typename> class VertexTemplate>
+float CosineSimilarity::OneEdge(
+    symmetric_graph<VertexTemplate, gbbs::empty>* graph, const uintE u,
+    const uintE v) const {
+  return internal::OneEdgeNeighborhoodSimilarity(
+      graph, u, v, internal::CosineNeighborhoodSimilarity);
+}
+
 template <template <typename> class VertexTemplate>
 sequence<EdgeSimilarity> JaccardSimilarity::AllEdges(
     symmetric_graph<VertexTemplate, gbbs::empty>* graph) const {
-  constexpr auto similarity_func{[](const uintE neighborhood_size_1,
-                                    const uintE neighborhood_size_2,
-                                    const uintE num_shared_neighbors) {
-    const uintE neighborhood_union{neighborhood_size_1 + neighborhood_size_2 -
-                                   num_shared_neighbors};
-    // The `+ 2` accounts for the Jaccard similarity being computed with respect
-    // to closed neighborhoods.
-    return static_cast<float>((num_shared_neighbors + 2)) / neighborhood_union;
-  }};
-  return internal::AllEdgeNeighborhoodSimilarities(graph, similarity_func);
+  return internal::AllEdgeNeighborhoodSimilarities(
+      graph, internal::JaccardNeighborhoodSimilarity);
+}
+
+template <template <typename> class VertexTemplate>
+float JaccardSimilarity::OneEdge(
+    symmetric_graph<VertexTemplate, gbbs::empty>* graph, const uintE u,
+    const uintE v) const {
+  return internal::OneEdgeNeighborhoodSimilarity(
+      graph, u, v, internal::JaccardNeighborhoodSimilarity);
 }
 
 template <template <typename> class VertexTemplate, typename Weight>
@@ -2,6 +2,10 @@
 #include "benchmarks/SCAN/IndexBased/scan_helpers.h"
 
 #include <math.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
 #include <optional>
 #include <set>
 #include <string>
@@ -49,6 +53,22 @@ auto CoreThresholdEq(const uintE expected_vertex,
       Field(&ii::CoreThreshold::threshold, FloatEq(expected_threshold)));
 }
 
+// Returns the clusters of `clustering`, each given as a set of vertex IDs.
+ClusterList GetClusters(const i::Clustering& clustering) {
+  std::unordered_map<uintE, std::set<uintE>> clusters_map;
+  for (size_t v = 0; v < clustering.size(); v++) {
+    const uintE cluster_id{clustering[v]};
+    if (cluster_id != i::kUnclustered) {
+      clusters_map[cluster_id].emplace(v);
+    }
+  }
+  ClusterList clusters;
+  for (auto& cluster_kv : clusters_map) {
+    clusters.emplace(std::move(cluster_kv.second));
+  }
+  return clusters;
+}
+
 // Checks that `clustering` has the expected clusters and returns true if the
 // check passes.
 //
@@ -63,19 +83,7 @@ auto CoreThresholdEq(const uintE expected_vertex,
 //     given as a list of vertex IDs.
 bool CheckClustering(const i::Clustering& clustering,
                      const ClusterList& expected_clusters) {
-  std::unordered_map<uintE, std::set<uintE>> actual_clusters_map;
-  actual_clusters_map.reserve(expected_clusters.size());
-  for (size_t v = 0; v < clustering.size(); v++) {
-    const uintE cluster_id{clustering[v]};
-    if (cluster_id != i::kUnclustered) {
-      actual_clusters_map[cluster_id].emplace(v);
-    }
-  }
-  ClusterList actual_clusters;
-  for (auto& cluster_kv : actual_clusters_map) {
-    actual_clusters.emplace(std::move(cluster_kv.second));
-  }
-
+  const ClusterList actual_clusters{GetClusters(clustering)};
   if (actual_clusters != expected_clusters) {
     std::cerr << "Clusters don't match. Actual clustering:\n"
               << scan::ClusteringToString(clustering) << '\n';
@@ -489,4 +497,191 @@ TEST(Cluster, TwoClusterGraph) {
                              kExpectedOutliers);
   }
 }
+
+TEST(ScanSubroutines, HalfPrecisionConversion) {
+  EXPECT_EQ(ii::FloatToHalf(0.0), 0x0000);
+  EXPECT_EQ(ii::FloatToHalf(1.0), 0x3c00);
+  EXPECT_EQ(ii::FloatToHalf(0.5), 0x3800);
+  EXPECT_EQ(ii::FloatToHalf(-2.0), 0xc000);
+  EXPECT_EQ(ii::FloatToHalf(65504.0), 0x7bff);
+  EXPECT_EQ(ii::FloatToHalf(1e6), 0x7c00);
+  // The smallest positive subnormal half.
+  EXPECT_EQ(ii::FloatToHalf(ldexp(1.0, -24)), 0x0001);
+  // 1 + 2^-11 is halfway between 1 and the next half, and rounds to even.
+  EXPECT_EQ(ii::FloatToHalf(1.0 + ldexp(1.0, -11)), 0x3c00);
+  EXPECT_EQ(ii::FloatToHalf(1.0 + 3 * ldexp(1.0, -11)), 0x3c02);
+  for (uint16_t half = 0; half < 0x7c00; half++) {
+    EXPECT_EQ(ii::FloatToHalf(ii::HalfToFloat(half)), half);
+  }
+  for (const float similarity : {0.1F, 0.577F, 2.0F / sqrtf(8), 0.999F}) {
+    EXPECT_NEAR(ii::HalfToFloat(ii::FloatToHalf(similarity)), similarity,
+                ldexp(similarity, -11));
+  }
+}
+
+TEST(Index, SaveAndLoad) {
+  // Same graph as in the `Cluster.TwoClusterGraph` test along with the isolated
+  // vertex 9 and the triangle {10, 11, 12}.
+  const size_t kNumVertices{13};
+  const std::unordered_set<UndirectedEdge> kEdges{
+      {0, 1}, {1, 2}, {1, 3},   {2, 3},   {3, 4},   {4, 5},
+      {5, 6}, {5, 7}, {6, 7},   {7, 8},   {10, 11}, {11, 12},
+      {10, 12},
+  };
+  auto graph{gt::MakeUnweightedSymmetricGraph(kNumVertices, kEdges)};
+  const i::Index index{&graph};
+  constexpr bool kDeterministic{true};
+
+  for (const auto format :
+       {i::SimilarityFormat::kFloat32, i::SimilarityFormat::kFloat16}) {
+    const std::string filename{::testing::TempDir() + "scan_index.bin"};
+    index.Save(filename, format);
+    const i::Index loaded_index{i::Index::Load(filename)};
+    std::remove(filename.c_str());
+
+    // None of the epsilon values are within half-precision rounding error of
+    // a similarity score.
+    for (const uint64_t mu : {1, 2, 3, 4, 5}) {
+      for (const float epsilon : {0.3, 0.5, 0.6, 0.7, 0.73, 0.8, 0.9, 1.0}) {
+        const i::Clustering expected{
+            index.Cluster(mu, epsilon, kDeterministic)};
+        const i::Clustering actual{
+            loaded_index.Cluster(mu, epsilon, kDeterministic)};
+        EXPECT_EQ(GetClusters(actual), GetClusters(expected))
+            << "mu = " << mu << ", epsilon = " << epsilon;
+        ASSERT_EQ(actual.size(), kNumVertices);
+        for (size_t v = 0; v < kNumVertices; v++) {
+          EXPECT_EQ(actual[v] == i::kUnclustered,
+                    expected[v] == i::kUnclustered);
+        }
+      }
+    }
+  }
+}
+
+TEST(Index, SaveAndLoadNullGraph) {
+  const size_t kNumVertices{0};
+  const std::unordered_set<UndirectedEdge> kEdges{};
+  auto graph{gt::MakeUnweightedSymmetricGraph(kNumVertices, kEdges)};
+  const i::Index index{&graph};
+  const std::string filename{::testing::TempDir() + "scan_null_index.bin"};
+  index.Save(filename);
+  const i::Index loaded_index{i::Index::Load(filename)};
+  std::remove(filename.c_str());
+  EXPECT_THAT(loaded_index.Cluster(2, 0.5), IsEmpty());
+}
+
+TEST(IndexDeathTest, LoadRejectsCorruptFiles) {
+  const size_t kNumVertices{3};
+  const std::unordered_set<UndirectedEdge> kEdges{{0, 1}, {1, 2}, {0, 2}};
+  auto graph{gt::MakeUnweightedSymmetricGraph(kNumVertices, kEdges)};
+  const i::Index index{&graph};
+  const std::string filename{::testing::TempDir() + "scan_corrupt_index.bin"};
+  index.Save(filename);
+  std::string contents;
+  {
+    std::ifstream file{filename, std::ios::binary};
+    contents.assign(std::istreambuf_iterator<char>{file},
+                    std::istreambuf_iterator<char>{});
+  }
+  const auto write_u64{[](std::string* bytes, size_t offset, uint64_t x) {
+    std::memcpy(bytes->data() + offset, &x, sizeof(x));
+  }};
+  const auto write_u32{[](std::string* bytes, size_t offset, uint32_t x) {
+    std::memcpy(bytes->data() + offset, &x, sizeof(x));
+  }};
+  const auto load_corrupted{[&](const std::string& bytes) {
+    {
+      std::ofstream file{filename, std::ios::binary | std::ios::trunc};
+      file.write(bytes.data(), bytes.size());
+    }
+    const i::Index loaded_index{i::Index::Load(filename)};
+  }};
+  // See `Index::Save` for the file layout.
+  uint64_t num_core_lists;
+  std::memcpy(&num_core_lists, contents.data() + 32, sizeof(num_core_lists));
+  constexpr size_t kVertexOffsetsStart{48};
+  const size_t neighbors_start{kVertexOffsetsStart +
+                               (kNumVertices + 1) * sizeof(uint64_t) +
+                               (num_core_lists + 1) * sizeof(uint64_t)};
+
+  std::string decreasing_offsets{contents};
+  write_u64(&decreasing_offsets, kVertexOffsetsStart + sizeof(uint64_t), 5);
+  EXPECT_DEATH(load_corrupted(decreasing_offsets), "Inconsistent offsets");
+
+  std::string bad_neighbor{contents};
+  write_u32(&bad_neighbor, neighbors_start, kNumVertices);
+  EXPECT_DEATH(load_corrupted(bad_neighbor), "Out-of-range vertex ID");
+  std::remove(filename.c_str());
+}
+
+TEST(Index, Update) {
+  // Pseudo-random graphs on 30 vertices with edge density about 1/4, updated
+  // by two batches that each flip about one in twelve vertex pairs.
+  constexpr uintE kNumVertices{30};
+  std::unordered_set<UndirectedEdge> edges{
+      gt::RandomUndirectedEdges(kNumVertices, 0.25, /*seed=*/42)};
+  auto graph{gt::MakeUnweightedSymmetricGraph(kNumVertices, edges)};
+  i::Index cosine_index{&graph};
+  i::Index jaccard_index{&graph, s::JaccardSimilarity{}};
+  constexpr bool kDeterministic{true};
+
+  for (size_t batch = 0; batch < 2; batch++) {
+    sequence<std::pair<uintE, uintE>> updated_edges;
+    const std::unordered_set<UndirectedEdge> flipped_edges{
+        gt::RandomUndirectedEdges(kNumVertices, 1.0 / 12, /*seed=*/43 + batch)};
+    for (const UndirectedEdge& edge : flipped_edges) {
+      const auto [u, v]{edge.endpoints()};
+      updated_edges.push_back({v, u});
+      if (!edges.erase(edge)) {
+        edges.insert(edge);
+      }
+    }
+    auto updated_graph{gt::MakeUnweightedSymmetricGraph(kNumVertices, edges)};
+    cosine_index.Update(&updated_graph, updated_edges);
+    jaccard_index.Update(&updated_graph, updated_edges, s::JaccardSimilarity{});
+    const i::Index expected_cosine_index{&updated_graph};
+    const i::Index expected_jaccard_index{&updated_graph,
+                                          s::JaccardSimilarity{}};
+
+    for (uint64_t mu = 1; mu <= 8; mu++) {
+      for (float epsilon = 0.05; epsilon < 1; epsilon += 0.05) {
+        EXPECT_EQ(
+            GetClusters(cosine_index.Cluster(mu, epsilon, kDeterministic)),
+            GetClusters(
+                expected_cosine_index.Cluster(mu, epsilon, kDeterministic)))
+            << "batch = " << batch << ", mu = " << mu
+            << ", epsilon = " << epsilon;
+        EXPECT_EQ(
+            GetClusters(jaccard_index.Cluster(mu, epsilon, kDeterministic)),
+            GetClusters(
+                expected_jaccard_index.Cluster(mu, epsilon, kDeterministic)))
+            << "batch = " << batch << ", mu = " << mu
+            << ", epsilon = " << epsilon;
+      }
+    }
+  }
+}
+
+TEST(Index, UpdateRemovesMaximumDegreeVertex) {
+  // Deleting the edges of the star centered at 0 leaves only the edge {1, 2}.
+  const size_t kNumVertices{5};
+  const std::unordered_set<UndirectedEdge> kEdges{
+      {0, 1}, {0, 2}, {0, 3}, {0, 4}, {1, 2}};
+  const std::unordered_set<UndirectedEdge> kRemainingEdges{{1, 2}};
+  auto graph{gt::MakeUnweightedSymmetricGraph(kNumVertices, kEdges)};
+  auto updated_graph{
+      gt::MakeUnweightedSymmetricGraph(kNumVertices, kRemainingEdges)};
+  i::Index index{&graph};
+  const sequence<std::pair<uintE, uintE>> kDeletedEdges{
+      {0, 1}, {0, 2}, {0, 3}, {0, 4}};
+  index.Update(&updated_graph, kDeletedEdges);
+
+  constexpr float kEpsilon{0.5};
+  EXPECT_TRUE(CheckClustering(index.Cluster(1, kEpsilon),
+                              ClusterList{{0}, {1, 2}, {3}, {4}}));
+  EXPECT_TRUE(CheckClustering(index.Cluster(2, kEpsilon), ClusterList{{1, 2}}));
+  EXPECT_TRUE(CheckClustering(index.Cluster(3, kEpsilon), ClusterList{}));
+}
+
 }  // namespace gbbs
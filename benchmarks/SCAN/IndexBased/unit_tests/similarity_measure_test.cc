@@ -98,6 +98,16 @@ TEST(CosineSimilarity, AllEdges) {
   EXPECT_THAT(approx_similarities, UnorderedElementsAreArray(similarities));
 }
 
+TEST(CosineSimilarity, OneEdge) {
+  auto graph{MakeBasicGraph()};
+  const s::CosineSimilarity similarity_measure{};
+  // `OneEdge` gives exactly the same scores as `AllEdges`.
+  for (const auto& edge : similarity_measure.AllEdges(&graph)) {
+    EXPECT_EQ(similarity_measure.OneEdge(&graph, edge.source, edge.neighbor),
+              edge.similarity);
+  }
+}
+
 TEST(ApproxCosineSimilarity, AllEdges) {
   auto graph{MakeBasicGraph()};
   // This tests `scan::ApproxCosineSimilarity::AllEdges`, which has a
@@ -155,4 +165,14 @@ TEST(JaccardSimilarity, AllEdges) {
   EXPECT_THAT(approx_similarities, UnorderedElementsAreArray(similarities));
 }
 
+TEST(JaccardSimilarity, OneEdge) {
+  auto graph{MakeBasicGraph()};
+  constexpr s::JaccardSimilarity similarity_measure{};
+  // `OneEdge` gives exactly the same scores as `AllEdges`.
+  for (const auto& edge : similarity_measure.AllEdges(&graph)) {
+    EXPECT_EQ(similarity_measure.OneEdge(&graph, edge.source, edge.neighbor),
+              edge.similarity);
+  }
+}
+
 }  // namespace gbbs
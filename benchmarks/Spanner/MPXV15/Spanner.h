@@ -154,24 +154,23 @@ sequence<edge> fetch_intercluster(Graph& G, C& clusters, size_t num_clusters) {
   return edges;
 }
 
-template <class Graph>
-sequence<edge> tree_and_intercluster_edges(
-    Graph& G, sequence<cluster_and_parent>& cluster_and_parents) {
+// Clusters and Parents are n-length sequences giving the cluster id and the
+// BFS parent of every vertex.
+template <class Graph, class Clusters, class Parents>
+sequence<edge> tree_and_intercluster_edges(Graph& G, Clusters& clusters,
+                                           Parents& parents) {
   size_t n = G.n;
   auto edge_list = parlay::sequence<edge>();
 
   // Compute and add in tree edges.
-  auto tree_edges_with_loops = parlay::delayed_seq<edge>(n, [&](size_t i) {
-    return std::make_pair(i, cluster_and_parents[i].parent);
-  });
+  auto tree_edges_with_loops = parlay::delayed_seq<edge>(
+      n, [&](size_t i) { return std::make_pair(i, parents[i]); });
   auto tree_edges = parlay::filter(tree_edges_with_loops, [&](const edge& e) {
     return e.first != e.second;
   });
   edge_list.append(parlay::make_slice(tree_edges));
 
   // Compute inter-cluster using hashing.
-  auto clusters = parlay::delayed_seq<uintE>(
-      n, [&](size_t i) { return cluster_and_parents[i].cluster; });
   sequence<bool> flags(n, false);
   parallel_for(0, n, [&](size_t i) {
     uintE cluster = clusters[i];
@@ -191,6 +190,17 @@ sequence<edge> tree_and_intercluster_edges(
   return edge_list;
 }
 
+template <class Graph>
+sequence<edge> tree_and_intercluster_edges(
+    Graph& G, sequence<cluster_and_parent>& cluster_and_parents) {
+  size_t n = G.n;
+  auto clusters = parlay::delayed_seq<uintE>(
+      n, [&](size_t i) { return cluster_and_parents[i].cluster; });
+  auto parents = parlay::delayed_seq<uintE>(
+      n, [&](size_t i) { return cluster_and_parents[i].parent; });
+  return tree_and_intercluster_edges(G, clusters, parents);
+}
+
 template <class W>
 struct LDD_Parents_F {
   cluster_and_parent* clusters;
@@ -293,5 +303,14 @@ inline sequence<edge> Spanner(Graph& G, double beta) {
   return Spanner_impl(G, beta);
 }
 
+// Builds the spanner from a precomputed decomposition, e.g., one shared with
+// other stages through an LDDEngine. The stretch of the spanner is
+// O(clustering.rounds).
+template <class Graph>
+inline sequence<edge> Spanner(Graph& G, const LDDClustering& clustering) {
+  return tree_and_intercluster_edges(G, clustering.cluster_ids,
+                                     clustering.parents);
+}
+
 }  // namespace cc
 }  // namespace gbbs
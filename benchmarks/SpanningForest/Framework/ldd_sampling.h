@@ -46,53 +46,44 @@ inline std::pair<sequence<uintE>, sequence<edge>> LDD_sample_edges(
 
   auto Edges = sequence<edge>(n, empty_edge);
 
-  size_t round = 0, num_visited = 0;
-  vertexSubset frontier(n);  // Initially empty
-  size_t num_added = 0;
-  while (num_visited < n) {
-    size_t start = shifts[round];
-    size_t end = std::min(static_cast<size_t>(shifts[round + 1]), n);
-    size_t num_to_add = end - start;
-    if (num_to_add > 0) {
-      assert((num_added + num_to_add) <= n);
-      auto candidates_f = [&](size_t i) {
-        if (permute)
-          return vertex_perm[num_added + i];
-        else
-          return static_cast<uintE>(num_added + i);
-      };
-      auto candidates = parlay::delayed_seq<uintE>(num_to_add, candidates_f);
-      auto pred = [&](uintE v) { return Parents[v] == UINT_E_MAX; };
-      auto new_centers = parlay::filter(candidates, pred);
-      add_to_vsubset(frontier, new_centers.begin(), new_centers.size());
-      parallel_for(0, new_centers.size(), kDefaultGranularity, [&](size_t i) {
-        uintE v = new_centers[i];
-        Parents[v] = v;
-      });
-      num_added += num_to_add;
-    }
-
-    num_visited += frontier.size();
-    if (num_visited >= n) break;
-
-    auto ldd_f = LDD_Edges_Fn<W>(Parents, Edges);
-    vertexSubset next_frontier =
-        edgeMap(G, frontier, ldd_f, -1, sparse_blocked);
-    frontier = std::move(next_frontier);
-
-    round++;
-  }
+  auto order = [&](size_t i) {
+    return permute ? vertex_perm[i] : static_cast<uintE>(i);
+  };
+  auto unvisited = [&](uintE v) { return Parents[v] == UINT_E_MAX; };
+  auto make_center = [&](uintE v) { Parents[v] = v; };
+  auto ldd_f = LDD_Edges_Fn<W>(Parents, Edges);
+  ldd_utils::ldd_rounds(G, shifts, order, unvisited, make_center, ldd_f);
   return std::make_pair(Parents, Edges);
 }
 
+// Returns the clusters and the BFS tree edges of a precomputed decomposition,
+// in the same format as LDD_sample_edges.
+inline std::pair<sequence<uintE>, sequence<edge>> LDD_sample_edges(
+    const LDDClustering& clustering) {
+  size_t n = clustering.cluster_ids.size();
+  auto Edges = sequence<edge>::from_function(n, [&](size_t i) {
+    uintE p = clustering.parents[i];
+    return (p == i) ? empty_edge : std::make_pair(p, static_cast<uintE>(i));
+  });
+  return std::make_pair(clustering.cluster_ids, std::move(Edges));
+}
+
 template <class G>
 struct LDDSamplingTemplate {
   G& GA;
+  const LDDClustering* clustering = nullptr;
 
   LDDSamplingTemplate(G& GA, commandLine& P) : GA(GA) {}
 
+  // Samples using a precomputed decomposition (e.g., from an LDDEngine shared
+  // with other stages) instead of running LDD again.
+  LDDSamplingTemplate(G& GA, const LDDClustering& clustering)
+      : GA(GA), clustering(&clustering) {}
+
   auto initial_spanning_forest() {
-    size_t n = GA.n;
+    if (clustering != nullptr) {
+      return LDD_sample_edges(*clustering);
+    }
 
     timer lddt;
     lddt.start();
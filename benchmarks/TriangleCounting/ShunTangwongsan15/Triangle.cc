@@ -30,9 +30,17 @@
 //     -m : indicate that the graph should be mmap'd
 //     -c : indicate that the graph is compressed
 //     -rounds : the number of times to run the algorithm
+//     -hubdeg : the out-degree at which a vertex intersects by probing an
+//               index of its out-neighbors instead of merging
+//     --sparse : together with --colors or --edenom, estimate the count by
+//                sparsification (see gbbs/sampling_estimator.h for --colors,
+//                --edenom, -samples, -maxsamples, -psamples, -relerr, -conf
+//                and -sampleseed); without either, counts exactly
 
 #include "Triangle.h"
 
+#include "gbbs/sampling_estimator.h"
+
 namespace gbbs {
 
 template <class Graph>
@@ -50,7 +58,19 @@ double Triangle_runner(Graph& G, commandLine P) {
   auto f = [&](uintE u, uintE v, uintE w) {};
   timer t;
   t.start();
-  count = Triangle(G, f, ordering, P);
+  bool sparsify = P.getOptionValue("--sparse");
+  auto options = sampling::ParseSamplingOptions(P);
+  bool sampled = P.getOptionLongValue("--colors", 0) != 0 ||
+                 P.getOptionLongValue("--edenom", 0) != 0;
+  if (sparsify && sampled) {
+    auto count_f = [&](auto& H) { return Triangle(H, f, ordering, P); };
+    auto est = sampling::EstimateCount(G, sampling::TrianglePattern(), count_f,
+                                       options);
+    sampling::PrintEstimate(est, options.confidence);
+    count = llround(est.estimate);
+  } else {
+    count = Triangle(G, f, ordering, P);
+  }
   double tt = t.stop();
   if (P.getOption("-stats")) {
     auto wedge_im_f = [&](size_t i) {
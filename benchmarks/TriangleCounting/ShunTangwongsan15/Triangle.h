@@ -32,6 +32,105 @@
 
 namespace gbbs {
 
+namespace triangle_hub {
+
+// Vertices with at least this many out-neighbors in the directed graph are
+// hubs (see CountDirectedBalanced).
+constexpr size_t kDefaultHubDegree = 1024;
+// The cost of probing the index of a hub relative to one step of a merge.
+constexpr size_t kProbeCost = 2;
+
+// The cost of intersecting the out-neighbors of u and v, where u has du
+// out-neighbors and v has dv.
+inline size_t pair_cost(size_t du, size_t dv, bool hub) {
+  return hub ? std::min(kProbeCost * dv, du + dv) : du + dv;
+}
+
+// A membership index over the out-neighbors of one vertex. If the neighbor
+// ids span a range of at most 64 times the degree, the index is a bitmap over
+// that range, and otherwise it is an open-addressing hash table with at least
+// twice as many slots as neighbors. The index is reused across vertices, so
+// only the words (slots) used by the current vertex are cleared.
+struct NeighborIndex {
+  static constexpr uintE kEmpty = UINT_E_MAX;
+
+  bool dense = false;
+  // Bitmap over [lo, lo + 64 * words).
+  sequence<uint64_t> bits;
+  uintE lo = 0;
+  size_t words = 0;
+  // Hash table with mask + 1 slots.
+  sequence<uintE> table;
+  size_t mask = 0;
+
+  template <class Neighbors>
+  void build(Neighbors& nghs, size_t degree) {
+    uintE min_id = UINT_E_MAX, max_id = 0;
+    auto range_f = [&](const uintE& u, const uintE& v, const auto& wgh) {
+      min_id = std::min(min_id, v);
+      max_id = std::max(max_id, v);
+    };
+    nghs.map(range_f, /*parallel=*/false);
+    if (degree == 0) {
+      dense = true;
+      words = 0;
+      return;
+    }
+    size_t range = size_t{max_id} - min_id + 1;
+    dense = range <= 64 * degree;
+    if (dense) {
+      lo = min_id;
+      words = (range + 63) / 64;
+      if (bits.size() < words) {
+        bits.resize(words, 0);
+      }
+      auto set_f = [&](const uintE& u, const uintE& v, const auto& wgh) {
+        size_t i = v - lo;
+        bits[i >> 6] |= uint64_t{1} << (i & 63);
+      };
+      nghs.map(set_f, /*parallel=*/false);
+    } else {
+      size_t slots = size_t{1} << parlay::log2_up(2 * degree);
+      if (table.size() < slots) {
+        table = sequence<uintE>(slots, kEmpty);
+      }
+      mask = slots - 1;
+      auto insert_f = [&](const uintE& u, const uintE& v, const auto& wgh) {
+        size_t h = parlay::hash64(v) & mask;
+        while (table[h] != kEmpty) {
+          h = (h + 1) & mask;
+        }
+        table[h] = v;
+      };
+      nghs.map(insert_f, /*parallel=*/false);
+    }
+  }
+
+  inline bool contains(uintE v) const {
+    if (dense) {
+      if (v < lo) return false;
+      size_t i = v - lo;
+      return (i >> 6) < words && ((bits[i >> 6] >> (i & 63)) & 1);
+    }
+    size_t h = parlay::hash64(v) & mask;
+    while (table[h] != kEmpty) {
+      if (table[h] == v) return true;
+      h = (h + 1) & mask;
+    }
+    return false;
+  }
+
+  void clear() {
+    if (dense) {
+      for (size_t i = 0; i < words; i++) bits[i] = 0;
+    } else {
+      for (size_t i = 0; i <= mask; i++) table[i] = kEmpty;
+    }
+  }
+};
+
+}  // namespace triangle_hub
+
 template <class Graph>
 struct countF {
   Graph& G;
@@ -96,21 +195,39 @@ inline size_t CountDirected(Graph& DG, size_t* counts, vertexSubset& Frontier) {
 //   f: (uintE, uintE, uintE) -> void
 //     Function that's run each triangle. On a directed triangle like the one
 //     pictured above, we run `f(u, v, w)`.
+//   hub_degree
+//     Vertices u with at least this many out-neighbors are hubs. The
+//     out-neighbors of a hub are split into slices that run in parallel;
+//     every slice builds a bitmap or hash index of the hub's out-neighbors,
+//     and then intersects with the out-neighbors of each v in the slice by
+//     probing the index with them, unless merging the two lists is cheaper.
+//     Other vertices merge. The work estimates used for load balancing use
+//     the cost of the kernel chosen for every pair.
 template <class Graph, class F>
-inline size_t CountDirectedBalanced(Graph& DG, size_t* counts, const F& f) {
+inline size_t CountDirectedBalanced(
+    Graph& DG, size_t* counts, const F& f,
+    size_t hub_degree = triangle_hub::kDefaultHubDegree) {
   using W = typename Graph::weight_type;
   gbbs_debug(std::cout << "Starting counting"
                   << "\n";);
   size_t n = DG.n;
+  auto is_hub = [&](size_t du) { return du >= hub_degree; };
 
+  // parallel_work[i] is the work of vertex i if it is not a hub, and
+  // hub_work[i] its work if it is; both are zero otherwise.
   auto parallel_work = sequence<size_t>::uninitialized(n);
+  auto hub_work = sequence<size_t>::uninitialized(n);
   {
-    auto map_f = [&](uintE u, uintE v, W wgh) -> size_t {
-      return DG.get_vertex(v).out_degree();
-    };
     parallel_for(0, n, [&](size_t i) {
+      size_t du = DG.get_vertex(i).out_degree();
+      bool hub = is_hub(du);
+      auto map_f = [&](uintE u, uintE v, W wgh) -> size_t {
+        return triangle_hub::pair_cost(du, DG.get_vertex(v).out_degree(), hub);
+      };
       auto monoid = parlay::plus<size_t>();
-      parallel_work[i] = DG.get_vertex(i).out_neighbors().reduce(map_f, monoid);
+      size_t work = DG.get_vertex(i).out_neighbors().reduce(map_f, monoid);
+      parallel_work[i] = hub ? 0 : work;
+      hub_work[i] = hub ? work : 0;
     });
   }
   size_t total_work = parlay::scan_inplace(make_slice(parallel_work));
@@ -123,6 +240,7 @@ inline size_t CountDirectedBalanced(Graph& DG, size_t* counts, const F& f) {
 
   auto run_intersection = [&](size_t start_ind, size_t end_ind) {
     for (size_t i = start_ind; i < end_ind; i++) {  // check LEQ
+      if (is_hub(DG.get_vertex(i).out_degree())) continue;
       auto our_neighbors = DG.get_vertex(i).out_neighbors();
       size_t total_ct = 0;
       auto map_f = [&](uintE u, uintE v, W wgh) {
@@ -143,6 +261,75 @@ inline size_t CountDirectedBalanced(Graph& DG, size_t* counts, const F& f) {
     run_intersection(start_ind, end_ind);
   });
 
+  // The out-neighbors of a hub are split into slices of consecutive
+  // neighbors, each of which builds the index of the hub (which costs 2 du)
+  // and runs with its own index, so the slices of a hub run in parallel.
+  auto hubs = parlay::pack_index<uintE>(parlay::delayed_seq<bool>(
+      n, [&](size_t i) { return is_hub(DG.get_vertex(i).out_degree()); }));
+  auto slice_offsets = sequence<size_t>::from_function(
+      hubs.size() + 1, [&](size_t k) -> size_t {
+        if (k == hubs.size()) return 0;
+        size_t du = DG.get_vertex(hubs[k]).out_degree();
+        size_t slices = hub_work[hubs[k]] / std::max(block_size, 2 * du);
+        return std::max<size_t>(std::min(slices, du), 1);
+      });
+  size_t n_slices = parlay::scan_inplace(make_slice(slice_offsets));
+  parallel_for(0, hubs.size(), [&](size_t k) { counts[hubs[k]] = 0; });
+
+  auto init_index = [&](triangle_hub::NeighborIndex* index) {};
+  auto finish_index = [&](triangle_hub::NeighborIndex* index) {
+    if (index != nullptr) {
+      delete index;
+    }
+  };
+  parallel_for_alloc<triangle_hub::NeighborIndex>(
+      init_index, finish_index, 0, n_slices,
+      [&](size_t j, triangle_hub::NeighborIndex* index) {
+        auto less_fn = [&](size_t a, size_t b) { return a <= b; };
+        size_t k = parlay::binary_search(slice_offsets, j, less_fn) - 1;
+        uintE i = hubs[k];
+        auto our_neighbors = DG.get_vertex(i).out_neighbors();
+        size_t du = DG.get_vertex(i).out_degree();
+        size_t slices = slice_offsets[k + 1] - slice_offsets[k];
+        size_t slice = j - slice_offsets[k];
+        size_t begin = slice * du / slices, end = (slice + 1) * du / slices;
+        // Calls g(v, dv, probe) on the out-neighbors v of the slice, where
+        // probe tells whether probing the index is cheaper than merging.
+        auto map_slice = [&](auto g) {
+          size_t pos = 0;
+          auto map_f = [&](uintE u, uintE v, W wgh) {
+            size_t p = pos++;
+            if (p < begin || p >= end) return;
+            size_t dv = DG.get_vertex(v).out_degree();
+            g(v, triangle_hub::kProbeCost * dv < du + dv);
+          };
+          our_neighbors.map(map_f, false);  // run map sequentially
+        };
+        index->build(our_neighbors, du);
+        size_t total_ct = 0;
+        map_slice([&](uintE v, bool probe) {
+          if (!probe) return;
+          auto probe_f = [&](const uintE& x, const uintE& w, const W& wgh) {
+            if (index->contains(w)) {
+              f(i, v, w);
+              total_ct++;
+            }
+          };
+          DG.get_vertex(v).out_neighbors().map(probe_f, false);
+        });
+        index->clear();
+        // The merges run after the index is released, since they are
+        // parallel, and this worker's index may be handed to another slice
+        // while it waits for them.
+        map_slice([&](uintE v, bool probe) {
+          if (probe) return;
+          auto their_neighbors = DG.get_vertex(v).out_neighbors();
+          total_ct += our_neighbors.intersect_f_par(&their_neighbors, f);
+        });
+        if (total_ct > 0) gbbs::write_add(&counts[i], total_ct);
+      },
+      1, false);
+
   auto count_seq = gbbs::make_slice<size_t>(counts, DG.n);
   size_t count = parlay::reduce(count_seq);
 
@@ -165,7 +352,9 @@ inline size_t CountDirectedBalanced(Graph& DG, size_t* counts, const F& f) {
 // Returns:
 //   The number of triangles in `G`.
 template <class Graph, class F>
-inline size_t Triangle_degree_ordering(Graph& G, const F& f) {
+inline size_t Triangle_degree_ordering(
+    Graph& G, const F& f,
+    size_t hub_degree = triangle_hub::kDefaultHubDegree) {
   using W = typename Graph::weight_type;
   timer gt;
   gt.start();
@@ -195,7 +384,7 @@ inline size_t Triangle_degree_ordering(Graph& G, const F& f) {
   timer ct;
   ct.start();
 
-  size_t count = CountDirectedBalanced(DG, counts.begin(), f);
+  size_t count = CountDirectedBalanced(DG, counts.begin(), f, hub_degree);
   std::cout << "### Num triangles = " << count << "\n";
   ct.stop();
   ct.next("count time");
@@ -204,8 +393,9 @@ inline size_t Triangle_degree_ordering(Graph& G, const F& f) {
 }
 
 template <class Graph, class F, class O>
-inline size_t Triangle_degeneracy_ordering(Graph& G, const F& f,
-                                           O ordering_fn) {
+inline size_t Triangle_degeneracy_ordering(
+    Graph& G, const F& f, O ordering_fn,
+    size_t hub_degree = triangle_hub::kDefaultHubDegree) {
   using W = typename Graph::weight_type;
   timer gt;
   gt.start();
@@ -231,7 +421,7 @@ inline size_t Triangle_degeneracy_ordering(Graph& G, const F& f,
   timer ct;
   ct.start();
 
-  size_t count = CountDirectedBalanced(DG, counts.begin(), f);
+  size_t count = CountDirectedBalanced(DG, counts.begin(), f, hub_degree);
   std::cout << "### Num triangles = " << count << "\n";
   ct.stop();
   ct.next("count time");
@@ -241,14 +431,16 @@ inline size_t Triangle_degeneracy_ordering(Graph& G, const F& f,
 template <class Graph, class F>
 inline size_t Triangle(Graph& G, const F& f, const std::string& ordering,
                        commandLine& P) {
+  size_t hub_degree =
+      P.getOptionLongValue("-hubdeg", triangle_hub::kDefaultHubDegree);
   if (ordering == "degree") {
-    return Triangle_degree_ordering<Graph, F>(G, f);
+    return Triangle_degree_ordering<Graph, F>(G, f, hub_degree);
   } else if (ordering == "goodrich") {
     auto eps = P.getOptionDoubleValue("-e", 0.1);
     auto ff = [&](Graph& graph) -> sequence<uintE> {
       return goodrichpszona_degen::DegeneracyOrder_intsort(graph, eps);
     };
-    return Triangle_degeneracy_ordering<Graph, F>(G, f, ff);
+    return Triangle_degeneracy_ordering<Graph, F>(G, f, ff, hub_degree);
   } else if (ordering == "kcore") {
     auto ff = [&](Graph& graph) -> sequence<uintE> {
       auto D = DegeneracyOrder(graph);
@@ -256,12 +448,12 @@ inline size_t Triangle(Graph& G, const F& f, const std::string& ordering,
           graph.n, [&](size_t i) { return D[i]; });
       return ret;
     };
-    return Triangle_degeneracy_ordering<Graph, F>(G, f, ff);
+    return Triangle_degeneracy_ordering<Graph, F>(G, f, ff, hub_degree);
   } else if (ordering == "barenboimelkin") {
     auto ff = [&](Graph& graph) -> sequence<uintE> {
       return barenboimelkin_degen::DegeneracyOrder(graph);
     };
-    return Triangle_degeneracy_ordering<Graph, F>(G, f, ff);
+    return Triangle_degeneracy_ordering<Graph, F>(G, f, ff, hub_degree);
   } else {
     std::cerr << "Unexpected ordering: " << ordering << '\n';
     exit(1);
@@ -0,0 +1,101 @@
+#include "benchmarks/TriangleCounting/ShunTangwongsan15/Triangle.h"
+
+#include <set>
+#include <unordered_set>
+
+#include "gbbs/graph.h"
+#include "gbbs/helpers/undirected_edge.h"
+#include "gbbs/macros.h"
+#include "gbbs/unit_tests/graph_test_utils.h"
+#include "gtest/gtest.h"
+
+namespace gbbs {
+
+namespace {
+
+constexpr uintE kNumVertices = 302;
+
+// A clique on vertices 0, ..., 19, pseudo-random edges between vertices 20,
+// ..., 299, vertex 300 adjacent to every third vertex, and vertex 301
+// adjacent to vertices 0, 150, and 300.
+std::unordered_set<UndirectedEdge> TestEdges() {
+  std::unordered_set<UndirectedEdge> edges;
+  for (uintE i = 0; i < 20; i++) {
+    for (uintE j = i + 1; j < 20; j++) {
+      edges.insert({i, j});
+    }
+  }
+  for (uintE i = 20; i < 300; i++) {
+    for (uintE j = i + 1; j < 300; j++) {
+      if (parlay::hash64(i * kNumVertices + j) % 16 == 0) {
+        edges.insert({i, j});
+      }
+    }
+  }
+  for (uintE i = 0; i < 300; i += 3) {
+    edges.insert({i, 300});
+  }
+  for (uintE i : {0, 150, 300}) {
+    edges.insert({i, 301});
+  }
+  return edges;
+}
+
+size_t BruteForceTriangles(const std::unordered_set<UndirectedEdge>& edges) {
+  std::vector<std::set<uintE>> adj(kNumVertices);
+  for (const auto& e : edges) {
+    auto [u, v] = e.endpoints();
+    adj[u].insert(v);
+    adj[v].insert(u);
+  }
+  size_t count = 0;
+  for (uintE u = 0; u < kNumVertices; u++) {
+    for (uintE v : adj[u]) {
+      if (v <= u) continue;
+      for (uintE w : adj[v]) {
+        if (w > v && adj[u].count(w) > 0) count++;
+      }
+    }
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST(Triangle, HubIntersection) {
+  auto edges = TestEdges();
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(kNumVertices, edges);
+  size_t expected = BruteForceTriangles(edges);
+  ASSERT_GT(expected, size_t{0});
+
+  // A hub degree of 1 makes every vertex with an out-neighbor a hub.
+  for (size_t hub_degree : {size_t{1}, size_t{4}, size_t{16},
+                            triangle_hub::kDefaultHubDegree}) {
+    std::atomic<size_t> calls{0};
+    auto f = [&](uintE u, uintE v, uintE w) { calls++; };
+    EXPECT_EQ(Triangle_degree_ordering(graph, f, hub_degree), expected)
+        << "hub degree " << hub_degree;
+    EXPECT_EQ(calls.load(), expected);
+  }
+}
+
+TEST(Triangle, NeighborIndex) {
+  auto edges = TestEdges();
+  auto graph = graph_test::MakeUnweightedSymmetricGraph(kNumVertices, edges);
+  triangle_hub::NeighborIndex index;
+  // Vertex 0 has mostly consecutive neighbors (a bitmap) and vertex 301 has
+  // spread out neighbors (a hash table).
+  for (uintE u : {uintE{0}, uintE{301}, uintE{0}}) {
+    auto vertex = graph.get_vertex(u);
+    auto neighbors = vertex.out_neighbors();
+    index.build(neighbors, vertex.out_degree());
+    EXPECT_EQ(index.dense, u == 0);
+    for (uintE v = 0; v < kNumVertices; v++) {
+      EXPECT_EQ(index.contains(v), edges.count({u, v}) > 0)
+          << "vertex " << u << " neighbor " << v;
+    }
+    index.clear();
+  }
+}
+
+}  // namespace gbbs
@@ -267,5 +267,116 @@ inline auto contract(Graph& GA, sequence<uintE>& clusters,
   return std::make_tuple(std::move(GC), std::move(flags), std::move(mapping));
 }
 
+// Given a graph and a vertex partitioning of the graph, returns the weighted
+// quotient graph with one vertex per cluster. Unlike contract(), singleton
+// clusters are kept, so vertex i of the quotient graph is exactly cluster i,
+// and the edges are built directly in CSR form without an intermediate
+// symmetrization pass.
+//
+// Arguments:
+//   GA
+//     The (symmetric) graph to contract.
+//   clusters
+//     A `GA.n`-length sequence where `clusters[i]` is the cluster ID of the
+//     i-th vertex. Each cluster ID must be in the range [0, `num_clusters`).
+//   num_clusters
+//     The number of clusters.
+//   weight_f: (uintE, uintE, W) -> AW
+//     Maps an edge of GA to its weight in the quotient graph.
+//   monoid
+//     A parlay monoid over AW (e.g., parlay::plus, parlay::minm, or
+//     parlay::maxm) used to aggregate the weights of all edges of GA between
+//     the same pair of clusters.
+//
+// Returns:
+//   The quotient graph. Intra-cluster edges are dropped. The quotient graph
+//   has vertex weights: the weight of cluster i is the sum of the vertex
+//   weights of its members in GA, or its size if GA has no vertex weights.
+template <class AW, class Graph, class C, class WeightF, class Monoid>
+inline symmetric_graph<symmetric_vertex, AW> contract_weighted(
+    Graph& GA, const C& clusters, size_t num_clusters, WeightF weight_f,
+    Monoid monoid) {
+  using W = typename Graph::weight_type;
+  using g_edge = std::tuple<uintE, uintE, AW>;
+  using neighbor_type = typename symmetric_vertex<AW>::neighbor_type;
+  size_t n = GA.n;
+
+  timer count_t;
+  count_t.start();
+  auto offs = sequence<size_t>::uninitialized(n + 1);
+  auto pred = [&](const uintE& src, const uintE& ngh, const W& w) {
+    return clusters[src] != clusters[ngh];
+  };
+  parallel_for(0, n, 1, [&](size_t i) {
+    offs[i] = GA.get_vertex(i).out_neighbors().count(pred);
+  });
+  offs[n] = 0;
+  size_t total = parlay::scan_inplace(make_slice(offs));
+  gbbs_debug(count_t.next("count time"););
+
+  // Write out the inter-cluster edges. Since GA is symmetric, both
+  // orientations of each quotient edge are produced.
+  auto edges = sequence<g_edge>(total);
+  parallel_for(0, n, 1, [&](size_t i) {
+    size_t k = offs[i];
+    auto map_f = [&](const uintE& src, const uintE& ngh, const W& w) {
+      uintE c_src = clusters[src];
+      uintE c_ngh = clusters[ngh];
+      if (c_src != c_ngh) {
+        edges[k++] = std::make_tuple(c_src, c_ngh, weight_f(src, ngh, w));
+      }
+    };
+    GA.get_vertex(i).out_neighbors().map(map_f, false);
+  });
+  offs.clear();
+  EdgeUtils<AW>::sort_edges_inplace(edges);
+
+  // Aggregate parallel edges.
+  auto is_start = parlay::delayed_seq<bool>(total, [&](size_t i) {
+    return (i == 0) || (std::get<0>(edges[i - 1]) != std::get<0>(edges[i])) ||
+           (std::get<1>(edges[i - 1]) != std::get<1>(edges[i]));
+  });
+  auto starts = parlay::pack_index<size_t>(is_start);
+  size_t m = starts.size();
+  auto agg_edges = sequence<g_edge>::from_function(m, [&](size_t i) {
+    size_t start = starts[i];
+    size_t end = (i == m - 1) ? total : starts[i + 1];
+    AW wgh = std::get<2>(edges[start]);
+    for (size_t j = start + 1; j < end; j++) {
+      wgh = monoid.f(wgh, std::get<2>(edges[j]));
+    }
+    return std::make_tuple(std::get<0>(edges[start]),
+                           std::get<1>(edges[start]), wgh);
+  });
+  edges.clear();
+  starts.clear();
+
+  auto offsets = EdgeUtils<AW>::compute_offsets(num_clusters, agg_edges);
+  auto neighbors =
+      EdgeUtils<AW>::template get_neighbors<symmetric_vertex<AW>>(agg_edges);
+
+  auto v_data = gbbs::new_array_no_init<vertex_data>(num_clusters);
+  auto vertex_weights = gbbs::new_array_no_init<double>(num_clusters);
+  parallel_for(0, num_clusters, [&](size_t i) {
+    v_data[i].offset = offsets[i];
+    v_data[i].degree =
+        ((i == num_clusters - 1) ? m : offsets[i + 1]) - offsets[i];
+    vertex_weights[i] = 0;
+  });
+  parallel_for(0, n, [&](size_t i) {
+    double w = (GA.vertex_weights == nullptr) ? 1.0 : GA.vertex_weights[i];
+    gbbs::write_add(&vertex_weights[clusters[i]], w);
+  });
+
+  return symmetric_graph<symmetric_vertex, AW>(
+      v_data, num_clusters, m,
+      [=]() {
+        gbbs::free_array(v_data, num_clusters);
+        gbbs::free_array(neighbors, m);
+        gbbs::free_array(vertex_weights, num_clusters);
+      },
+      (neighbor_type*)neighbors, vertex_weights);
+}
+
 }  // namespace contract
 }  // namespace gbbs
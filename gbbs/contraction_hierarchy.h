@@ -0,0 +1,163 @@
+#pragma once
+
+#include <vector>
+
+#include "contract.h"
+#include "graph.h"
+
+namespace gbbs {
+namespace contract {
+
+// Atomically sets *a = monoid.f(*a, b). T must be at most 8 bytes.
+template <class T, class Monoid>
+inline void write_combine(T* a, T b, Monoid& monoid) {
+  T old_v, new_v;
+  do {
+    old_v = *a;
+    new_v = monoid.f(old_v, b);
+  } while (!gbbs::atomic_compare_and_swap(a, old_v, new_v));
+}
+
+// A hierarchy of quotient graphs obtained by repeatedly contracting a graph.
+// Level 0 is the input graph (which is not owned by the hierarchy), and level
+// i > 0 is the weighted quotient graph `graph(i)` built by contract_weighted
+// from level i - 1. Edge weights of type W are aggregated with `monoid` at
+// every level, and the vertex weights of each quotient graph are the total
+// vertex weight (by default, the number of input vertices) of each cluster.
+//
+// maps[i] is the vertex mapping from level i to level i + 1, i.e., vertex v
+// of level i is contracted into vertex maps[i][v] of level i + 1.
+template <class W, class Monoid>
+struct ContractionHierarchy {
+  using Graph = symmetric_graph<symmetric_vertex, W>;
+
+  Monoid monoid;
+  std::vector<Graph> levels;
+  std::vector<sequence<uintE>> maps;
+  // The number of vertices on each level, including level 0.
+  std::vector<size_t> level_sizes;
+
+  ContractionHierarchy(size_t n, Monoid monoid) : monoid(monoid) {
+    level_sizes.push_back(n);
+  }
+
+  size_t num_levels() const { return level_sizes.size(); }
+
+  // Returns the quotient graph on level i > 0.
+  Graph& graph(size_t level) {
+    assert(level > 0 && level < num_levels());
+    return levels[level - 1];
+  }
+
+  // Contracts G, the current coarsest level, using the given cluster ids
+  // (arbitrary values in [0, G.n)), and appends the quotient graph as a new
+  // level. weight_f maps an edge of G to its weight in the quotient graph.
+  template <class G, class WeightF>
+  Graph& add_level(G& GA, sequence<uintE> clusters, WeightF weight_f) {
+    assert(GA.n == level_sizes.back());
+    size_t num_clusters = RelabelIds(clusters);
+    levels.push_back(contract_weighted<W>(GA, clusters, num_clusters,
+                                          weight_f, monoid));
+    maps.push_back(std::move(clusters));
+    level_sizes.push_back(num_clusters);
+    return levels.back();
+  }
+
+  // Returns the composite mapping from the vertices of level `from` to their
+  // vertex on the coarser level `to`.
+  sequence<uintE> vertex_map(size_t from, size_t to) const {
+    assert(from <= to && to < num_levels());
+    auto map = sequence<uintE>::from_function(level_sizes[from],
+                                              [&](size_t i) { return i; });
+    for (size_t level = from; level < to; level++) {
+      auto& level_map = maps[level];
+      parallel_for(0, map.size(), kDefaultGranularity,
+                   [&](size_t i) { map[i] = level_map[map[i]]; });
+    }
+    return map;
+  }
+
+  // Projects per-vertex values on level `from` down to the finer level `to`:
+  // every vertex takes the value of the vertex it was contracted into.
+  template <class T>
+  sequence<T> project_down(const sequence<T>& values, size_t from,
+                           size_t to) const {
+    assert(to <= from && values.size() == level_sizes[from]);
+    auto map = vertex_map(to, from);
+    return sequence<T>::from_function(map.size(),
+                                      [&](size_t i) { return values[map[i]]; });
+  }
+
+  // Projects per-vertex values on level `from` up to the coarser level `to`,
+  // combining the values of all vertices contracted together using
+  // `value_monoid`. T must be at most 8 bytes.
+  template <class T, class M>
+  sequence<T> project_up(const sequence<T>& values, size_t from, size_t to,
+                         M value_monoid) const {
+    assert(from <= to && values.size() == level_sizes[from]);
+    auto map = vertex_map(from, to);
+    auto out = sequence<T>(level_sizes[to], value_monoid.identity);
+    parallel_for(0, map.size(), kDefaultGranularity, [&](size_t i) {
+      write_combine(&out[map[i]], values[i], value_monoid);
+    });
+    return out;
+  }
+};
+
+// Builds a contraction hierarchy on top of G.
+//
+// Arguments:
+//   G
+//     The (symmetric) input graph; it is level 0 of the hierarchy.
+//   cluster_f: (Graph&, size_t level) -> sequence<uintE>
+//     Computes the clustering of the graph on the given level. It is called
+//     both with G and with the quotient graphs, so it should be generic (e.g.,
+//     a lambda taking `auto&`). Any clustering works: an LDD, label
+//     propagation labels, or the endpoints of a matching.
+//   weight_f: (uintE, uintE, G::weight_type) -> W
+//     Maps the edges of G to quotient edge weights. Edges of quotient graphs
+//     keep their aggregated weights on subsequent levels.
+//   monoid
+//     Aggregates the weights of parallel edges (parlay::plus for sums,
+//     parlay::minm and parlay::maxm for minimum and maximum weights).
+//   max_levels
+//     The maximum number of levels, including level 0.
+//   min_vertices
+//     Contraction stops once the coarsest level has at most this many
+//     vertices.
+//   max_shrink
+//     Contraction stops once a level fails to reduce the number of vertices
+//     below max_shrink times the number of vertices on the previous level.
+template <class W, class Graph, class ClusterF, class WeightF, class Monoid>
+inline ContractionHierarchy<W, Monoid> build_contraction_hierarchy(
+    Graph& G, ClusterF cluster_f, WeightF weight_f, Monoid monoid,
+    size_t max_levels = std::numeric_limits<size_t>::max(),
+    size_t min_vertices = 1, double max_shrink = 0.95) {
+  auto H = ContractionHierarchy<W, Monoid>(G.n, monoid);
+  auto identity_f = [](const uintE& u, const uintE& v, const W& w) {
+    return w;
+  };
+  auto contract_level = [&](auto& GL, auto& level_weight_f) {
+    size_t level = H.num_levels() - 1;
+    timer level_t;
+    level_t.start();
+    auto& GC = H.add_level(GL, cluster_f(GL, level), level_weight_f);
+    gbbs_debug(std::cout << "# level " << (level + 1) << ": n = " << GC.n
+                         << " m = " << GC.m << std::endl;
+               level_t.next("contract level time"););
+    return GC.n;
+  };
+
+  if (max_levels < 2 || G.n <= min_vertices) return H;
+  size_t prev_n = G.n;
+  size_t cur_n = contract_level(G, weight_f);
+  while (H.num_levels() < max_levels && cur_n > min_vertices &&
+         cur_n < max_shrink * prev_n && H.levels.back().m > 0) {
+    prev_n = cur_n;
+    cur_n = contract_level(H.levels.back(), identity_f);
+  }
+  return H;
+}
+
+}  // namespace contract
+}  // namespace gbbs
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+#include "bridge.h"
+#include "macros.h"
+
+namespace gbbs {
+
+// A cache-blocked ("propagation blocking") sparse matrix-vector product over
+// the out-edges of a graph. Computing
+//
+//   out[v] = sum over edges (u, v, w) of edge_f(u, v, w)
+//
+// with edgeMap either reads the source values at random (pull) or adds into
+// out[v] at random (push), and for large graphs every such access misses the
+// cache. Instead, the destination vertices are partitioned into bins of
+// consecutive vertices whose part of `out` fits in the L2 cache, and a product
+// is computed in two passes:
+//
+//   1. Binning: the source vertices are split into chunks with roughly equal
+//      numbers of edges. Each chunk scans the out-edges of its vertices in
+//      order and appends every contribution to the buffer of the bin of its
+//      destination. Every chunk owns a contiguous part of each bin's buffer,
+//      so the writes are sequential streams and need no atomics.
+//   2. Accumulation: each bin sums its buffer into its (cache-resident) range
+//      of `out`.
+//
+// The destination of every buffer slot depends only on the graph, so the bin
+// layout and destination ids are computed once when the engine is built and
+// reused by every product; a product only writes and reads the contribution
+// values. The engine uses m * (sizeof(uintE) + sizeof(T)) bytes for the
+// buffers, plus two cursors per (chunk, bin) pair.
+//
+// The graph must not change while the engine is in use, and products must not
+// run concurrently on the same engine (they share the pass cursors).
+template <class Graph, class T = double>
+struct BlockedSpMV {
+  // 256KB of destination values per bin.
+  static constexpr size_t kDefaultBinBytes = size_t{1} << 18;
+  // Minimum number of edges per chunk of source vertices.
+  static constexpr size_t kMinChunkEdges = 4096;
+
+  const Graph& G;
+  size_t n;
+  size_t m;
+  // Every bin contains 2^bin_shift consecutive destination vertices.
+  size_t bin_shift;
+  size_t num_bins;
+  size_t num_chunks;
+  // Source chunk c is the vertex range [chunk_starts[c], chunk_starts[c + 1]).
+  sequence<uintE> chunk_starts;
+  // The buffer of bin b is [bin_offsets[b], bin_offsets[b + 1]).
+  sequence<size_t> bin_offsets;
+  // cursors[c * num_bins + b] is the first slot of chunk c in bin b.
+  sequence<size_t> cursors;
+  // The next slot of every (chunk, bin) pair during a pass, reset from
+  // cursors at the start of each pass.
+  sequence<size_t> pass_cursors;
+  // The destination vertex of every buffer slot.
+  sequence<uintE> dests;
+  // The contribution stored in every buffer slot; rewritten by each product.
+  sequence<T> values;
+
+  BlockedSpMV(const Graph& G, size_t bin_bytes = kDefaultBinBytes)
+      : G(G), n(G.n), m(0) {
+    timer pt;
+    pt.start();
+    size_t bin_width = std::max<size_t>(bin_bytes / sizeof(T), 1);
+    bin_shift = parlay::log2_up(bin_width + 1) - 1;
+    num_bins = std::max<size_t>((n + (size_t{1} << bin_shift) - 1) >> bin_shift,
+                                1);
+
+    auto degrees = sequence<size_t>::from_function(
+        n + 1, [&](size_t i) -> size_t {
+          return (i == n) ? 0 : G.get_vertex(i).out_degree();
+        });
+    m = parlay::scan_inplace(make_slice(degrees));
+    num_chunks = std::min<size_t>(
+        std::max<size_t>(m / kMinChunkEdges, 1), 8 * num_workers());
+    chunk_starts = sequence<uintE>::from_function(
+        num_chunks + 1, [&](size_t c) -> uintE {
+          if (c == num_chunks) return n;
+          size_t target = (m * c) / num_chunks;
+          return std::lower_bound(degrees.begin(), degrees.begin() + n,
+                                  target) -
+                 degrees.begin();
+        });
+
+    // Count the edges of each chunk going to each bin.
+    auto counts = sequence<size_t>(num_chunks * num_bins, 0);
+    parallel_for(0, num_chunks, 1, [&](size_t c) {
+      size_t* chunk_counts = counts.begin() + c * num_bins;
+      for (uintE u = chunk_starts[c]; u < chunk_starts[c + 1]; u++) {
+        auto count_f = [&](const uintE& s, const uintE& d, const auto& w) {
+          chunk_counts[d >> bin_shift]++;
+        };
+        G.get_vertex(u).out_neighbors().map(count_f, /*parallel=*/false);
+      }
+    });
+
+    // Lay out the buffers bin by bin, and within a bin chunk by chunk.
+    auto bin_major = sequence<size_t>::from_function(
+        num_bins * num_chunks + 1, [&](size_t i) -> size_t {
+          if (i == num_bins * num_chunks) return 0;
+          size_t b = i / num_chunks, c = i % num_chunks;
+          return counts[c * num_bins + b];
+        });
+    parlay::scan_inplace(make_slice(bin_major));
+    bin_offsets = sequence<size_t>::from_function(
+        num_bins + 1, [&](size_t b) { return bin_major[b * num_chunks]; });
+    cursors = std::move(counts);
+    parallel_for(0, num_chunks * num_bins, kDefaultGranularity, [&](size_t i) {
+      size_t c = i / num_bins, b = i % num_bins;
+      cursors[i] = bin_major[b * num_chunks + c];
+    });
+    pass_cursors = sequence<size_t>::uninitialized(num_chunks * num_bins);
+
+    dests = sequence<uintE>::uninitialized(m);
+    values = sequence<T>::uninitialized(m);
+    bin_pass([&](const uintE& s, const uintE& d, const auto& w,
+                 size_t slot) { dests[slot] = d; });
+    gbbs_debug(std::cout << "# blocked spmv: bins = " << num_bins
+                         << " chunks = " << num_chunks << std::endl;
+               pt.next("blocked spmv preprocessing time"););
+  }
+
+  // Calls slot_f(u, v, w, slot) for every edge, where slot is the buffer slot
+  // assigned to the edge.
+  template <class SlotF>
+  void bin_pass(SlotF slot_f) {
+    parallel_for(0, num_chunks, 1, [&](size_t c) {
+      size_t* cursor = pass_cursors.begin() + c * num_bins;
+      std::copy(cursors.begin() + c * num_bins,
+                cursors.begin() + (c + 1) * num_bins, cursor);
+      for (uintE u = chunk_starts[c]; u < chunk_starts[c + 1]; u++) {
+        auto map_f = [&](const uintE& s, const uintE& d, const auto& w) {
+          slot_f(s, d, w, cursor[d >> bin_shift]++);
+        };
+        G.get_vertex(u).out_neighbors().map(map_f, /*parallel=*/false);
+      }
+    });
+  }
+
+  // Sets out[v] to the sum of edge_f(u, v, w) over the in-edges (u, v, w) of
+  // every vertex v; vertices without in-edges get T(0). edge_f is called
+  // exactly once per edge. out must have room for n values.
+  template <class EdgeF>
+  void multiply(EdgeF edge_f, T* out) {
+    bin_pass([&](const uintE& s, const uintE& d, const auto& w, size_t slot) {
+      values[slot] = edge_f(s, d, w);
+    });
+    parallel_for(0, num_bins, 1, [&](size_t b) {
+      size_t lo = b << bin_shift;
+      size_t hi = std::min(n, (b + 1) << bin_shift);
+      for (size_t v = lo; v < hi; v++) {
+        out[v] = T(0);
+      }
+      for (size_t i = bin_offsets[b]; i < bin_offsets[b + 1]; i++) {
+        out[dests[i]] += values[i];
+      }
+    });
+  }
+
+  template <class EdgeF>
+  void multiply(EdgeF edge_f, sequence<T>& out) {
+    assert(out.size() == n);
+    multiply(edge_f, out.begin());
+  }
+};
+
+template <class T = double, class Graph>
+inline BlockedSpMV<Graph, T> make_blocked_spmv(
+    const Graph& G,
+    size_t bin_bytes = BlockedSpMV<Graph, T>::kDefaultBinBytes) {
+  return BlockedSpMV<Graph, T>(G, bin_bytes);
+}
+
+}  // namespace gbbs
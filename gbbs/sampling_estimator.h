@@ -0,0 +1,248 @@
+#pragma once
+
+#include <math.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "bridge.h"
+#include "graph.h"
+#include "helpers/parse_command_line.h"
+#include "interface.h"
+#include "macros.h"
+
+namespace gbbs {
+namespace sampling {
+
+// Approximate subgraph counting by sparsification. A sample keeps a random
+// subset of the edges of a symmetric graph and counts the copies of the
+// pattern (triangles, k-cliques, 5-cycles, ...) in the sparsified graph; a
+// copy survives with a fixed probability q, so the count divided by q is an
+// unbiased estimate of the exact count.
+//
+//  - Colorful sparsification (Pagh and Tsourakakis, "Colorful triangle
+//    counting and a MapReduce implementation") colors the vertices with
+//    `denom` colors and keeps the edges whose endpoints have the same color;
+//    a connected pattern on k vertices survives with q = denom^-(k - 1).
+//  - Edge sparsification (Tsourakakis et al., "DOULION: counting triangles in
+//    massive graphs with a coin") keeps every edge with probability
+//    1 / denom; a pattern with e edges survives with q = denom^-e.
+//
+// The estimator runs independent samples with different seeds, several at a
+// time in parallel, and reports the mean of the scaled counts together with
+// the empirical variance and a normal confidence interval for the mean. With
+// a target relative error, it keeps adding samples until the half-width of
+// the interval is at most that fraction of the estimate (or until
+// max_samples).
+enum class Sparsification { kColorful, kEdge };
+
+// The number of vertices and edges of the counted pattern.
+struct Pattern {
+  size_t vertices;
+  size_t edges;
+};
+
+inline Pattern TrianglePattern() { return {3, 3}; }
+inline Pattern CliquePattern(size_t k) { return {k, k * (k - 1) / 2}; }
+inline Pattern CyclePattern(size_t k) { return {k, k}; }
+
+struct SamplingOptions {
+  Sparsification method = Sparsification::kColorful;
+  // The number of colors, or the inverse of the edge sampling probability.
+  size_t denom = 2;
+  size_t min_samples = 4;
+  size_t max_samples = 64;
+  // The number of samples run at a time.
+  size_t parallel_samples = 4;
+  double confidence = 0.95;
+  // Stop once the relative half-width of the confidence interval is at most
+  // this value; 0 runs exactly min_samples samples.
+  double target_relative_error = 0.0;
+  size_t seed = 0;
+};
+
+struct Estimate {
+  double estimate = 0.0;
+  // The empirical variance of the scaled sample counts.
+  double sample_variance = 0.0;
+  // The standard error of the estimate.
+  double std_error = 0.0;
+  // The confidence interval of the estimate.
+  double lower = 0.0;
+  double upper = 0.0;
+  size_t samples = 0;
+
+  double relative_error() const {
+    double half_width = (upper - lower) / 2;
+    if (half_width == 0) return 0.0;
+    return (estimate == 0) ? std::numeric_limits<double>::infinity()
+                           : half_width / estimate;
+  }
+};
+
+// The z such that a standard normal variable lies in [-z, z] with
+// probability `confidence`.
+inline double normal_quantile(double confidence) {
+  double lo = 0.0, hi = 40.0;
+  for (size_t i = 0; i < 100; i++) {
+    double mid = (lo + hi) / 2;
+    if (std::erf(mid / std::sqrt(2.0)) < confidence) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  return (lo + hi) / 2;
+}
+
+// Returns the subgraph of G with the edges whose endpoints get the same of
+// `colors` colors.
+template <class Graph>
+inline auto ColorfulSparsify(Graph& G, size_t colors, size_t seed) {
+  using W = typename Graph::weight_type;
+  size_t num_colors = std::max<size_t>(colors, 1);
+  auto vertex_colors = sequence<uintE>::from_function(G.n, [&](size_t i) {
+    return parlay::hash64(parlay::hash64(seed) + i) % num_colors;
+  });
+  auto pred = [&](const uintE& u, const uintE& v, const W& wgh) {
+    return vertex_colors[u] == vertex_colors[v];
+  };
+  return filterGraph(G, pred);
+}
+
+// Returns the subgraph of G with every edge kept with probability 1 / denom.
+// Both directions of an edge are kept or removed together.
+template <class Graph>
+inline auto EdgeSparsify(Graph& G, size_t denom, size_t seed) {
+  using W = typename Graph::weight_type;
+  size_t d = std::max<size_t>(denom, 1);
+  size_t n = G.n;
+  size_t salt = parlay::hash64(seed);
+  auto pred = [&](const uintE& u, const uintE& v, const W& wgh) {
+    size_t key = size_t{std::min(u, v)} * n + std::max(u, v);
+    return parlay::hash64(salt ^ parlay::hash64(key)) % d == 0;
+  };
+  return filterGraph(G, pred);
+}
+
+// Returns 1 / q, where q is the probability that a copy of the pattern
+// survives the sparsification.
+inline double scale_factor(const SamplingOptions& options, Pattern pattern) {
+  double d = std::max<size_t>(options.denom, 1);
+  if (options.method == Sparsification::kColorful) {
+    return pow(d, pattern.vertices - 1);
+  }
+  return pow(d, pattern.edges);
+}
+
+inline Estimate summarize(const std::vector<double>& values,
+                          double confidence) {
+  Estimate est;
+  est.samples = values.size();
+  if (values.empty()) return est;
+  double r = values.size();
+  double sum = 0;
+  for (double x : values) sum += x;
+  est.estimate = sum / r;
+  if (values.size() > 1) {
+    double squares = 0;
+    for (double x : values) {
+      squares += (x - est.estimate) * (x - est.estimate);
+    }
+    est.sample_variance = squares / (r - 1);
+    est.std_error = std::sqrt(est.sample_variance / r);
+  }
+  double half_width = normal_quantile(confidence) * est.std_error;
+  est.lower = std::max(est.estimate - half_width, 0.0);
+  est.upper = est.estimate + half_width;
+  return est;
+}
+
+// Estimates the number of copies of `pattern` in the symmetric graph G, where
+// count_f(H) returns the exact count in a sparsified graph H. count_f is
+// called concurrently on different graphs.
+template <class Graph, class CountF>
+inline Estimate EstimateCount(Graph& G, Pattern pattern, CountF count_f,
+                              const SamplingOptions& options = {}) {
+  double scale = scale_factor(options, pattern);
+  size_t min_samples = std::max<size_t>(options.min_samples, 2);
+  size_t max_samples = std::max(options.max_samples, min_samples);
+  size_t parallel_samples = std::max<size_t>(options.parallel_samples, 1);
+  std::vector<double> values;
+  Estimate est;
+  while (values.size() < max_samples) {
+    size_t remaining = max_samples - values.size();
+    size_t batch = (values.size() < min_samples)
+                       ? min_samples - values.size()
+                       : std::min(parallel_samples, remaining);
+    size_t first = values.size();
+    auto counts = sequence<double>(batch, 0.0);
+    // Samples in a batch are independent; run up to parallel_samples at a
+    // time.
+    for (size_t start = 0; start < batch; start += parallel_samples) {
+      size_t end = std::min(batch, start + parallel_samples);
+      parallel_for(start, end, 1, [&](size_t i) {
+        size_t seed = options.seed + first + i;
+        if (options.method == Sparsification::kColorful) {
+          auto H = ColorfulSparsify(G, options.denom, seed);
+          counts[i] = scale * static_cast<double>(count_f(H));
+        } else {
+          auto H = EdgeSparsify(G, options.denom, seed);
+          counts[i] = scale * static_cast<double>(count_f(H));
+        }
+      });
+    }
+    values.insert(values.end(), counts.begin(), counts.end());
+    est = summarize(values, options.confidence);
+    gbbs_debug(std::cout << "# samples = " << est.samples
+                         << " estimate = " << est.estimate
+                         << " relative error = " << est.relative_error()
+                         << std::endl;);
+    if (options.target_relative_error <= 0 ||
+        est.relative_error() <= options.target_relative_error) {
+      break;
+    }
+  }
+  return est;
+}
+
+// Reads the sampling options shared by the approximate counting benchmarks:
+//   --colors : use colorful sparsification with this many colors
+//   --edenom : use edge sparsification, keeping every edge with probability
+//              1 / edenom
+//   -samples, -maxsamples : the minimum and maximum number of samples
+//   -psamples : the number of samples run at a time
+//   -relerr : the target relative error (0 runs -samples samples)
+//   -conf : the confidence level of the reported interval
+//   -sampleseed : the seed of the first sample
+inline SamplingOptions ParseSamplingOptions(const commandLine& P) {
+  SamplingOptions options;
+  long colors = P.getOptionLongValue("--colors", 0);
+  long edenom = P.getOptionLongValue("--edenom", 0);
+  if (colors == 0 && edenom != 0) {
+    options.method = Sparsification::kEdge;
+    options.denom = edenom;
+  } else {
+    options.denom = std::max<long>(colors, 1);
+  }
+  options.min_samples = P.getOptionLongValue("-samples", 4);
+  options.max_samples = P.getOptionLongValue("-maxsamples", 64);
+  options.parallel_samples = P.getOptionLongValue("-psamples", 4);
+  options.target_relative_error = P.getOptionDoubleValue("-relerr", 0.0);
+  options.confidence = P.getOptionDoubleValue("-conf", 0.95);
+  options.seed = P.getOptionLongValue("-sampleseed", 7398234);
+  return options;
+}
+
+inline void PrintEstimate(const Estimate& est, double confidence) {
+  std::cout << "### Estimate: " << est.estimate << " (" << (100 * confidence)
+            << "% CI [" << est.lower << ", " << est.upper
+            << "], relative error " << est.relative_error() << ")"
+            << std::endl;
+  std::cout << "### Samples: " << est.samples
+            << " sample variance: " << est.sample_variance << std::endl;
+}
+
+}  // namespace sampling
+}  // namespace gbbs
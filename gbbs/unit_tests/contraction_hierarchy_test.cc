@@ -0,0 +1,91 @@
+#include "gbbs/contraction_hierarchy.h"
+
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+#include "gbbs/helpers/undirected_edge.h"
+#include "gbbs/unit_tests/graph_test_utils.h"
+#include "gtest/gtest.h"
+
+namespace gbbs {
+
+namespace {
+
+using WeightedNeighbors = std::vector<std::tuple<uintE, size_t>>;
+
+template <class Graph>
+WeightedNeighbors GetNeighbors(Graph& G, uintE v) {
+  WeightedNeighbors neighbors;
+  auto map_f = [&](const uintE& u, const uintE& ngh, const size_t& w) {
+    neighbors.emplace_back(ngh, w);
+  };
+  G.get_vertex(v).out_neighbors().map(map_f, /* parallel = */ false);
+  return neighbors;
+}
+
+// Clusters vertices 2i and 2i + 1 together.
+auto PairClustering = [](auto& G, size_t level) {
+  return sequence<uintE>::from_function(G.n, [](size_t i) { return i / 2; });
+};
+
+auto UnitWeight = [](const uintE& u, const uintE& v, const gbbs::empty& w) {
+  return size_t{1};
+};
+
+}  // namespace
+
+TEST(ContractWeighted, AggregatesParallelEdges) {
+  // Graph diagram: the complete graph on {0, 1, 2, 3}, contracted with the
+  // clusters {0, 1} and {2, 3}.
+  auto G = graph_test::MakeUnweightedSymmetricGraph(
+      4, {{0, 1}, {0, 2}, {0, 3}, {1, 2}, {1, 3}, {2, 3}});
+  auto clusters = sequence<uintE>({0, 0, 1, 1});
+
+  auto sum_graph = contract::contract_weighted<size_t>(
+      G, clusters, 2, UnitWeight, parlay::plus<size_t>());
+  ASSERT_EQ(sum_graph.n, 2);
+  ASSERT_EQ(sum_graph.m, 2);
+  EXPECT_EQ(GetNeighbors(sum_graph, 0), (WeightedNeighbors{{1, 4}}));
+  EXPECT_EQ(GetNeighbors(sum_graph, 1), (WeightedNeighbors{{0, 4}}));
+  EXPECT_EQ(sum_graph.vertex_weights[0], 2.0);
+  EXPECT_EQ(sum_graph.vertex_weights[1], 2.0);
+
+  auto max_graph = contract::contract_weighted<size_t>(
+      G, clusters, 2, UnitWeight, parlay::maxm<size_t>());
+  EXPECT_EQ(GetNeighbors(max_graph, 0), (WeightedNeighbors{{1, 1}}));
+}
+
+TEST(ContractionHierarchy, PathGraph) {
+  // Graph diagram: 0 - 1 - 2 - 3 - 4 - 5 - 6 - 7
+  auto G = graph_test::MakeUnweightedSymmetricGraph(
+      8, {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}, {5, 6}, {6, 7}});
+  auto H = contract::build_contraction_hierarchy<size_t>(
+      G, PairClustering, UnitWeight, parlay::plus<size_t>(),
+      /* max_levels = */ 10, /* min_vertices = */ 2);
+
+  ASSERT_EQ(H.num_levels(), 3);
+  EXPECT_EQ(H.level_sizes, (std::vector<size_t>{8, 4, 2}));
+  auto& G1 = H.graph(1);
+  EXPECT_EQ(G1.m, 6);
+  auto& G2 = H.graph(2);
+  ASSERT_EQ(G2.m, 2);
+  EXPECT_EQ(GetNeighbors(G2, 0), (WeightedNeighbors{{1, 1}}));
+  EXPECT_EQ(G2.vertex_weights[0], 4.0);
+
+  auto map = H.vertex_map(0, 2);
+  EXPECT_EQ(std::vector<uintE>(map.begin(), map.end()),
+            (std::vector<uintE>{0, 0, 0, 0, 1, 1, 1, 1}));
+
+  auto coarse_labels = sequence<uintE>({7, 9});
+  auto fine_labels = H.project_down(coarse_labels, 2, 0);
+  EXPECT_EQ(std::vector<uintE>(fine_labels.begin(), fine_labels.end()),
+            (std::vector<uintE>{7, 7, 7, 7, 9, 9, 9, 9}));
+
+  auto ones = sequence<size_t>(8, 1);
+  auto sizes = H.project_up(ones, 0, 1, parlay::plus<size_t>());
+  EXPECT_EQ(std::vector<size_t>(sizes.begin(), sizes.end()),
+            (std::vector<size_t>{2, 2, 2, 2}));
+}
+
+}  // namespace gbbs
@@ -55,5 +55,51 @@ asymmetric_graph<asymmetric_vertex, gbbs::empty> MakeUnweightedAsymmetricGraph(
       edge_sequence, num_vertices);
 }
 
+std::unordered_set<UndirectedEdge> RandomUndirectedEdges(
+    const uintE num_vertices, const double edge_probability,
+    const uint64_t seed) {
+  // A 64-bit linear congruential generator, whose top 31 bits decide each
+  // pair, so the edges do not depend on the standard library.
+  const uint64_t threshold = edge_probability * (uint64_t{1} << 31);
+  uint64_t state = seed;
+  std::unordered_set<UndirectedEdge> edges;
+  for (uintE u = 0; u < num_vertices; u++) {
+    for (uintE v = u + 1; v < num_vertices; v++) {
+      state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+      if ((state >> 33) < threshold) {
+        edges.insert({u, v});
+      }
+    }
+  }
+  return edges;
+}
+
+symmetric_graph<symmetric_vertex, gbbs::empty> MakeRandomSymmetricGraph(
+    const uintE num_vertices, const double edge_probability,
+    const uint64_t seed) {
+  return MakeUnweightedSymmetricGraph(
+      num_vertices,
+      RandomUndirectedEdges(num_vertices, edge_probability, seed));
+}
+
+std::vector<std::set<uintE>> MakeAdjacencySets(
+    const uintE num_vertices, const std::unordered_set<UndirectedEdge>& edges) {
+  std::vector<std::set<uintE>> adjacency(num_vertices);
+  for (const auto& edge : edges) {
+    const auto [u, v] = edge.endpoints();
+    adjacency[u].insert(v);
+    adjacency[v].insert(u);
+  }
+  return adjacency;
+}
+
+std::vector<std::set<uintE>> RandomAdjacencySets(const uintE num_vertices,
+                                                 const double edge_probability,
+                                                 const uint64_t seed) {
+  return MakeAdjacencySets(
+      num_vertices,
+      RandomUndirectedEdges(num_vertices, edge_probability, seed));
+}
+
 }  // namespace graph_test
 }  // namespace gbbs
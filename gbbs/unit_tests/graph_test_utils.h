@@ -2,6 +2,7 @@
 // tests.
 #pragma once
 
+#include <set>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -44,6 +45,30 @@ MakeUnweightedSymmetricPtrGraph(
 asymmetric_graph<asymmetric_vertex, gbbs::empty> MakeUnweightedSymmetricGraph(
     const uintE num_vertices, const std::unordered_set<DirectedEdge>& edges);
 
+// Returns the edges of a pseudo-random graph on `num_vertices` vertices, in
+// which every pair of vertices is an edge with probability about
+// `edge_probability`. The same arguments always give the same edges.
+std::unordered_set<UndirectedEdge> RandomUndirectedEdges(
+    const uintE num_vertices, const double edge_probability,
+    const uint64_t seed);
+
+// Make the undirected, unweighted graph whose edges are
+// RandomUndirectedEdges(num_vertices, edge_probability, seed).
+symmetric_graph<symmetric_vertex, gbbs::empty> MakeRandomSymmetricGraph(
+    const uintE num_vertices, const double edge_probability,
+    const uint64_t seed);
+
+// Make the adjacency sets of an undirected graph from a list of edges, e.g.,
+// for brute-force reference implementations in tests.
+std::vector<std::set<uintE>> MakeAdjacencySets(
+    const uintE num_vertices, const std::unordered_set<UndirectedEdge>& edges);
+
+// The adjacency sets of the graph MakeRandomSymmetricGraph(num_vertices,
+// edge_probability, seed).
+std::vector<std::set<uintE>> RandomAdjacencySets(const uintE num_vertices,
+                                                 const double edge_probability,
+                                                 const uint64_t seed);
+
 // Check that vertex has `expected_neighbors` as its out-neighbors. Does not
 // check edge weights. Ordering matters.
 template <class Vertex>
@@ -0,0 +1,112 @@
+#include "gbbs/sampling_estimator.h"
+
+#include <math.h>
+
+#include <unordered_set>
+
+#include "gbbs/helpers/undirected_edge.h"
+#include "gbbs/unit_tests/graph_test_utils.h"
+#include "gtest/gtest.h"
+
+namespace gbbs {
+namespace sampling {
+
+namespace {
+
+constexpr uintE kNumVertices = 200;
+
+// Pseudo-random edges between 200 vertices, about a quarter of all pairs.
+auto TestGraph() {
+  std::unordered_set<UndirectedEdge> edges;
+  for (uintE i = 0; i < kNumVertices; i++) {
+    for (uintE j = i + 1; j < kNumVertices; j++) {
+      if (parlay::hash64(i * kNumVertices + j) % 4 == 0) {
+        edges.insert({i, j});
+      }
+    }
+  }
+  return graph_test::MakeUnweightedSymmetricGraph(kNumVertices, edges);
+}
+
+// Counts the undirected edges of a symmetric graph.
+auto CountEdges = [](auto& H) { return H.m / 2; };
+
+constexpr Pattern kEdgePattern = {2, 1};
+
+}  // namespace
+
+TEST(SamplingEstimator, NormalQuantile) {
+  EXPECT_NEAR(normal_quantile(0.95), 1.959964, 1e-4);
+  EXPECT_NEAR(normal_quantile(0.99), 2.575829, 1e-4);
+}
+
+TEST(SamplingEstimator, ScaleFactor) {
+  SamplingOptions options;
+  options.denom = 3;
+  EXPECT_EQ(scale_factor(options, TrianglePattern()), 9.0);
+  EXPECT_EQ(scale_factor(options, CliquePattern(4)), 27.0);
+  options.method = Sparsification::kEdge;
+  EXPECT_EQ(scale_factor(options, TrianglePattern()), 27.0);
+  EXPECT_EQ(scale_factor(options, CyclePattern(5)), 243.0);
+}
+
+TEST(SamplingEstimator, EdgeSparsifyIsSymmetric) {
+  auto graph = TestGraph();
+  auto H = EdgeSparsify(graph, 3, 11);
+  EXPECT_GT(H.m, size_t{0});
+  EXPECT_LT(H.m, graph.m);
+  for (uintE u = 0; u < kNumVertices; u++) {
+    auto map_f = [&](const uintE& src, const uintE& v, const auto& wgh) {
+      size_t back = 0;
+      auto back_f = [&](const uintE& s, const uintE& w, const auto& wgh2) {
+        back += (w == u);
+      };
+      H.get_vertex(v).out_neighbors().map(back_f, /*parallel=*/false);
+      EXPECT_EQ(back, size_t{1}) << "edge " << u << " " << v;
+    };
+    H.get_vertex(u).out_neighbors().map(map_f, /*parallel=*/false);
+  }
+}
+
+TEST(SamplingEstimator, ExactWithoutSparsification) {
+  auto graph = TestGraph();
+  SamplingOptions options;
+  options.denom = 1;
+  auto est = EstimateCount(graph, kEdgePattern, CountEdges, options);
+  EXPECT_EQ(est.estimate, static_cast<double>(graph.m / 2));
+  EXPECT_EQ(est.sample_variance, 0.0);
+  EXPECT_EQ(est.relative_error(), 0.0);
+  EXPECT_EQ(est.samples, options.min_samples);
+}
+
+TEST(SamplingEstimator, ConfidenceInterval) {
+  auto graph = TestGraph();
+  double exact = graph.m / 2;
+  for (auto method : {Sparsification::kColorful, Sparsification::kEdge}) {
+    SamplingOptions options;
+    options.method = method;
+    options.denom = 4;
+    options.min_samples = 32;
+    auto est = EstimateCount(graph, kEdgePattern, CountEdges, options);
+    EXPECT_EQ(est.samples, size_t{32});
+    EXPECT_GT(est.std_error, 0.0);
+    EXPECT_LT(fabs(est.estimate - exact), 5 * est.std_error);
+    EXPECT_LE(est.lower, est.estimate);
+    EXPECT_GE(est.upper, est.estimate);
+  }
+}
+
+TEST(SamplingEstimator, AdaptiveSampling) {
+  auto graph = TestGraph();
+  SamplingOptions options;
+  options.denom = 8;
+  options.max_samples = 512;
+  options.target_relative_error = 0.05;
+  auto est = EstimateCount(graph, kEdgePattern, CountEdges, options);
+  EXPECT_GT(est.samples, options.min_samples);
+  EXPECT_LE(est.relative_error(), 0.05);
+  EXPECT_LT(fabs(est.estimate - graph.m / 2) / (graph.m / 2), 0.1);
+}
+
+}  // namespace sampling
+}  // namespace gbbs